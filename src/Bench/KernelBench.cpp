@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "Dsp/Kernels.h"
+#include "Slicer/Slicer.h"
+#include "KernelBench.h"
+#include "SyntheticAudio.h"
+
+namespace some::bench {
+
+    double timeKernel(const std::function<void()> &kernel, std::size_t samples) {
+        using Clock = std::chrono::steady_clock;
+        kernel();  // warm up caches and page in the buffers
+        double best = std::numeric_limits<double>::max();
+        for (int run = 0; run < 5; ++run) {
+            int iterations = 0;
+            auto start = Clock::now();
+            std::chrono::duration<double, std::nano> elapsed {};
+            do {
+                kernel();
+                ++iterations;
+                elapsed = Clock::now() - start;
+            } while (elapsed.count() < 5e7);
+            best = std::min(best, elapsed.count() / iterations / static_cast<double>(samples));
+        }
+        return best;
+    }
+
+    namespace {
+        struct KernelCase {
+            const char *name;
+            std::size_t samples;
+            // Runs the kernel and appends its output bytes, for the comparison with scalar.
+            std::function<void(const dsp::KernelTable &, std::vector<char> &)> run;
+        };
+
+        template<typename T>
+        void appendBytes(std::vector<char> &bytes, const T *data, std::size_t count) {
+            auto begin = reinterpret_cast<const char *>(data);
+            bytes.insert(bytes.end(), begin, begin + count * sizeof(T));
+        }
+    }
+
+    bool runKernelBenchmarks(QTextStream &out) {
+        constexpr std::size_t kFrames = 1 << 20;
+        SyntheticAudioSpec stereoSpec {"stereo", kFrames / 44100.0 + 1.0, 44100, 2, 0.3, 7};
+        SyntheticAudioSpec surroundSpec {"surround", kFrames / 4 / 44100.0 + 1.0, 44100, 6, 0.3, 8};
+        auto stereo = generateSyntheticAudio(stereoSpec);
+        auto surround = generateSyntheticAudio(surroundSpec);
+        stereo.resize(kFrames * 2);
+        surround.resize(kFrames / 4 * 6);
+        std::vector<float> mono(stereo.begin(), stereo.begin() + kFrames);
+        std::vector<std::int16_t> pcm16(kFrames);
+        std::vector<std::int32_t> pcm32(kFrames);
+        for (std::size_t i = 0; i < kFrames; ++i) {
+            pcm16[i] = static_cast<std::int16_t>(mono[i] * 32767.0f);
+            pcm32[i] = static_cast<std::int32_t>(static_cast<double>(mono[i]) * 2147483647.0);
+        }
+        std::vector<float> floats(kFrames);
+        double sum = 0.0;
+
+        const KernelCase cases[] = {
+                {"downmix 2ch", kFrames, [&](const dsp::KernelTable &k, std::vector<char> &bytes) {
+                    k.downmix(stereo.data(), floats.data(), kFrames, 2);
+                    appendBytes(bytes, floats.data(), kFrames);
+                }},
+                {"downmix 6ch", kFrames / 4, [&](const dsp::KernelTable &k, std::vector<char> &bytes) {
+                    k.downmix(surround.data(), floats.data(), kFrames / 4, 6);
+                    appendBytes(bytes, floats.data(), kFrames / 4);
+                }},
+                {"sum of squares", kFrames, [&](const dsp::KernelTable &k, std::vector<char> &bytes) {
+                    sum = k.sumOfSquares(mono.data(), kFrames);
+                    appendBytes(bytes, &sum, 1);
+                }},
+                {"s16 to float", kFrames, [&](const dsp::KernelTable &k, std::vector<char> &bytes) {
+                    k.s16ToFloat(pcm16.data(), floats.data(), kFrames);
+                    appendBytes(bytes, floats.data(), kFrames);
+                }},
+                {"s32 to float", kFrames, [&](const dsp::KernelTable &k, std::vector<char> &bytes) {
+                    k.s32ToFloat(pcm32.data(), floats.data(), kFrames);
+                    appendBytes(bytes, floats.data(), kFrames);
+                }},
+        };
+
+        auto isas = dsp::supportedIsas();
+        out << QString("%1 %2 %3 %4 %5\n").arg("kernel", -16).arg("isa", -8).arg("ns/sample", 10)
+                .arg("speedup", 8).arg("identical");
+        bool allIdentical = true;
+        for (const auto &kernelCase : cases) {
+            std::vector<char> reference;
+            double scalarTime = 0.0;
+            for (auto isa : isas) {
+                const auto &table = *dsp::kernels(isa);
+                std::vector<char> bytes;
+                kernelCase.run(table, bytes);
+                if (isa == dsp::Isa::Scalar) {
+                    reference = bytes;
+                }
+                bool identical = bytes == reference;
+                allIdentical = allIdentical && identical;
+                std::vector<char> scratch;
+                auto time = timeKernel([&]() {
+                    scratch.clear();
+                    kernelCase.run(table, scratch);
+                }, kernelCase.samples);
+                if (isa == dsp::Isa::Scalar) {
+                    scalarTime = time;
+                }
+                out << QString("%1 %2 %3 %4 %5\n").arg(kernelCase.name, -16).arg(dsp::isaName(isa), -8)
+                        .arg(time, 10, 'f', 3).arg(scalarTime / time, 8, 'f', 2).arg(identical ? "yes" : "NO");
+                out.flush();
+            }
+        }
+
+        // The batch slicer downmixes with the active kernels; its markers must not change.
+        SyntheticAudioSpec sliceSpec {"slice", 600.0, 44100, 2, 0.3, 9};
+        auto sliceAudio = generateSyntheticAudio(sliceSpec);
+        auto activeIsa = dsp::kernels().isa;
+        MarkerList referenceMarkers;
+        for (auto isa : isas) {
+            dsp::setActiveIsa(isa);
+            MarkerList markers;
+            auto time = timeKernel([&]() {
+                markers = Slicer(sliceSpec.sampleRate, -40.0, 5000, 300, 20, 1000).slice(sliceAudio, 2);
+            }, sliceAudio.size() / 2);
+            if (isa == dsp::Isa::Scalar) {
+                referenceMarkers = markers;
+            }
+            bool identical = markers == referenceMarkers;
+            allIdentical = allIdentical && identical;
+            out << QString("%1 %2 %3 %4 %5\n").arg("slicer 2ch", -16).arg(dsp::isaName(isa), -8)
+                    .arg(time, 10, 'f', 3).arg("", 8)
+                    .arg(identical ? QString("yes (%1 markers)").arg(markers.size()) : QString("NO"));
+            out.flush();
+        }
+        dsp::setActiveIsa(activeIsa);
+        out << QString("active kernels: %1\n").arg(dsp::isaName(activeIsa));
+        return allIdentical;
+    }
+
+}  // namespace some::bench
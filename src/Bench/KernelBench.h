@@ -0,0 +1,21 @@
+#ifndef SOME_GUI_KERNELBENCH_H
+#define SOME_GUI_KERNELBENCH_H
+
+#include <cstddef>
+#include <functional>
+
+#include <QTextStream>
+
+namespace some::bench {
+
+    // Best of several runs of `kernel`, each at least ~50 ms, in nanoseconds per sample.
+    double timeKernel(const std::function<void()> &kernel, std::size_t samples);
+
+    // Times every DSP kernel with each instruction set this CPU supports, checks the output is
+    // bit-identical to the scalar kernel, and slices synthetic audio with each to compare the
+    // markers. Returns false if any output differs.
+    bool runKernelBenchmarks(QTextStream &out);
+
+}  // namespace some::bench
+
+#endif //SOME_GUI_KERNELBENCH_H
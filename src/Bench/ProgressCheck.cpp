@@ -0,0 +1,48 @@
+#include <cmath>
+
+#include "Pipeline/ProgressTracker.h"
+#include "ProgressCheck.h"
+
+namespace some::bench {
+
+    namespace {
+        bool near(double a, double b) {
+            return std::abs(a - b) < 1e-9;
+        }
+
+        bool expect(QTextStream &out, const QString &what, double actual, double expected) {
+            bool ok = near(actual, expected);
+            out << QString("%1 %2 %3 %4\n").arg(what, -40).arg(actual, 10, 'f', 4).arg(expected, 10, 'f', 4)
+                    .arg(ok ? "yes" : "NO");
+            out.flush();
+            return ok;
+        }
+    }
+
+    bool checkProgressTracker(QTextStream &out) {
+        // 60 s of audio of which the slicer kept two chunks of 15 s; inference runs at RTF 0.5.
+        ProgressTracker tracker;
+        tracker.beginStage("inference");
+        tracker.setAudioSeconds(60.0);
+        tracker.setChunks(2, 30.0);
+
+        bool ok = true;
+        out << QString("%1 %2 %3 %4\n").arg("report", -40).arg("actual", 10).arg("expected", 10).arg("matches");
+        auto report = tracker.report();
+        ok &= expect(out, "inference fraction before any chunk", report.fraction, 0.05);
+
+        tracker.chunkDone(15.0, 7.5);
+        report = tracker.report();
+        ok &= expect(out, "inference fraction after chunk 1/2", report.fraction, 0.05 + 0.93 * 0.5);
+        ok &= expect(out, "ETA after chunk 1/2", report.etaSeconds, 7.5);
+
+        tracker.chunkDone(15.0, 7.5);
+        report = tracker.report();
+        ok &= expect(out, "inference fraction after chunk 2/2", report.fraction, 0.98);
+        ok &= expect(out, "ETA after chunk 2/2", report.etaSeconds, 0.0);
+        ok &= expect(out, "audio seconds", report.audioSeconds, 60.0);
+        ok &= expect(out, "inference seconds", report.inferenceSeconds, 30.0);
+        return ok;
+    }
+
+}  // namespace some::bench
@@ -0,0 +1,15 @@
+#ifndef SOME_GUI_PROGRESSCHECK_H
+#define SOME_GUI_PROGRESSCHECK_H
+
+#include <QTextStream>
+
+namespace some::bench {
+
+    // Feeds ProgressTracker the chunks of a file the slicer only partly kept and checks that the
+    // inference progress reaches its end and the ETA reaches 0 with the last chunk. Returns false
+    // if any report is off.
+    bool checkProgressTracker(QTextStream &out);
+
+}  // namespace some::bench
+
+#endif //SOME_GUI_PROGRESSCHECK_H
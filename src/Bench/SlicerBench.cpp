@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <QStringList>
+
+#include "Slicer/Slicer.h"
+#include "Slicer/Slicer-inl.h"
+#include "KernelBench.h"
+#include "SlicerBench.h"
+#include "SlicerFixtures.h"
+#include "SyntheticAudio.h"
+
+namespace some::bench {
+
+    namespace {
+        // Integer arithmetic only; the division rounds toward zero like tdiv() in gen_slicer_fixtures.py.
+        int triangle(std::size_t n, int amplitude, int period) {
+            auto x = 2 * static_cast<std::int64_t>(n % period) - period;
+            return static_cast<int>(amplitude * (2 * std::abs(x) - period) / period);
+        }
+
+        // The interleaved samples of a fixture, as gen_slicer_fixtures.py renders them.
+        std::vector<float> renderFixture(const SlicerFixture &fixture) {
+            std::vector<int> mono;
+            // xorshift32, as in SyntheticAudio.cpp.
+            std::uint32_t state = fixture.seed ? fixture.seed : 0x9E3779B9u;
+            for (const auto &segment : fixture.segments) {
+                for (std::size_t n = 0; n < segment.frames; ++n) {
+                    switch (segment.kind) {
+                        case FixtureSegment::Silence:
+                            mono.push_back(0);
+                            break;
+                        case FixtureSegment::Tone:
+                            mono.push_back(triangle(n, segment.startAmplitude, segment.period));
+                            break;
+                        case FixtureSegment::Fade: {
+                            auto delta = static_cast<std::int64_t>(segment.endAmplitude - segment.startAmplitude);
+                            auto amplitude = segment.startAmplitude +
+                                             delta * static_cast<std::int64_t>(n) / static_cast<std::int64_t>(segment.frames);
+                            mono.push_back(triangle(n, static_cast<int>(amplitude), segment.period));
+                            break;
+                        }
+                        case FixtureSegment::Noise:
+                            state ^= state << 13;
+                            state ^= state >> 17;
+                            state ^= state << 5;
+                            mono.push_back(static_cast<int>(state % static_cast<std::uint32_t>(2 * segment.startAmplitude + 1)) -
+                                           segment.startAmplitude);
+                            break;
+                    }
+                }
+            }
+            const auto channels = fixture.channels;
+            std::vector<float> samples(mono.size() * channels);
+            for (std::size_t i = 0; i < mono.size(); ++i) {
+                for (int c = 0; c < channels; ++c) {
+                    samples[i * channels + c] = static_cast<float>(mono[i] * (channels - c) / channels) / 32768.0f;
+                }
+            }
+            return samples;
+        }
+
+        // One thread, and every core if there is more than one.
+        std::vector<int> threadCounts() {
+            auto cores = static_cast<int>(std::thread::hardware_concurrency());
+            return cores > 1 ? std::vector<int> {1, cores} : std::vector<int> {1};
+        }
+
+        QString describeMarkers(const MarkerList &markers) {
+            QStringList parts;
+            for (const auto &[begin, end] : markers) {
+                parts << QString("[%1, %2)").arg(begin).arg(end);
+            }
+            return parts.isEmpty() ? QString("none") : parts.join(' ');
+        }
+
+        bool checkFixtures(QTextStream &out) {
+            bool allMatch = true;
+            out << QString("%1 %2 %3\n").arg("fixture", -40).arg("markers", 8).arg("matches reference");
+            for (const auto &fixture : slicerFixtures()) {
+                auto samples = renderFixture(fixture);
+                QString status = "yes";
+                for (int t : threadCounts()) {
+                    Slicer slicer(fixture.sampleRate, fixture.threshold, fixture.minLength, fixture.minInterval,
+                                  fixture.hopSize, fixture.maxSilKept);
+                    slicer.setThreads(t);
+                    auto markers = slicer.slice(samples, fixture.channels);
+                    if (markers != fixture.expected) {
+                        status = QString("NO with %1 thread(s)\n    expected %2\n    got      %3")
+                                .arg(t).arg(describeMarkers(fixture.expected), describeMarkers(markers));
+                        allMatch = false;
+                        break;
+                    }
+                }
+                out << QString("%1 %2 %3\n").arg(fixture.name, -40).arg(fixture.expected.size(), 8).arg(status);
+                out.flush();
+            }
+            return allMatch;
+        }
+
+        void printTime(QTextStream &out, const QString &kernel, const QString &setting, double nsPerSample) {
+            out << QString("%1 %2 %3 %4\n").arg(kernel, -16).arg(setting, -32)
+                    .arg(nsPerSample, 10, 'f', 3).arg(1e3 / nsPerSample, 12, 'f', 1);
+            out.flush();
+        }
+
+        void benchmarkKernels(QTextStream &out) {
+            constexpr int kSampleRate = 44100;
+            SyntheticAudioSpec spec {"slicer", (1 << 23) / static_cast<double>(kSampleRate) + 1.0, kSampleRate, 1,
+                                     0.3, 11};
+            auto audio = generateSyntheticAudio(spec);
+            audio.resize(1 << 23);
+
+            out << QString("%1 %2 %3 %4\n").arg("kernel", -16).arg("setting", -32).arg("ns/sample", 10)
+                    .arg("Msamples/s", 12);
+
+            // Hop and window as the Slicer derives them at 44.1 kHz: 4 hops, or a window of 47 ms
+            // that is not a multiple of the hop.
+            struct RmsSetting {
+                const char *name;
+                std::size_t hop;
+                std::size_t window;
+            };
+            const RmsSetting rmsSettings[] = {
+                    {"hop 10 ms", 441, 1764},
+                    {"hop 20 ms", 882, 3528},
+                    {"hop 20 ms, window 47 ms", 882, 2073},
+            };
+            for (std::size_t size : {std::size_t(1) << 16, std::size_t(1) << 20, std::size_t(1) << 23}) {
+                std::vector<float> arr(audio.begin(), audio.begin() + static_cast<std::ptrdiff_t>(size));
+                for (const auto &setting : rmsSettings) {
+                    for (int t : threadCounts()) {
+                        auto time = timeKernel([&]() {
+                            get_rms(arr, setting.window, setting.hop, t);
+                        }, size);
+                        printTime(out, "get_rms", QString("%1, %2 samples, %3 thr").arg(setting.name).arg(size).arg(t),
+                                  time);
+                    }
+                }
+            }
+
+            // Stand-in RMS frames for silent runs and argmin: the magnitude of every 8th sample, so
+            // silent and loud runs alternate as in the real frames.
+            std::vector<double> frames(1 << 20);
+            for (std::size_t i = 0; i < frames.size(); ++i) {
+                frames[i] = std::abs(audio[i * 8]);
+            }
+            for (int t : threadCounts()) {
+                auto time = timeKernel([&]() {
+                    silent_runs(frames, 0.01, t);
+                }, frames.size());
+                printTime(out, "silent_runs", QString("%1 frames, %2 thr").arg(frames.size()).arg(t), time);
+            }
+            volatile std::size_t indexSink = 0;
+            for (std::size_t range : {std::size_t(51), std::size_t(101), frames.size()}) {
+                auto time = timeKernel([&]() {
+                    std::size_t sum = 0;
+                    for (std::size_t begin = 0; begin + range <= frames.size(); begin += range) {
+                        sum += argmin_range_view(frames, begin, begin + range);
+                    }
+                    indexSink = sum;
+                }, frames.size() / range * range);
+                printTime(out, "argmin", QString("ranges of %1 frames").arg(range), time);
+            }
+
+            // Downmix: float goes through the DSP kernels, double through the template loop.
+            constexpr std::size_t kDownmixFrames = 1 << 20;
+            for (int channels : {2, 4}) {
+                std::vector<float> interleaved(audio.begin(),
+                                               audio.begin() + static_cast<std::ptrdiff_t>(kDownmixFrames * channels));
+                auto time = timeKernel([&]() {
+                    multichannel_to_mono(interleaved, channels);
+                }, kDownmixFrames);
+                printTime(out, "to mono", QString("float, %1 channels").arg(channels), time);
+            }
+            std::vector<double> interleavedDouble(audio.begin(), audio.begin() + 2 * kDownmixFrames);
+            printTime(out, "to mono", "double, 2 channels", timeKernel([&]() {
+                multichannel_to_mono(interleavedDouble, 2);
+            }, kDownmixFrames));
+
+            // The divisor is read at run time, so the division is not folded into a multiplication.
+            volatile std::int64_t divisor = 1000;
+            volatile std::int64_t sumSink = 0;
+            constexpr std::int64_t kDivisions = 1 << 20;
+            printTime(out, "divIntRound", "int64, +/- numerators", timeKernel([&]() {
+                std::int64_t d = divisor;
+                std::int64_t sum = 0;
+                for (std::int64_t n = -kDivisions / 2; n < kDivisions / 2; ++n) {
+                    sum += divIntRound<std::int64_t>(n * 441, d);
+                }
+                sumSink = sum;
+            }, kDivisions));
+
+            // The whole slice with the pipeline's defaults; long inputs are split between threads.
+            for (std::size_t size : {std::size_t(1) << 20, std::size_t(1) << 23}) {
+                std::vector<float> arr(audio.begin(), audio.begin() + static_cast<std::ptrdiff_t>(size));
+                for (int t : threadCounts()) {
+                    auto time = timeKernel([&]() {
+                        Slicer slicer(kSampleRate, -40.0, 5000, 300, 20, 1000);
+                        slicer.setThreads(t);
+                        slicer.slice(arr, 1);
+                    }, size);
+                    printTime(out, "Slicer::slice", QString("%1 samples, %2 thr").arg(size).arg(t), time);
+                }
+            }
+        }
+    }
+
+    bool checkSlicerFixtures(QTextStream &out) {
+        return checkFixtures(out);
+    }
+
+    bool runSlicerBenchmarks(QTextStream &out) {
+        bool ok = checkFixtures(out);
+        out << "\n";
+        benchmarkKernels(out);
+        return ok;
+    }
+
+}  // namespace some::bench
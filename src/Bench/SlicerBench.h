@@ -0,0 +1,18 @@
+#ifndef SOME_GUI_SLICERBENCH_H
+#define SOME_GUI_SLICERBENCH_H
+
+#include <QTextStream>
+
+namespace some::bench {
+
+    // Slices every golden fixture (SlicerFixtures.h) on one thread and on all of them and compares
+    // the markers with the reference slicer's. Returns false if any markers differ.
+    bool checkSlicerFixtures(QTextStream &out);
+
+    // checkSlicerFixtures(), then times the slicer kernels (RMS, silent runs, argmin, downmix,
+    // rounding division and the whole slice) across sizes and hop settings.
+    bool runSlicerBenchmarks(QTextStream &out);
+
+}  // namespace some::bench
+
+#endif //SOME_GUI_SLICERBENCH_H
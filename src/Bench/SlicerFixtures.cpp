@@ -0,0 +1,218 @@
+// Generated by gen_slicer_fixtures.py from the reference Python slicer; do not edit.
+
+#include "SlicerFixtures.h"
+
+namespace some::bench {
+
+    const std::vector<SlicerFixture> &slicerFixtures() {
+        using S = FixtureSegment;
+        static const std::vector<SlicerFixture> fixtures = {
+                {"shorter than min length", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 132300, 16000, 16000, 100}},
+                 {{0, 132300}}},
+                {"exactly min length", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 66150, 40, 40, 0}, {S::Tone, 154350, 16000, 16000, 100}},
+                 {{0, 220500}}},
+                {"min length plus one frame", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 66150, 40, 40, 0}, {S::Tone, 154351, 16000, 16000, 100}},
+                 {{62622, 220501}}},
+                {"no silence", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 529200, 16000, 16000, 100}},
+                 {{0, 529200}}},
+                {"all silence", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Silence, 529200, 0, 0, 0}},
+                 {}},
+                {"two phrases", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Silence, 35280, 0, 0, 0}, {S::Tone, 264600, 16000, 16000, 150}},
+                 {{0, 266364}, {266364, 564480}}},
+                {"gap below min interval", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Silence, 8820, 0, 0, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{0, 538020}}},
+                {"gaps around min interval", 44100, 1, 10u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 242550, 16000, 16000, 100}, {S::Noise, 14112, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100},
+                  {S::Noise, 14994, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100}, {S::Noise, 15876, 40, 40, 0},
+                  {S::Tone, 242550, 16000, 16000, 100}, {S::Noise, 16758, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100},
+                  {S::Noise, 17640, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100}},
+                 {{0, 770868}, {770868, 1021356}, {1021356, 1287720}, {1287720, 1534680}}},
+                {"gaps around max kept", 44100, 1, 11u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 242550, 16000, 16000, 100}, {S::Noise, 44982, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100},
+                  {S::Noise, 45864, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100}, {S::Noise, 46746, 40, 40, 0},
+                  {S::Tone, 242550, 16000, 16000, 100}, {S::Noise, 47628, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100},
+                  {S::Noise, 48510, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100}, {S::Noise, 89082, 40, 40, 0},
+                  {S::Tone, 242550, 16000, 16000, 100}, {S::Noise, 89964, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100},
+                  {S::Noise, 90846, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100}, {S::Noise, 91728, 40, 40, 0},
+                  {S::Tone, 242550, 16000, 16000, 100}, {S::Noise, 92610, 40, 40, 0}, {S::Tone, 242550, 16000, 16000, 100}},
+                 {{0, 256662}, {256662, 563598}, {563598, 863478}, {863478, 1110438}, {1110438, 1409436},
+                  {1409436, 1726956}, {1764000, 2022426}, {2070054, 2371698}, {2418444, 2699802}, {2769480, 3060540},
+                  {3103758, 3356010}}},
+                {"short clip between gaps", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Silence, 22050, 0, 0, 0}, {S::Tone, 88200, 16000, 16000, 100},
+                  {S::Silence, 22050, 0, 0, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{0, 266364}, {266364, 661500}}},
+                {"long leading silence", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Silence, 352800, 0, 0, 0}, {S::Tone, 308700, 16000, 16000, 100}, {S::Silence, 22050, 0, 0, 0},
+                  {S::Tone, 308700, 16000, 16000, 100}},
+                 {{307818, 663264}, {663264, 992250}}},
+                {"short leading silence", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Silence, 26460, 0, 0, 0}, {S::Tone, 308700, 16000, 16000, 100}},
+                 {{0, 335160}}},
+                {"leading noise of 0.98 s", 44100, 1, 13u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 4410, 80, 80, 0}, {S::Noise, 38808, 20, 20, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{0, 307818}}},
+                {"leading noise of 1.00 s", 44100, 1, 13u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 4410, 80, 80, 0}, {S::Noise, 39690, 20, 20, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{0, 308700}}},
+                {"leading noise of 1.02 s", 44100, 1, 13u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 4410, 80, 80, 0}, {S::Noise, 40572, 20, 20, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{0, 309582}}},
+                {"leading noise of 1.04 s", 44100, 1, 13u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 4410, 80, 80, 0}, {S::Noise, 41454, 20, 20, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{33516, 310464}}},
+                {"leading noise of 1.06 s", 44100, 1, 13u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 4410, 80, 80, 0}, {S::Noise, 42336, 20, 20, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{33516, 311346}}},
+                {"phrase of 3.82 s after leading noise", 44100, 1, 12u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 26460, 40, 40, 0}, {S::Silence, 4410, 0, 0, 0}, {S::Noise, 26460, 40, 40, 0},
+                  {S::Tone, 168462, 16000, 16000, 100}, {S::Noise, 8820, 40, 40, 0}, {S::Silence, 4410, 0, 0, 0},
+                  {S::Noise, 8820, 40, 40, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{28224, 512442}}},
+                {"phrase of 3.84 s after leading noise", 44100, 1, 12u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 26460, 40, 40, 0}, {S::Silence, 4410, 0, 0, 0}, {S::Noise, 26460, 40, 40, 0},
+                  {S::Tone, 169344, 16000, 16000, 100}, {S::Noise, 8820, 40, 40, 0}, {S::Silence, 4410, 0, 0, 0},
+                  {S::Noise, 8820, 40, 40, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{28224, 513324}}},
+                {"phrase of 3.86 s after leading noise", 44100, 1, 12u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 26460, 40, 40, 0}, {S::Silence, 4410, 0, 0, 0}, {S::Noise, 26460, 40, 40, 0},
+                  {S::Tone, 170226, 16000, 16000, 100}, {S::Noise, 8820, 40, 40, 0}, {S::Silence, 4410, 0, 0, 0},
+                  {S::Noise, 8820, 40, 40, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{28224, 238140}, {238140, 514206}}},
+                {"phrase of 3.88 s after leading noise", 44100, 1, 12u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 26460, 40, 40, 0}, {S::Silence, 4410, 0, 0, 0}, {S::Noise, 26460, 40, 40, 0},
+                  {S::Tone, 171108, 16000, 16000, 100}, {S::Noise, 8820, 40, 40, 0}, {S::Silence, 4410, 0, 0, 0},
+                  {S::Noise, 8820, 40, 40, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{28224, 239022}, {239022, 515088}}},
+                {"phrase of 3.90 s after leading noise", 44100, 1, 12u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Noise, 26460, 40, 40, 0}, {S::Silence, 4410, 0, 0, 0}, {S::Noise, 26460, 40, 40, 0},
+                  {S::Tone, 171990, 16000, 16000, 100}, {S::Noise, 8820, 40, 40, 0}, {S::Silence, 4410, 0, 0, 0},
+                  {S::Noise, 8820, 40, 40, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{28224, 239904}, {239904, 515970}}},
+                {"long trailing silence", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 308700, 16000, 16000, 100}, {S::Silence, 441000, 0, 0, 0}},
+                 {{0, 310464}}},
+                {"short trailing silence", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 308700, 16000, 16000, 100}, {S::Silence, 11025, 0, 0, 0}},
+                 {{0, 319725}}},
+                {"trailing noise of 0.28 s", 44100, 1, 14u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Noise, 7938, 20, 20, 0}, {S::Noise, 4410, 80, 80, 0}},
+                 {{0, 276948}}},
+                {"trailing noise of 0.30 s", 44100, 1, 14u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Noise, 8820, 20, 20, 0}, {S::Noise, 4410, 80, 80, 0}},
+                 {{0, 277830}}},
+                {"trailing noise of 0.32 s", 44100, 1, 14u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Noise, 9702, 20, 20, 0}, {S::Noise, 4410, 80, 80, 0}},
+                 {{0, 266364}}},
+                {"trailing noise of 0.34 s", 44100, 1, 14u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Noise, 10584, 20, 20, 0}, {S::Noise, 4410, 80, 80, 0}},
+                 {{0, 266364}}},
+                {"trailing noise of 0.36 s", 44100, 1, 14u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Noise, 11466, 20, 20, 0}, {S::Noise, 4410, 80, 80, 0}},
+                 {{0, 266364}}},
+                {"gap up to twice max kept", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Silence, 66150, 0, 0, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{0, 266364}, {285768, 595350}}},
+                {"gap over twice max kept", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Silence, 176400, 0, 0, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{0, 266364}, {396018, 705600}}},
+                {"fades into noise floor", 44100, 1, 2u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Fade, 44100, 0, 16000, 100}, {S::Tone, 220500, 16000, 16000, 100}, {S::Fade, 66150, 16000, 0, 100},
+                  {S::Noise, 88200, 40, 40, 0}, {S::Fade, 22050, 0, 16000, 120}, {S::Tone, 264600, 16000, 16000, 120},
+                  {S::Fade, 88200, 16000, 0, 120}, {S::Noise, 44100, 40, 40, 0}},
+                 {{0, 359856}, {387198, 801738}}},
+                {"noise floor above threshold", 44100, 1, 3u, -70.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Noise, 44100, 40, 40, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{0, 573300}}},
+                {"noise floor below threshold", 44100, 1, 3u, -50.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Noise, 44100, 40, 40, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{0, 306936}, {306936, 573300}}},
+                {"quiet tone", 44100, 1, 1u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 264600, 800, 800, 100}, {S::Silence, 30870, 0, 0, 0}, {S::Tone, 264600, 200, 200, 100},
+                  {S::Silence, 30870, 0, 0, 0}, {S::Tone, 264600, 800, 800, 100}},
+                 {{0, 266364}, {561834, 855540}}},
+                {"stereo 48 kHz, 10 ms hop", 48000, 2, 4u, -40.0, 5000, 300, 10, 1000,
+                 {{S::Noise, 14400, 40, 40, 0}, {S::Tone, 249600, 16000, 16000, 200}, {S::Silence, 21600, 0, 0, 0},
+                  {S::Tone, 292800, 16000, 16000, 160}, {S::Noise, 120000, 40, 40, 0}, {S::Tone, 254400, 16000, 16000, 240}},
+                 {{0, 264960}, {264960, 587520}, {691680, 952800}}},
+                {"4 channels 22.05 kHz", 22050, 4, 5u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Tone, 132300, 16000, 16000, 50}, {S::Silence, 19845, 0, 0, 0}, {S::Tone, 119070, 16000, 16000, 70},
+                  {S::Silence, 68355, 0, 0, 0}},
+                 {{0, 133182}, {133182, 272097}}},
+                {"8 kHz", 8000, 1, 6u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Silence, 9600, 0, 0, 0}, {S::Tone, 48000, 16000, 16000, 20}, {S::Silence, 4800, 0, 0, 0},
+                  {S::Tone, 48000, 16000, 16000, 30}},
+                 {{1440, 57920}, {57920, 110400}}},
+                {"window not a multiple of hop", 44100, 1, 7u, -40.0, 5000, 47, 20, 1000,
+                 {{S::Tone, 264600, 16000, 16000, 100}, {S::Silence, 5292, 0, 0, 0}, {S::Tone, 264600, 16000, 16000, 100},
+                  {S::Silence, 57330, 0, 0, 0}, {S::Tone, 264600, 16000, 16000, 100}},
+                 {{0, 266364}, {266364, 536256}, {546840, 856422}}},
+                {"many phrases", 44100, 2, 8u, -40.0, 3000, 300, 20, 500,
+                 {{S::Tone, 132300, 16000, 16000, 80}, {S::Noise, 11025, 40, 40, 0}, {S::Tone, 148617, 16000, 16000, 90},
+                  {S::Silence, 28665, 0, 0, 0}, {S::Tone, 164934, 16000, 16000, 100}, {S::Silence, 46305, 0, 0, 0},
+                  {S::Tone, 181251, 16000, 16000, 110}, {S::Noise, 63945, 40, 40, 0}, {S::Tone, 197568, 16000, 16000, 120},
+                  {S::Silence, 11025, 0, 0, 0}, {S::Tone, 132300, 16000, 16000, 130}, {S::Silence, 28665, 0, 0, 0},
+                  {S::Tone, 148617, 16000, 16000, 140}, {S::Noise, 46305, 40, 40, 0}, {S::Tone, 164934, 16000, 16000, 150},
+                  {S::Silence, 63945, 0, 0, 0}, {S::Tone, 181251, 16000, 16000, 160}, {S::Silence, 11025, 0, 0, 0},
+                  {S::Tone, 197568, 16000, 16000, 170}, {S::Noise, 28665, 40, 40, 0}, {S::Tone, 132300, 16000, 16000, 180},
+                  {S::Silence, 46305, 0, 0, 0}, {S::Tone, 148617, 16000, 16000, 190}, {S::Silence, 63945, 0, 0, 0}},
+                 {{0, 293706}, {297234, 487746}, {508914, 735588}, {775278, 1120140}, {1123668, 1305360},
+                  {1335348, 1508220}, {1547028, 1968624}, {1968624, 2122974}, {2144142, 2317896}}},
+                {"long enough for threads", 44100, 1, 9u, -40.0, 5000, 300, 20, 1000,
+                 {{S::Fade, 17640, 0, 16000, 100}, {S::Tone, 176400, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100},
+                  {S::Noise, 8820, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 107}, {S::Tone, 199773, 16000, 16000, 100},
+                  {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 24255, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 114},
+                  {S::Tone, 223146, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 39690, 40, 40, 0},
+                  {S::Fade, 17640, 0, 16000, 121}, {S::Tone, 246519, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100},
+                  {S::Noise, 55125, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 128}, {S::Tone, 269892, 16000, 16000, 100},
+                  {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 70560, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 135},
+                  {S::Tone, 293265, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 85995, 40, 40, 0},
+                  {S::Fade, 17640, 0, 16000, 142}, {S::Tone, 316638, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100},
+                  {S::Noise, 8820, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 149}, {S::Tone, 176400, 16000, 16000, 100},
+                  {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 24255, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 156},
+                  {S::Tone, 199773, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 39690, 40, 40, 0},
+                  {S::Fade, 17640, 0, 16000, 163}, {S::Tone, 223146, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100},
+                  {S::Noise, 55125, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 170}, {S::Tone, 246519, 16000, 16000, 100},
+                  {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 70560, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 177},
+                  {S::Tone, 269892, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 85995, 40, 40, 0},
+                  {S::Fade, 17640, 0, 16000, 184}, {S::Tone, 293265, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100},
+                  {S::Noise, 8820, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 191}, {S::Tone, 316638, 16000, 16000, 100},
+                  {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 24255, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 198},
+                  {S::Tone, 176400, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 39690, 40, 40, 0},
+                  {S::Fade, 17640, 0, 16000, 205}, {S::Tone, 199773, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100},
+                  {S::Noise, 55125, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 212}, {S::Tone, 223146, 16000, 16000, 100},
+                  {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 70560, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 219},
+                  {S::Tone, 246519, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 85995, 40, 40, 0},
+                  {S::Fade, 17640, 0, 16000, 226}, {S::Tone, 269892, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100},
+                  {S::Noise, 8820, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 233}, {S::Tone, 293265, 16000, 16000, 100},
+                  {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 24255, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 240},
+                  {S::Tone, 316638, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 39690, 40, 40, 0},
+                  {S::Fade, 17640, 0, 16000, 247}, {S::Tone, 176400, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100},
+                  {S::Noise, 55125, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 254}, {S::Tone, 199773, 16000, 16000, 100},
+                  {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 70560, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 261},
+                  {S::Tone, 223146, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 85995, 40, 40, 0},
+                  {S::Fade, 17640, 0, 16000, 268}, {S::Tone, 246519, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100},
+                  {S::Noise, 8820, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 275}, {S::Tone, 269892, 16000, 16000, 100},
+                  {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 24255, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 282},
+                  {S::Tone, 293265, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 39690, 40, 40, 0},
+                  {S::Fade, 17640, 0, 16000, 289}, {S::Tone, 316638, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100},
+                  {S::Noise, 55125, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 296}, {S::Tone, 176400, 16000, 16000, 100},
+                  {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 70560, 40, 40, 0}, {S::Fade, 17640, 0, 16000, 303},
+                  {S::Tone, 199773, 16000, 16000, 100}, {S::Fade, 26460, 16000, 0, 100}, {S::Noise, 85995, 40, 40, 0}},
+                 {{0, 483336}, {483336, 789390}, {789390, 1121904}, {1121904, 1479114}, {1520568, 1897182},
+                  {1939518, 2564856}, {2564856, 2852388}, {2852388, 3129336}, {3144330, 3505068}, {3505068, 3856986},
+                  {3901968, 4655196}, {4655196, 4917150}, {4917150, 5204682}, {5204682, 5522202}, {5561010, 5867946},
+                  {5901462, 6606180}, {6606180, 7012782}, {7012782, 7283556}, {7283556, 7574616}, {7616070, 7914186},
+                  {7967106, 8608320}, {8608320, 8962884}, {8962884, 9373014}, {9373014, 9664074}, {9664074, 9981594}}},
+        };
+        return fixtures;
+    }
+
+}  // namespace some::bench
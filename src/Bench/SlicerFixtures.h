@@ -0,0 +1,47 @@
+#ifndef SOME_GUI_SLICERFIXTURES_H
+#define SOME_GUI_SLICERFIXTURES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Slicer/Slicer.h"
+
+namespace some::bench {
+
+    // A stretch of a fixture signal, in integer sample units of 1/32768.
+    struct FixtureSegment {
+        enum Kind {
+            Silence,
+            Tone,   // triangle wave of `period` samples and `startAmplitude`
+            Fade,   // triangle wave whose amplitude goes linearly from `startAmplitude` to `endAmplitude`
+            Noise,  // uniform noise in [-startAmplitude, startAmplitude]
+        };
+        Kind kind;
+        std::size_t frames;
+        int startAmplitude;
+        int endAmplitude;
+        int period;
+    };
+
+    // An input of the slicer and the markers the reference Python slicer finds in it.
+    struct SlicerFixture {
+        const char *name;
+        int sampleRate;
+        int channels;  // 1, 2 or 4; channel c is scaled by (channels - c) / channels
+        std::uint32_t seed;  // of the noise
+        double threshold;
+        std::size_t minLength;
+        std::size_t minInterval;
+        std::size_t hopSize;
+        std::size_t maxSilKept;
+        std::vector<FixtureSegment> segments;
+        MarkerList expected;
+    };
+
+    // Written by gen_slicer_fixtures.py; regenerate SlicerFixtures.cpp after changing the cases there.
+    const std::vector<SlicerFixture> &slicerFixtures();
+
+}  // namespace some::bench
+
+#endif //SOME_GUI_SLICERFIXTURES_H
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+
+#include <sndfile.hh>
+
+#include "SyntheticAudio.h"
+
+namespace some::bench {
+
+    namespace {
+        // xorshift32; std distributions are not guaranteed to be identical across standard libraries.
+        class Random {
+        public:
+            explicit Random(std::uint32_t seed) : m_state(seed ? seed : 0x9E3779B9u) {}
+
+            std::uint32_t next() {
+                m_state ^= m_state << 13;
+                m_state ^= m_state >> 17;
+                m_state ^= m_state << 5;
+                return m_state;
+            }
+
+            double uniform(double lo, double hi) {
+                return lo + (hi - lo) * (next() / 4294967296.0);
+            }
+
+            int uniformInt(int lo, int hi) {
+                return lo + static_cast<int>(next() % static_cast<std::uint32_t>(hi - lo + 1));
+            }
+
+        private:
+            std::uint32_t m_state;
+        };
+
+        constexpr double kPi = 3.14159265358979323846;
+    }
+
+    std::vector<float> generateSyntheticAudio(const SyntheticAudioSpec &spec) {
+        const auto sampleRate = spec.sampleRate;
+        const auto channels = std::max(1, spec.channels);
+        const auto totalFrames = static_cast<std::size_t>(spec.durationSec * sampleRate);
+        const auto silenceRatio = std::clamp(spec.silenceRatio, 0.0, 0.95);
+
+        std::vector<float> mono(totalFrames, 0.0f);
+        Random random(spec.seed);
+
+        std::size_t pos = static_cast<std::size_t>(random.uniform(0.2, 1.0) * sampleRate);
+        int pitch = 62;
+        while (pos < totalFrames) {
+            // One phrase: consecutive notes following a random walk in a singable range.
+            auto phraseEnd = std::min(totalFrames, pos + static_cast<std::size_t>(random.uniform(1.5, 6.0) * sampleRate));
+            auto phraseStart = pos;
+            while (pos < phraseEnd) {
+                auto noteLength = std::min(phraseEnd - pos,
+                                           static_cast<std::size_t>(random.uniform(0.15, 0.6) * sampleRate));
+                pitch = std::clamp(pitch + random.uniformInt(-3, 3), 52, 79);
+                auto frequency = 440.0 * std::pow(2.0, (pitch - 69) / 12.0);
+                auto attack = std::min<std::size_t>(noteLength / 4, sampleRate / 100);
+                for (std::size_t i = 0; i < noteLength; ++i) {
+                    double envelope = 1.0;
+                    if (i < attack) {
+                        envelope = static_cast<double>(i) / attack;
+                    }
+                    else if (i + attack > noteLength) {
+                        envelope = static_cast<double>(noteLength - i) / attack;
+                    }
+                    auto phase = 2.0 * kPi * frequency * static_cast<double>(i) / sampleRate;
+                    auto value = 0.6 * std::sin(phase) + 0.25 * std::sin(2.0 * phase) + 0.1 * std::sin(3.0 * phase);
+                    mono[pos + i] = static_cast<float>(0.3 * envelope * value);
+                }
+                pos += noteLength;
+            }
+            // Silence sized so that the file ends up with roughly the requested silence ratio.
+            auto phraseLength = static_cast<double>(pos - phraseStart);
+            auto gap = phraseLength * silenceRatio / (1.0 - silenceRatio) * random.uniform(0.5, 1.5);
+            pos += std::max<std::size_t>(static_cast<std::size_t>(gap), sampleRate / 2);
+        }
+
+        if (channels == 1) {
+            return mono;
+        }
+        std::vector<float> interleaved(totalFrames * channels);
+        for (std::size_t i = 0; i < totalFrames; ++i) {
+            for (int c = 0; c < channels; ++c) {
+                // Slightly different gain per channel so the downmix is not a no-op.
+                interleaved[i * channels + c] = mono[i] * static_cast<float>(1.0 - 0.08 * c);
+            }
+        }
+        return interleaved;
+    }
+
+    bool writeWavFile(const QString &path, const std::vector<float> &samples, int sampleRate, int channels) {
+        SndfileHandle sf(path
+#ifdef _WIN32
+                .toStdWString().c_str()
+#else
+                .toStdString()
+#endif
+                , SFM_WRITE, SF_FORMAT_WAV | SF_FORMAT_FLOAT, channels, sampleRate);
+        if (sf.error() != SF_ERR_NO_ERROR) {
+            return false;
+        }
+        auto count = static_cast<sf_count_t>(samples.size());
+        return sf.write(samples.data(), count) == count;
+    }
+
+    std::vector<SyntheticAudioSpec> defaultScenarios() {
+        return {
+                {"short-mono-44k",     10.0,  44100, 1, 0.3, 1},
+                {"stereo-48k",         60.0,  48000, 2, 0.3, 2},
+                {"silence-heavy-44k",  120.0, 44100, 2, 0.7, 3},
+                {"surround-48k",       30.0,  48000, 6, 0.3, 4},
+                {"long-mono-22k",      300.0, 22050, 1, 0.4, 5},
+                {"long-stereo-96k",    600.0, 96000, 2, 0.3, 6},
+        };
+    }
+
+}  // namespace some::bench
@@ -0,0 +1,33 @@
+#ifndef SOME_GUI_SYNTHETICAUDIO_H
+#define SOME_GUI_SYNTHETICAUDIO_H
+
+#include <cstdint>
+#include <vector>
+
+#include <QString>
+
+namespace some::bench {
+
+    struct SyntheticAudioSpec {
+        QString name;
+        double durationSec = 10.0;
+        int sampleRate = 44100;
+        int channels = 1;
+        // Approximate fraction of the file that is silence between phrases.
+        double silenceRatio = 0.3;
+        std::uint32_t seed = 1;
+    };
+
+    // Phrases of harmonic tones at semitone pitches separated by silences of varying length.
+    // The generator uses its own PRNG, so the output is identical on every platform.
+    // Returns interleaved samples.
+    std::vector<float> generateSyntheticAudio(const SyntheticAudioSpec &spec);
+
+    bool writeWavFile(const QString &path, const std::vector<float> &samples, int sampleRate, int channels);
+
+    // A fixed set of scenarios covering lengths, sample rates and channel layouts.
+    std::vector<SyntheticAudioSpec> defaultScenarios();
+
+}  // namespace some::bench
+
+#endif //SOME_GUI_SYNTHETICAUDIO_H
@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+"""Writes SlicerFixtures.cpp: golden slicer markers for some-bench --slicer.
+
+The markers come from the reference slicer (slicer2.py of openvpi/audio-slicer), ported below
+line by line with plain Python in place of numpy, so the script runs without dependencies.
+Samples are multiples of 1/32768 and the channel counts powers of two, which makes every
+frame's sum of squares exact in double precision, both here and in the C++ slicer; the RMS
+values, and so the markers, therefore don't depend on the order of the additions.
+
+Usage: python3 gen_slicer_fixtures.py > SlicerFixtures.cpp
+"""
+
+import math
+
+# Slicer defaults of the pipeline (PreprocessOptions).
+DEFAULTS = dict(threshold=-40.0, min_length=5000, min_interval=300, hop_size=20, max_sil_kept=1000)
+
+
+def tdiv(a, b):
+    # Integer division rounding toward zero, as in C++.
+    q = abs(a) // abs(b)
+    return q if (a < 0) == (b < 0) else -q
+
+
+class Random:
+    # xorshift32, the same generator as SyntheticAudio.cpp.
+    def __init__(self, seed):
+        self.state = seed if seed else 0x9E3779B9
+
+    def next(self):
+        s = self.state
+        s ^= (s << 13) & 0xFFFFFFFF
+        s ^= s >> 17
+        s ^= (s << 5) & 0xFFFFFFFF
+        self.state = s
+        return s
+
+
+def triangle(n, amplitude, period):
+    x = 2 * (n % period) - period
+    return tdiv(amplitude * (2 * abs(x) - period), period)
+
+
+def render(fixture):
+    """Integer samples of each channel, in units of 1/32768."""
+    random = Random(fixture['seed'])
+    mono = []
+    for kind, frames, *args in fixture['segments']:
+        if kind == 'silence':
+            mono.extend([0] * frames)
+        elif kind == 'tone':
+            amplitude, period = args
+            mono.extend(triangle(n, amplitude, period) for n in range(frames))
+        elif kind == 'fade':
+            start, end, period = args
+            mono.extend(triangle(n, start + tdiv((end - start) * n, frames), period) for n in range(frames))
+        elif kind == 'noise':
+            amplitude, = args
+            mono.extend(random.next() % (2 * amplitude + 1) - amplitude for _ in range(frames))
+        else:
+            raise ValueError(kind)
+    channels = fixture['channels']
+    return [[tdiv(k * (channels - c), channels) for k in mono] for c in range(channels)]
+
+
+def get_rms(y, scale, frame_length, hop_length):
+    # slicer2.get_rms: zero-pad by frame_length // 2, frame every hop_length samples, RMS per frame.
+    # `y` holds integers; the real samples are y / scale.
+    padding = frame_length // 2
+    prefix = [0]
+    for v in [0] * padding + y + [0] * padding:
+        prefix.append(prefix[-1] + v * v)
+    count = (len(prefix) - 1 - frame_length) // hop_length + 1
+    rms = []
+    for k in range(count):
+        total = prefix[k * hop_length + frame_length] - prefix[k * hop_length]
+        rms.append(math.sqrt(max(0.0, total / (scale * scale) / frame_length)))
+    return rms
+
+
+def argmin(values, begin, end):
+    end = min(end, len(values))
+    best = begin
+    for i in range(begin + 1, end):
+        if values[i] < values[best]:
+            best = i
+    return best - begin
+
+
+def reference_slice(channels_samples, sr, threshold, min_length, min_interval, hop_size, max_sil_kept):
+    # slicer2.Slicer.__init__
+    min_interval = sr * min_interval / 1000
+    threshold = 10 ** (threshold / 20.)
+    hop_size = round(sr * hop_size / 1000)
+    win_size = min(round(min_interval), 4 * hop_size)
+    min_length = round(sr * min_length / 1000 / hop_size)
+    min_interval = round(min_interval / hop_size)
+    max_sil_kept = round(sr * max_sil_kept / 1000 / hop_size)
+
+    # slicer2.Slicer.slice, returning sample ranges instead of the audio in them.
+    channels = len(channels_samples)
+    samples = [sum(frame) for frame in zip(*channels_samples)]
+    frames = len(samples)
+    if (frames + hop_size - 1) // hop_size <= min_length:
+        return [(0, frames)]
+    rms_list = get_rms(samples, 32768 * channels, win_size, hop_size)
+    sil_tags = []
+    silence_start = None
+    clip_start = 0
+    for i, rms in enumerate(rms_list):
+        if rms < threshold:
+            if silence_start is None:
+                silence_start = i
+            continue
+        if silence_start is None:
+            continue
+        is_leading_silence = silence_start == 0 and i > max_sil_kept
+        need_slice_middle = i - silence_start >= min_interval and i - clip_start >= min_length
+        if not is_leading_silence and not need_slice_middle:
+            silence_start = None
+            continue
+        if i - silence_start <= max_sil_kept:
+            pos = argmin(rms_list, silence_start, i + 1) + silence_start
+            if silence_start == 0:
+                sil_tags.append((0, pos))
+            else:
+                sil_tags.append((pos, pos))
+            clip_start = pos
+        elif i - silence_start <= max_sil_kept * 2:
+            pos = argmin(rms_list, i - max_sil_kept, silence_start + max_sil_kept + 1)
+            pos += i - max_sil_kept
+            pos_l = argmin(rms_list, silence_start, silence_start + max_sil_kept + 1) + silence_start
+            pos_r = argmin(rms_list, i - max_sil_kept, i + 1) + i - max_sil_kept
+            if silence_start == 0:
+                sil_tags.append((0, pos_r))
+                clip_start = pos_r
+            else:
+                sil_tags.append((min(pos_l, pos), max(pos_r, pos)))
+                clip_start = max(pos_r, pos)
+        else:
+            pos_l = argmin(rms_list, silence_start, silence_start + max_sil_kept + 1) + silence_start
+            pos_r = argmin(rms_list, i - max_sil_kept, i + 1) + i - max_sil_kept
+            if silence_start == 0:
+                sil_tags.append((0, pos_r))
+            else:
+                sil_tags.append((pos_l, pos_r))
+            clip_start = pos_r
+        silence_start = None
+    total_frames = len(rms_list)
+    if silence_start is not None and total_frames - silence_start >= min_interval:
+        silence_end = min(total_frames, silence_start + max_sil_kept)
+        pos = argmin(rms_list, silence_start, silence_end + 1) + silence_start
+        sil_tags.append((pos, total_frames + 1))
+    if len(sil_tags) == 0:
+        return [(0, frames)]
+    chunks = []
+    if sil_tags[0][0] > 0:
+        chunks.append((0, sil_tags[0][0]))
+    for i in range(len(sil_tags) - 1):
+        chunks.append((sil_tags[i][1], sil_tags[i + 1][0]))
+    if sil_tags[-1][1] < total_frames:
+        chunks.append((sil_tags[-1][1], total_frames))
+    # _apply_slice: waveform[begin * hop_size: min(len, end * hop_size)]
+    return [(begin * hop_size, min(frames, end * hop_size)) for begin, end in chunks]
+
+
+def s(sr, seconds):
+    return round(sr * seconds)
+
+
+def fixtures():
+    # (name, sample rate, channels, seed, slicer parameters, segments); segment lengths in seconds.
+    # A tone is a triangle wave: ('tone', seconds, amplitude, period in samples).
+    loud, quiet = 16000, 40  # about -6 and -58 dBFS
+    cases = [
+        ('shorter than min length', 44100, 1, 1, {}, [('tone', 3.0, loud, 100)]),
+        ('exactly min length', 44100, 1, 1, {}, [('noise', 1.5, quiet), ('tone', 3.5, loud, 100)]),
+        ('min length plus one frame', 44100, 1, 1, {},
+         [('noise', 1.5, quiet), ('tone', 3.5 + 1 / 44100, loud, 100)]),
+        ('no silence', 44100, 1, 1, {}, [('tone', 12.0, loud, 100)]),
+        ('all silence', 44100, 1, 1, {}, [('silence', 12.0)]),
+        ('two phrases', 44100, 1, 1, {}, [('tone', 6.0, loud, 100), ('silence', 0.8), ('tone', 6.0, loud, 150)]),
+        ('gap below min interval', 44100, 1, 1, {},
+         [('tone', 6.0, loud, 100), ('silence', 0.2), ('tone', 6.0, loud, 100)]),
+        # The window spans 4 hops, so a gap has about 3 silent frames fewer than it has hops. The gaps
+        # and phrases below step by one hop across the limits of the slicer. Their silence is noise,
+        # so the quietest frame in a gap is not simply its first one, or one with a dip of digital
+        # silence where a fixed quietest frame is needed.
+        ('gaps around min interval', 44100, 1, 10, {},
+         [('tone', 5.5, loud, 100)] +
+         [seg for gap in (0.32, 0.34, 0.36, 0.38, 0.40) for seg in (('noise', gap, quiet), ('tone', 5.5, loud, 100))]),
+        ('gaps around max kept', 44100, 1, 11, {},
+         [('tone', 5.5, loud, 100)] +
+         [seg for gap in (1.02, 1.04, 1.06, 1.08, 1.10, 2.02, 2.04, 2.06, 2.08, 2.10)
+          for seg in (('noise', gap, quiet), ('tone', 5.5, loud, 100))]),
+        ('short clip between gaps', 44100, 1, 1, {},
+         [('tone', 6.0, loud, 100), ('silence', 0.5), ('tone', 2.0, loud, 100), ('silence', 0.5),
+          ('tone', 6.0, loud, 100)]),
+        ('long leading silence', 44100, 1, 1, {},
+         [('silence', 8.0), ('tone', 7.0, loud, 100), ('silence', 0.5), ('tone', 7.0, loud, 100)]),
+        ('short leading silence', 44100, 1, 1, {}, [('silence', 0.6), ('tone', 7.0, loud, 100)]),
+    ] + [
+        # Louder noise at the edge, so the quietest frame is not the half-padded one there.
+        ('leading noise of %.2f s' % lead, 44100, 1, 13, {},
+         [('noise', 0.1, 2 * quiet), ('noise', lead - 0.1, quiet // 2), ('tone', 6.0, loud, 100)])
+        for lead in (0.98, 1.00, 1.02, 1.04, 1.06)
+    ] + [
+        # The leading noise is cut at its dip, and the phrase after it is about min length from there.
+        ('phrase of %.2f s after leading noise' % length, 44100, 1, 12, {},
+         [('noise', 0.6, quiet), ('silence', 0.1), ('noise', 0.6, quiet), ('tone', length, loud, 100),
+          ('noise', 0.2, quiet), ('silence', 0.1), ('noise', 0.2, quiet), ('tone', 6.0, loud, 100)])
+        for length in (3.82, 3.84, 3.86, 3.88, 3.90)
+    ] + [
+        ('long trailing silence', 44100, 1, 1, {}, [('tone', 7.0, loud, 100), ('silence', 10.0)]),
+        ('short trailing silence', 44100, 1, 1, {}, [('tone', 7.0, loud, 100), ('silence', 0.25)]),
+    ] + [
+        ('trailing noise of %.2f s' % tail, 44100, 1, 14, {},
+         [('tone', 6.0, loud, 100), ('noise', tail - 0.1, quiet // 2), ('noise', 0.1, 2 * quiet)])
+        for tail in (0.28, 0.30, 0.32, 0.34, 0.36)
+    ] + [
+        ('gap up to twice max kept', 44100, 1, 1, {},
+         [('tone', 6.0, loud, 100), ('silence', 1.5), ('tone', 6.0, loud, 100)]),
+        ('gap over twice max kept', 44100, 1, 1, {},
+         [('tone', 6.0, loud, 100), ('silence', 4.0), ('tone', 6.0, loud, 100)]),
+        ('fades into noise floor', 44100, 1, 2, {},
+         [('fade', 1.0, 0, loud, 100), ('tone', 5.0, loud, 100), ('fade', 1.5, loud, 0, 100),
+          ('noise', 2.0, quiet), ('fade', 0.5, 0, loud, 120), ('tone', 6.0, loud, 120),
+          ('fade', 2.0, loud, 0, 120), ('noise', 1.0, quiet)]),
+        ('noise floor above threshold', 44100, 1, 3, {'threshold': -70.0},
+         [('tone', 6.0, loud, 100), ('noise', 1.0, quiet), ('tone', 6.0, loud, 100)]),
+        ('noise floor below threshold', 44100, 1, 3, {'threshold': -50.0},
+         [('tone', 6.0, loud, 100), ('noise', 1.0, quiet), ('tone', 6.0, loud, 100)]),
+        ('quiet tone', 44100, 1, 1, {},
+         [('tone', 6.0, 800, 100), ('silence', 0.7), ('tone', 6.0, 200, 100), ('silence', 0.7),
+          ('tone', 6.0, 800, 100)]),
+        ('stereo 48 kHz, 10 ms hop', 48000, 2, 4, {'hop_size': 10},
+         [('noise', 0.3, quiet), ('tone', 5.2, loud, 200), ('silence', 0.45), ('tone', 6.1, loud, 160),
+          ('noise', 2.5, quiet), ('tone', 5.3, loud, 240)]),
+        ('4 channels 22.05 kHz', 22050, 4, 5, {},
+         [('tone', 6.0, loud, 50), ('silence', 0.9), ('tone', 5.4, loud, 70), ('silence', 3.1)]),
+        ('8 kHz', 8000, 1, 6, {},
+         [('silence', 1.2), ('tone', 6.0, loud, 20), ('silence', 0.6), ('tone', 6.0, loud, 30)]),
+        ('window not a multiple of hop', 44100, 1, 7, {'min_interval': 47},
+         [('tone', 6.0, loud, 100), ('silence', 0.12), ('tone', 6.0, loud, 100), ('silence', 1.3),
+          ('tone', 6.0, loud, 100)]),
+        ('many phrases', 44100, 2, 8, {'max_sil_kept': 500, 'min_length': 3000},
+         [seg for i in range(12) for seg in (('tone', 3.0 + 0.37 * (i % 5), loud, 80 + 10 * i),
+                                              ('silence' if i % 3 else 'noise', 0.25 + 0.4 * (i % 4), quiet))]),
+        # Over 2 * 2^22 samples, so Slicer::slice splits it between threads.
+        ('long enough for threads', 44100, 1, 9, {},
+         [seg for i in range(30) for seg in (('fade', 0.4, 0, loud, 100 + 7 * i),
+                                              ('tone', 4.0 + 0.53 * (i % 7), loud, 100),
+                                              ('fade', 0.6, loud, 0, 100),
+                                              ('noise', 0.2 + 0.35 * (i % 6), quiet))]),
+    ]
+    for name, sr, channels, seed, params, segments in cases:
+        yield dict(name=name, sample_rate=sr, channels=channels, seed=seed, params={**DEFAULTS, **params},
+                   segments=[(kind, s(sr, seconds), *args) for kind, seconds, *args in segments])
+
+
+def main():
+    kinds = {'silence': 'Silence', 'tone': 'Tone', 'fade': 'Fade', 'noise': 'Noise'}
+    print('// Generated by gen_slicer_fixtures.py from the reference Python slicer; do not edit.\n')
+    print('#include "SlicerFixtures.h"\n')
+    print('namespace some::bench {\n')
+    print('    const std::vector<SlicerFixture> &slicerFixtures() {')
+    print('        using S = FixtureSegment;')
+    print('        static const std::vector<SlicerFixture> fixtures = {')
+    for fixture in fixtures():
+        p = fixture['params']
+        markers = reference_slice(render(fixture), fixture['sample_rate'], **p)
+        print('                {"%s", %d, %d, %du, %.1f, %d, %d, %d, %d,' % (
+            fixture['name'], fixture['sample_rate'], fixture['channels'], fixture['seed'], p['threshold'],
+            p['min_length'], p['min_interval'], p['hop_size'], p['max_sil_kept']))
+        segments = []
+        for kind, frames, *args in fixture['segments']:
+            # {kind, frames, start amplitude, end amplitude, period}
+            if kind == 'silence':
+                args = [0, 0, 0]
+            elif kind == 'tone':
+                args = [args[0], args[0], args[1]]
+            elif kind == 'noise':
+                args = [args[0], args[0], 0]
+            segments.append('{S::%s, %d, %d, %d, %d}' % (kinds[kind], frames, *args))
+        lines = [', '.join(segments[i:i + 3]) for i in range(0, len(segments), 3)]
+        print('                 {%s},' % ',\n                  '.join(lines))
+        markers = ['{%d, %d}' % marker for marker in markers]
+        lines = [', '.join(markers[i:i + 5]) for i in range(0, len(markers), 5)]
+        print('                 {%s}},' % ',\n                  '.join(lines))
+    print('        };')
+    print('        return fixtures;')
+    print('    }\n')
+    print('}  // namespace some::bench')
+
+
+if __name__ == '__main__':
+    main()
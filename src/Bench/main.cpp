@@ -0,0 +1,388 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <memory>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#ifdef ORT_API_MANUAL_INIT
+#include "OrtLoader.h"
+#endif
+#include "Inference/MockInference.h"
+#include "Inference/SOMEInference.h"
+#include "Pipeline/Pipeline.h"
+#include "Pipeline/PreprocessCache.h"
+#include "Utils/ProcessMemory.h"
+#include "KernelBench.h"
+#include "ProgressCheck.h"
+#include "SlicerBench.h"
+#include "SyntheticAudio.h"
+
+using namespace some;
+
+namespace {
+    // Stages reported as columns, in pipeline order.
+    const char *const kStages[] = { "cache", "decode", "downmix", "resample", "slice", "inference", "midi" };
+
+    std::uint64_t hashNotes(const std::vector<NotesPtr> &chunkNotes) {
+        // FNV-1a over quantized note values, so the hash survives float formatting differences.
+        std::uint64_t hash = 14695981039346656037ull;
+        auto feed = [&hash](std::int64_t value) {
+            for (int i = 0; i < 8; ++i) {
+                hash ^= static_cast<std::uint8_t>(value >> (i * 8));
+                hash *= 1099511628211ull;
+            }
+        };
+        for (const auto &notes : chunkNotes) {
+            for (std::size_t i = 0; i < notes->note_midi.size(); ++i) {
+                feed(std::lround(notes->note_midi[i] * 100.0f));
+                feed(notes->note_rest[i]);
+                feed(std::lround(notes->note_dur[i] * 1000.0f));
+            }
+        }
+        return hash;
+    }
+
+    struct BenchResult {
+        QString backend;
+        QString scenario;
+        int run = 0;
+        PipelineStats stats;
+        std::uint64_t notesHash = 0;
+        std::size_t peakRss = 0;
+    };
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("some-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+            "End-to-end throughput benchmark of the SOME pipeline on synthetic audio.\n"
+            "Without --model, a deterministic mock backend stands in for the ONNX model.");
+    parser.addHelpOption();
+    QCommandLineOption costOption({"c", "cost"},
+                                  "Mock inference cost in seconds of compute per second of audio.",
+                                  "factor", "0.05");
+    QCommandLineOption sleepOption("sleep", "Mock backend sleeps instead of spinning a core.");
+    QCommandLineOption modelOption({"m", "model"}, "Benchmark a real ONNX model instead of the mock backend.",
+                                   "path");
+    QCommandLineOption loadModeOption("load-mode", "Model loading with --model: mmap or path.", "mode", "mmap");
+    QCommandLineOption epOption("ep", "With --model, execution providers to compare, separated by ',' (cpu, cuda, "
+                                      "dml, xnnpack, dnnl, openvino), or 'all' for every available one.",
+                                "names", "cpu");
+    QCommandLineOption bucketsOption("length-buckets",
+                                     "With --model, pad chunks to lengths growing by this factor (e.g. 1.25).",
+                                     "factor");
+    QCommandLineOption scenarioOption({"s", "scenario"}, "Only run scenarios whose name contains this text.",
+                                      "name");
+    QCommandLineOption repeatOption({"r", "repeat"}, "Runs per scenario.", "count", "1");
+    QCommandLineOption csvOption("csv", "Also write the results as CSV to this file.", "path");
+    QCommandLineOption keepOption("keep", "Write generated audio and MIDI to this directory and keep them.", "dir");
+    QCommandLineOption budgetOption("memory-budget", "Memory budget in MB (0 = unlimited).", "MB");
+    QCommandLineOption cacheDirOption("cache-dir", "Use a preprocess cache in this directory.", "dir");
+    QCommandLineOption cacheSizeOption("cache-max-mb", "Size cap of the preprocess cache in MB.", "MB", "1024");
+    QCommandLineOption verboseOption({"v", "verbose"}, "Print pipeline log messages.");
+    QCommandLineOption kernelsOption("kernels", "Only run the DSP kernel microbenchmarks.");
+    QCommandLineOption slicerOption("slicer", "Only check the slicer against its golden markers and run its "
+                                              "microbenchmarks.");
+    QCommandLineOption slicerCheckOption("slicer-check", "Only check the slicer against its golden markers.");
+    QCommandLineOption progressCheckOption("progress-check", "Only check the progress and ETA reports.");
+    parser.addOptions({costOption, sleepOption, modelOption, loadModeOption, epOption, bucketsOption, scenarioOption,
+                       repeatOption,
+                       csvOption, keepOption, budgetOption, cacheDirOption, cacheSizeOption, verboseOption,
+                       kernelsOption, slicerOption, slicerCheckOption, progressCheckOption});
+    parser.process(app);
+
+    if (parser.isSet(kernelsOption)) {
+        QTextStream out(stdout);
+        return bench::runKernelBenchmarks(out) ? 0 : 1;
+    }
+    if (parser.isSet(progressCheckOption)) {
+        QTextStream out(stdout);
+        return bench::checkProgressTracker(out) ? 0 : 1;
+    }
+    if (parser.isSet(slicerCheckOption)) {
+        QTextStream out(stdout);
+        return bench::checkSlicerFixtures(out) ? 0 : 1;
+    }
+    if (parser.isSet(slicerOption)) {
+        QTextStream out(stdout);
+        return bench::runSlicerBenchmarks(out) ? 0 : 1;
+    }
+
+    if (parser.isSet(budgetOption)) {
+        MemoryBudget::global().setCapacity(parser.value(budgetOption).toULongLong() * 1024 * 1024);
+    }
+
+    const bool verbose = parser.isSet(verboseOption);
+    const int repeat = std::max(1, parser.value(repeatOption).toInt());
+
+    // Backends: the mock, or the model once per execution provider.
+    struct BackendRun {
+        QString name;
+        std::unique_ptr<InferenceBackend> backend;
+        SOMEInference *someInference = nullptr;
+    };
+    std::vector<BackendRun> backends;
+    if (parser.isSet(modelOption)) {
+#ifdef ORT_API_MANUAL_INIT
+        QString errorString;
+        if (!InitOrtLibrary(&errorString)) {
+            std::fprintf(stderr, "Could not load ONNX Runtime library: %s\n", qPrintable(errorString));
+            return 1;
+        }
+#endif
+        std::vector<ExecutionProvider> providers;
+        if (parser.value(epOption).trimmed().toLower() == "all") {
+            providers = availableExecutionProviders();
+        }
+        else {
+            for (const auto &name : parser.value(epOption).split(',')) {
+                ExecutionProvider ep;
+                if (!parseExecutionProvider(name, ep)) {
+                    std::fprintf(stderr, "Unknown execution provider: %s\n", qPrintable(name));
+                    return 1;
+                }
+                providers.push_back(ep);
+            }
+        }
+
+        for (auto ep : providers) {
+            QString name = executionProviderName(ep);
+            // A provider missing from the build would silently benchmark the CPU under its name.
+            if (!isExecutionProviderAvailable(ep)) {
+                std::printf("%s: not available in the loaded ONNX Runtime library, skipped\n", qPrintable(name));
+                continue;
+            }
+            auto someInference = std::make_unique<SOMEInference>(parser.value(modelOption));
+            QObject::connect(someInference.get(), &Inference::logMsgError, [](const QString &msg) {
+                std::fprintf(stderr, "%s\n", qPrintable(msg));
+            });
+            SessionConfig sessionConfig;
+            sessionConfig.loadMode = (parser.value(loadModeOption) == "path") ? ModelLoadMode::Path
+                                                                              : ModelLoadMode::MemoryMap;
+            someInference->setSessionConfig(sessionConfig);
+            auto memoryBefore = getProcessMemory();
+            auto loadStart = std::chrono::steady_clock::now();
+            if (!someInference->initSession(ep)) {
+                std::fprintf(stderr, "%s: session initialization failed.\n", qPrintable(name));
+                return 1;
+            }
+            if (someInference->activeProvider() != ep) {
+                std::printf("%s: fell back to the CPU provider, skipped\n", qPrintable(name));
+                continue;
+            }
+            std::chrono::duration<double, std::milli> loadTime = std::chrono::steady_clock::now() - loadStart;
+            auto memoryAfter = getProcessMemory();
+            std::printf("%s: model load (%s): %.0f ms, resident +%.1f MB, private +%.1f MB\n",
+                        qPrintable(name), qPrintable(parser.value(loadModeOption)), loadTime.count(),
+                        (static_cast<double>(memoryAfter.resident) - memoryBefore.resident) / (1024.0 * 1024.0),
+                        (static_cast<double>(memoryAfter.privateResident) - memoryBefore.privateResident) /
+                        (1024.0 * 1024.0));
+            if (parser.isSet(bucketsOption)) {
+                LengthBucketOptions bucketOptions;
+                bucketOptions.enabled = true;
+                bucketOptions.growth = parser.value(bucketsOption).toDouble();
+                someInference->setLengthBuckets(bucketOptions);
+            }
+            BackendRun run;
+            run.name = name;
+            run.someInference = someInference.get();
+            run.backend = std::move(someInference);
+            backends.push_back(std::move(run));
+        }
+        if (backends.empty()) {
+            std::fprintf(stderr, "None of the execution providers can be used.\n");
+            return 1;
+        }
+    }
+    else {
+        BackendRun run;
+        run.name = "mock";
+        run.backend = std::make_unique<MockInference>(
+                parser.value(costOption).toDouble(),
+                parser.isSet(sleepOption) ? MockInference::CostMode::Sleep : MockInference::CostMode::Spin);
+        backends.push_back(std::move(run));
+    }
+
+    std::unique_ptr<PreprocessCache> cache;
+    if (parser.isSet(cacheDirOption)) {
+        cache = std::make_unique<PreprocessCache>(parser.value(cacheDirOption),
+                                                  parser.value(cacheSizeOption).toULongLong() * 1024 * 1024);
+    }
+
+    // Working directory
+    QTemporaryDir tempDir;
+    QString workDir = parser.isSet(keepOption) ? parser.value(keepOption) : tempDir.path();
+    if (!QDir().mkpath(workDir)) {
+        std::fprintf(stderr, "Can't create working directory %s\n", qPrintable(workDir));
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    out << QString("%1 %2 %3").arg("backend", -9).arg("scenario", -20).arg("audio(s)", 9);
+    for (const auto *stage : kStages) {
+        out << QString(" %1").arg(stage, 9);
+    }
+    out << QString(" %1 %2 %3 %4 %5 %6 %7 %8 %9 %10\n")
+            .arg("total(s)", 9).arg("RTF", 7).arg("chunks", 6).arg("notes", 6)
+            .arg("peakRSS(MB)", 11).arg("budgetPeak(MB)", 14).arg("waits", 5)
+            .arg("copies", 6).arg("copied(MB)", 10).arg("notes-hash", 16);
+    out.flush();
+
+    std::vector<BenchResult> results;
+    for (const auto &spec : bench::defaultScenarios()) {
+        if (parser.isSet(scenarioOption) && !spec.name.contains(parser.value(scenarioOption))) {
+            continue;
+        }
+        auto audioPath = QDir(workDir).filePath(spec.name + ".wav");
+        auto midiPath = QDir(workDir).filePath(spec.name + ".mid");
+        if (!bench::writeWavFile(audioPath, bench::generateSyntheticAudio(spec), spec.sampleRate, spec.channels)) {
+            std::fprintf(stderr, "Can't write %s\n", qPrintable(audioPath));
+            return 1;
+        }
+
+        for (const auto &backendRun : backends) {
+            for (int run = 0; run < repeat; ++run) {
+                Pipeline pipeline;
+                pipeline.setPreprocessCache(cache.get());
+                QObject::connect(&pipeline, &Pipeline::logMsgError, [](const QString &msg) {
+                    std::fprintf(stderr, "%s\n", qPrintable(msg));
+                });
+                if (verbose) {
+                    QObject::connect(&pipeline, &Pipeline::logMsgInfo, [](const QString &msg) {
+                        std::fprintf(stderr, "%s\n", qPrintable(msg));
+                    });
+                }
+
+                // Same stages as Pipeline::run(), kept apart so the notes can be hashed.
+                AudioBuffer audio;
+                MarkerList markers;
+                std::vector<NotesPtr> chunkNotes;
+                bool ok = pipeline.preprocess(audioPath, audio, markers) &&
+                          pipeline.infer(*backendRun.backend, audio, markers, chunkNotes) &&
+                          pipeline.writeMidi(midiPath, audio, markers, chunkNotes, 120.0);
+                if (!ok) {
+                    std::fprintf(stderr, "Scenario %s failed.\n", qPrintable(spec.name));
+                    return 1;
+                }
+                auto jobResult = pipeline.publish(audioPath, audio, markers, std::move(chunkNotes));
+
+                BenchResult result;
+                result.backend = backendRun.name;
+                result.scenario = spec.name;
+                result.run = run;
+                result.stats = pipeline.stats();
+                result.notesHash = hashNotes(jobResult->chunkNotes);
+                result.peakRss = getPeakRss();
+
+                const auto &stats = result.stats;
+                out << QString("%1 %2 %3").arg(backendRun.name, -9).arg(spec.name, -20)
+                        .arg(stats.audioSeconds, 9, 'f', 2);
+                for (const auto *stage : kStages) {
+                    out << QString(" %1").arg(stats.stageTime(stage), 9, 'f', 4);
+                }
+                out << QString(" %1 %2 %3 %4 %5 %6 %7 %8 %9 %10\n")
+                        .arg(stats.totalSeconds(), 9, 'f', 4)
+                        .arg(stats.realTimeFactor(), 7, 'f', 4)
+                        .arg(stats.chunkCount, 6)
+                        .arg(stats.noteCount, 6)
+                        .arg(result.peakRss / (1024.0 * 1024.0), 11, 'f', 1)
+                        .arg(stats.memoryPeak / (1024.0 * 1024.0), 14, 'f', 1)
+                        .arg(stats.memoryWaits, 5)
+                        .arg(stats.copies, 6)
+                        .arg(stats.copiedBytes / (1024.0 * 1024.0), 10, 'f', 1)
+                        .arg(result.notesHash, 16, 16, QChar('0'));
+                out.flush();
+                results.push_back(std::move(result));
+            }
+        }
+    }
+
+    for (const auto &backendRun : backends) {
+        if (!backendRun.someInference) {
+            continue;
+        }
+        out << QString("%1 inference (%2): %3\n")
+                .arg(backendRun.name)
+                .arg(parser.isSet(bucketsOption) ? "length buckets x" + parser.value(bucketsOption) : "exact lengths",
+                     backendRun.someInference->runStats().summary());
+        out.flush();
+    }
+
+    // Per provider: the RTF of inference alone over all scenarios, and whether the notes match those of
+    // the first provider (other kernels may round differently).
+    if (backends.size() > 1) {
+        for (const auto &backendRun : backends) {
+            double audioSeconds = 0.0, inferenceSeconds = 0.0;
+            std::size_t compared = 0, matching = 0;
+            for (const auto &result : results) {
+                if (result.backend != backendRun.name) {
+                    continue;
+                }
+                audioSeconds += result.stats.audioSeconds;
+                inferenceSeconds += result.stats.stageTime("inference");
+                auto reference = std::find_if(results.begin(), results.end(), [&](const BenchResult &other) {
+                    return other.backend == backends.front().name && other.scenario == result.scenario &&
+                           other.run == result.run;
+                });
+                ++compared;
+                matching += reference != results.end() && reference->notesHash == result.notesHash;
+            }
+            out << QString("%1: inference RTF %2 over %3 s of audio, notes match %4: %5/%6\n")
+                    .arg(backendRun.name, -9)
+                    .arg(audioSeconds > 0 ? inferenceSeconds / audioSeconds : 0.0, 0, 'f', 4)
+                    .arg(audioSeconds, 0, 'f', 1)
+                    .arg(backends.front().name)
+                    .arg(matching).arg(compared);
+        }
+        out.flush();
+    }
+
+    if (cache) {
+        auto cacheStats = cache->stats();
+        out << QString("preprocess cache: %1 hits, %2 misses, %3 stores, %4 evictions, %5 MB read, %6 MB written\n")
+                .arg(cacheStats.hits).arg(cacheStats.misses).arg(cacheStats.stores).arg(cacheStats.evictions)
+                .arg(cacheStats.bytesRead / (1024.0 * 1024.0), 0, 'f', 1)
+                .arg(cacheStats.bytesWritten / (1024.0 * 1024.0), 0, 'f', 1);
+        out.flush();
+    }
+
+    if (parser.isSet(csvOption)) {
+        QFile csvFile(parser.value(csvOption));
+        if (!csvFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            std::fprintf(stderr, "Can't write %s\n", qPrintable(csvFile.fileName()));
+            return 1;
+        }
+        QTextStream csv(&csvFile);
+        csv << "backend,scenario,audio_s";
+        for (const auto *stage : kStages) {
+            csv << ',' << stage << "_s";
+        }
+        csv << ",total_s,rtf,chunks,notes,peak_rss_bytes,budget_bytes,budget_peak_bytes,budget_waits,budget_wait_s"
+               ",copies,copied_bytes,notes_hash\n";
+        for (const auto &result : results) {
+            const auto &stats = result.stats;
+            csv << result.backend << ',' << result.scenario << ',' << stats.audioSeconds;
+            for (const auto *stage : kStages) {
+                csv << ',' << stats.stageTime(stage);
+            }
+            csv << ',' << stats.totalSeconds() << ',' << stats.realTimeFactor()
+                << ',' << stats.chunkCount << ',' << stats.noteCount
+                << ',' << result.peakRss << ',' << stats.memoryBudget << ',' << stats.memoryPeak
+                << ',' << stats.memoryWaits << ',' << stats.memoryWaitSeconds
+                << ',' << stats.copies << ',' << stats.copiedBytes
+                << ',' << QString::number(result.notesHash, 16) << '\n';
+        }
+    }
+    return 0;
+}
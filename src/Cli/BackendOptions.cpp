@@ -0,0 +1,78 @@
+#include <cstdio>
+
+#ifdef ORT_API_MANUAL_INIT
+#include "OrtLoader.h"
+#endif
+#include "Inference/MockInference.h"
+#include "Inference/SOMEInference.h"
+
+#include "BackendOptions.h"
+
+namespace some::cli {
+
+    void BackendOptions::addTo(QCommandLineParser &parser) const {
+        parser.addOptions({model, mock, ep, device, loadMode, lengthBuckets});
+    }
+
+    std::unique_ptr<InferenceBackend> BackendOptions::create(const QCommandLineParser &parser,
+                                                             QString &error) const {
+        if (parser.isSet(mock)) {
+            return std::make_unique<MockInference>(parser.value(mock).toDouble());
+        }
+        if (!parser.isSet(model)) {
+            error = "Either --model or --mock is required.";
+            return nullptr;
+        }
+
+        ExecutionProvider provider;
+        if (!parseExecutionProvider(parser.value(ep), provider)) {
+            error = QString("Unknown execution provider: %1").arg(parser.value(ep));
+            return nullptr;
+        }
+
+        SessionConfig config;
+        auto loadModeName = parser.value(loadMode).toLower();
+        if (loadModeName == "mmap") {
+            config.loadMode = ModelLoadMode::MemoryMap;
+        }
+        else if (loadModeName == "path") {
+            config.loadMode = ModelLoadMode::Path;
+        }
+        else {
+            error = QString("Unknown load mode: %1").arg(loadModeName);
+            return nullptr;
+        }
+
+#ifdef ORT_API_MANUAL_INIT
+        static bool ortLoaded = false;
+        if (!ortLoaded) {
+            QString errorString;
+            if (!InitOrtLibrary(&errorString)) {
+                error = QString("Could not load ONNX Runtime library: %1").arg(errorString);
+                return nullptr;
+            }
+            ortLoaded = true;
+        }
+#endif
+        auto inference = std::make_unique<SOMEInference>(parser.value(model));
+        QObject::connect(inference.get(), &Inference::logMsgError, [](const QString &msg) {
+            std::fprintf(stderr, "%s\n", qPrintable(msg));
+        });
+        QObject::connect(inference.get(), &Inference::logMsgInfo, [](const QString &msg) {
+            std::fprintf(stderr, "%s\n", qPrintable(msg));
+        });
+        inference->setSessionConfig(config);
+        if (parser.isSet(lengthBuckets)) {
+            LengthBucketOptions bucketOptions;
+            bucketOptions.enabled = true;
+            bucketOptions.growth = parser.value(lengthBuckets).toDouble();
+            inference->setLengthBuckets(bucketOptions);
+        }
+        if (!inference->initSession(provider, parser.value(device).toInt())) {
+            error = "Session initialization failed.";
+            return nullptr;
+        }
+        return inference;
+    }
+
+}  // namespace some::cli
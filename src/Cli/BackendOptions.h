@@ -0,0 +1,36 @@
+#ifndef SOME_GUI_BACKENDOPTIONS_H
+#define SOME_GUI_BACKENDOPTIONS_H
+
+#include <memory>
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QString>
+
+#include "Inference/InferenceBackend.h"
+
+namespace some::cli {
+
+    // Command line options that choose the inference backend, shared by the some-cli commands.
+    // --model runs an ONNX model; --mock uses MockInference with a simulated cost.
+    struct BackendOptions {
+        QCommandLineOption model{{"m", "model"}, "SOME model (.onnx).", "path"};
+        QCommandLineOption mock{"mock", "Use the mock backend with this cost (seconds per second of audio).",
+                                "factor"};
+        QCommandLineOption ep{"ep", "Execution provider: cpu, cuda, dml, xnnpack, dnnl or openvino.", "name", "cpu"};
+        QCommandLineOption device{"device", "GPU device index.", "index", "0"};
+        QCommandLineOption loadMode{"load-mode", "Model loading: mmap (share weights between processes) or path.",
+                                    "mode", "mmap"};
+        QCommandLineOption lengthBuckets{"length-buckets",
+                                         "Pad chunks to lengths growing by this factor (e.g. 1.25), so ONNX Runtime "
+                                         "can reuse its memory plans.", "factor"};
+
+        void addTo(QCommandLineParser &parser) const;
+
+        // Returns nullptr and sets `error` on failure.
+        std::unique_ptr<InferenceBackend> create(const QCommandLineParser &parser, QString &error) const;
+    };
+
+}  // namespace some::cli
+
+#endif //SOME_GUI_BACKENDOPTIONS_H
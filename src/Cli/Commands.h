@@ -0,0 +1,17 @@
+#ifndef SOME_GUI_COMMANDS_H
+#define SOME_GUI_COMMANDS_H
+
+#include <QStringList>
+
+namespace some::cli {
+
+    // Each command parses its own options. `arguments` starts with the program and command name.
+    int runStreamCommand(const QStringList &arguments);
+    int runInspectCommand(const QStringList &arguments);
+    int runCompareCommand(const QStringList &arguments);
+    int runPlanCommand(const QStringList &arguments);
+    int runWatchCommand(const QStringList &arguments);
+
+}  // namespace some::cli
+
+#endif //SOME_GUI_COMMANDS_H
@@ -0,0 +1,111 @@
+#include <cstdio>
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#ifdef ORT_API_MANUAL_INIT
+#include "OrtLoader.h"
+#endif
+#include "Pipeline/MultiModelJob.h"
+#include "Pipeline/PreprocessCache.h"
+#include "Commands.h"
+#include "ThreadOptions.h"
+
+namespace some::cli {
+
+    int runCompareCommand(const QStringList &arguments) {
+        QCommandLineParser parser;
+        parser.setApplicationDescription(
+                "Run several models over one audio file. The audio is decoded, resampled and sliced once,\n"
+                "then every model infers the same chunks and writes <audio>.<model>.mid to the output directory.");
+        parser.addHelpOption();
+        parser.addPositionalArgument("models", "Models (.onnx) to compare.", "<model>...");
+        QCommandLineOption audioOption({"i", "audio"}, "Input audio file.", "path");
+        QCommandLineOption outDirOption({"o", "out-dir"}, "Directory for the MIDI files.", "dir", ".");
+        QCommandLineOption tempoOption("tempo", "MIDI tempo.", "bpm", "120");
+        QCommandLineOption parallelOption({"j", "parallel"}, "Sessions run at the same time (0 = auto).", "count",
+                                          "0");
+        QCommandLineOption threadsOption("threads", "Intra-op threads per session (0 = from the thread plan).",
+                                         "count", "0");
+        QCommandLineOption loadModeOption("load-mode", "Model loading: mmap or path.", "mode", "mmap");
+        QCommandLineOption csvOption("csv", "Also write the timings as CSV to this file.", "path");
+        QCommandLineOption profileOption("profile", "Profile each session and write the time per operator next to "
+                                                    "its MIDI file (<midi>.ort-profile.txt).");
+        QCommandLineOption quietOption({"q", "quiet"}, "Only print errors and the timing table.");
+        parser.addOptions({audioOption, outDirOption, tempoOption, parallelOption, threadsOption, loadModeOption,
+                           csvOption, profileOption, quietOption});
+        ThreadOptions threadOptions;
+        threadOptions.addTo(parser);
+        parser.process(arguments);
+
+        auto modelPaths = parser.positionalArguments();
+        if (!parser.isSet(audioOption) || modelPaths.isEmpty()) {
+            parser.showHelp(1);
+        }
+        QDir outDir(parser.value(outDirOption));
+        if (!QDir().mkpath(outDir.path())) {
+            std::fprintf(stderr, "Can't create %s\n", qPrintable(outDir.path()));
+            return 1;
+        }
+        auto audioPath = parser.value(audioOption);
+        QStringList outPaths;
+        for (const auto &modelPath : modelPaths) {
+            outPaths << outDir.filePath(QString("%1.%2.mid").arg(QFileInfo(audioPath).completeBaseName(),
+                                                                 QFileInfo(modelPath).completeBaseName()));
+        }
+
+#ifdef ORT_API_MANUAL_INIT
+        QString errorString;
+        if (!InitOrtLibrary(&errorString)) {
+            std::fprintf(stderr, "Could not load ONNX Runtime library: %s\n", qPrintable(errorString));
+            return 1;
+        }
+#endif
+
+        SessionConfig config;
+        config.loadMode = (parser.value(loadModeOption) == "path") ? ModelLoadMode::Path : ModelLoadMode::MemoryMap;
+        config.intraOpThreads = parser.value(threadsOption).toInt();
+
+        MultiModelJob job;
+        job.setSessionConfig(config);
+        job.setMaxParallel(parser.value(parallelOption).toInt());
+        job.setThreadPlanOptions(threadOptions.planOptions(parser));
+        job.setPreprocessCache(PreprocessCache::global());
+        job.setProfiling(parser.isSet(profileOption));
+        QObject::connect(&job, &MultiModelJob::logMsgError, [](const QString &msg) {
+            std::fprintf(stderr, "%s\n", qPrintable(msg));
+        });
+        if (!parser.isSet(quietOption)) {
+            QObject::connect(&job, &MultiModelJob::logMsgInfo, [](const QString &msg) {
+                std::fprintf(stderr, "%s\n", qPrintable(msg));
+            });
+        }
+        bool ok = job.run(audioPath, modelPaths, outPaths, parser.value(tempoOption).toDouble());
+        if (job.results().empty()) {
+            return 1;
+        }
+        std::printf("%s\n", qPrintable(job.timingTable()));
+
+        if (parser.isSet(csvOption)) {
+            QFile csvFile(parser.value(csvOption));
+            if (!csvFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+                std::fprintf(stderr, "Can't write %s\n", qPrintable(csvFile.fileName()));
+                return 1;
+            }
+            QTextStream csv(&csvFile);
+            csv << "model,ok,audio_s,preprocess_s,load_s,inference_s,midi_s,notes,wall_s\n";
+            for (const auto &result : job.results()) {
+                csv << result.modelPath << ',' << (result.ok ? 1 : 0)
+                    << ',' << job.preprocessStats().audioSeconds << ',' << job.preprocessStats().totalSeconds()
+                    << ',' << result.loadSeconds << ',' << result.stats.stageTime("inference")
+                    << ',' << result.stats.stageTime("midi") << ',' << result.stats.noteCount
+                    << ',' << job.wallSeconds() << '\n';
+            }
+        }
+        return ok ? 0 : 2;
+    }
+
+}  // namespace some::cli
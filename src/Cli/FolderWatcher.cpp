@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <limits>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QSocketNotifier>
+
+#include "FolderWatcher.h"
+
+namespace some::cli {
+
+    FolderWatcher::FolderWatcher(const QString &root, const QStringList &nameFilters, int debounceMs,
+                                 QObject *parent)
+            : QObject(parent), m_root(root), m_nameFilters(nameFilters), m_debounceMs(std::max(0, debounceMs)) {
+        m_timer.setSingleShot(true);
+        connect(&m_timer, &QTimer::timeout, this, &FolderWatcher::checkCandidates);
+        m_clock.start();
+    }
+
+    FolderWatcher::~FolderWatcher() {
+#if defined(__linux__)
+        if (m_inotifyFd >= 0) {
+            ::close(m_inotifyFd);
+        }
+#endif
+    }
+
+    bool FolderWatcher::start(QString *error) {
+        if (!m_root.exists()) {
+            if (error) {
+                *error = QString("%1 is not a directory.").arg(m_root.path());
+            }
+            return false;
+        }
+#if defined(__linux__)
+        m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyFd >= 0) {
+            m_notifier = new QSocketNotifier(m_inotifyFd, QSocketNotifier::Read, this);
+            connect(m_notifier, &QSocketNotifier::activated, this, &FolderWatcher::readInotifyEvents);
+        }
+#endif
+        if (m_inotifyFd < 0) {
+            m_fsWatcher = new QFileSystemWatcher(this);
+            connect(m_fsWatcher, &QFileSystemWatcher::directoryChanged, this, &FolderWatcher::directoryChanged);
+        }
+        watchTree(m_root.absolutePath(), false);
+        if (watchedDirectories() == 0) {
+            if (error) {
+                *error = QString("Can't watch %1.").arg(m_root.path());
+            }
+            return false;
+        }
+        return true;
+    }
+
+    void FolderWatcher::addExisting() {
+        QDirIterator it(m_root.absolutePath(), m_nameFilters, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            touch(it.next());
+        }
+    }
+
+    bool FolderWatcher::usesInotify() const {
+        return m_inotifyFd >= 0;
+    }
+
+    int FolderWatcher::watchedDirectories() const {
+        return usesInotify() ? m_watchDirs.size() : m_directories.size();
+    }
+
+    void FolderWatcher::watchTree(const QString &dir, bool addFiles) {
+        watchDirectory(dir);
+        QDirIterator it(dir, QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            auto path = it.next();
+            auto info = it.fileInfo();
+            if (info.isDir()) {
+                watchDirectory(path);
+            }
+            else if (matches(info.fileName())) {
+                if (m_fsWatcher) {
+                    m_known.insert(path, {info.size(), info.lastModified()});
+                }
+                if (addFiles) {
+                    touch(path);
+                }
+            }
+        }
+    }
+
+    void FolderWatcher::watchDirectory(const QString &dir) {
+#if defined(__linux__)
+        if (m_inotifyFd >= 0) {
+            auto wd = inotify_add_watch(m_inotifyFd, QFile::encodeName(dir).constData(),
+                                        IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+            if (wd >= 0) {
+                m_watchDirs.insert(wd, dir);
+            }
+            return;
+        }
+#endif
+        if (!m_directories.contains(dir) && m_fsWatcher->addPath(dir)) {
+            m_directories.insert(dir);
+        }
+    }
+
+    void FolderWatcher::readInotifyEvents() {
+#if defined(__linux__)
+        alignas(inotify_event) char buffer[64 * 1024];
+        for (;;) {
+            auto length = ::read(m_inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break;  // EAGAIN: drained
+            }
+            for (char *p = buffer; p < buffer + length;) {
+                const auto *event = reinterpret_cast<const inotify_event *>(p);
+                p += sizeof(inotify_event) + event->len;
+                if (event->mask & IN_Q_OVERFLOW) {
+                    // Events were dropped; everything in the tree may be new.
+                    watchTree(m_root.absolutePath(), true);
+                    continue;
+                }
+                if (event->mask & IN_IGNORED) {
+                    m_watchDirs.remove(event->wd);
+                    continue;
+                }
+                auto dir = m_watchDirs.value(event->wd);
+                if (dir.isEmpty() || event->len == 0) {
+                    continue;
+                }
+                auto name = QFile::decodeName(event->name);
+                auto path = dir + '/' + name;
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        // Files may have been written into it before the watch was added.
+                        watchTree(path, true);
+                    }
+                }
+                else if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) && matches(name)) {
+                    touch(path);
+                }
+            }
+        }
+#endif
+    }
+
+    void FolderWatcher::directoryChanged(const QString &dir) {
+        QDir directory(dir);
+        if (!directory.exists()) {
+            m_directories.remove(dir);
+            return;
+        }
+        for (const auto &info : directory.entryInfoList(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot)) {
+            auto path = info.absoluteFilePath();
+            if (info.isDir()) {
+                if (!m_directories.contains(path)) {
+                    watchTree(path, true);
+                }
+                continue;
+            }
+            if (!matches(info.fileName())) {
+                continue;
+            }
+            QPair<qint64, QDateTime> state {info.size(), info.lastModified()};
+            auto it = m_known.find(path);
+            if (it == m_known.end() || *it != state) {
+                m_known.insert(path, state);
+                touch(path);
+            }
+        }
+    }
+
+    void FolderWatcher::touch(const QString &path) {
+        QFileInfo info(path);
+        if (!info.isFile()) {
+            m_candidates.remove(path);
+            return;
+        }
+        auto &candidate = m_candidates[path];
+        candidate.size = info.size();
+        candidate.modified = info.lastModified();
+        candidate.deadline = m_clock.elapsed() + m_debounceMs;
+        armTimer();
+    }
+
+    void FolderWatcher::checkCandidates() {
+        auto now = m_clock.elapsed();
+        QStringList ready;
+        for (auto it = m_candidates.begin(); it != m_candidates.end();) {
+            if (it->deadline > now) {
+                ++it;
+                continue;
+            }
+            QFileInfo info(it.key());
+            if (!info.isFile()) {
+                it = m_candidates.erase(it);
+                continue;
+            }
+            if (info.size() != it->size || info.lastModified() != it->modified) {
+                // Still being written: wait for another quiet interval.
+                it->size = info.size();
+                it->modified = info.lastModified();
+                it->deadline = now + m_debounceMs;
+                ++it;
+                continue;
+            }
+            ready << it.key();
+            it = m_candidates.erase(it);
+        }
+        armTimer();
+        for (const auto &path : ready) {
+            Q_EMIT fileReady(path);
+        }
+    }
+
+    void FolderWatcher::armTimer() {
+        if (m_candidates.isEmpty()) {
+            m_timer.stop();
+            return;
+        }
+        auto next = std::numeric_limits<qint64>::max();
+        for (const auto &candidate : m_candidates) {
+            next = std::min(next, candidate.deadline);
+        }
+        m_timer.start(static_cast<int>(std::max<qint64>(0, next - m_clock.elapsed())));
+    }
+
+    bool FolderWatcher::matches(const QString &fileName) const {
+        return QDir::match(m_nameFilters, fileName);
+    }
+
+}  // namespace some::cli
@@ -0,0 +1,82 @@
+#ifndef SOME_GUI_FOLDERWATCHER_H
+#define SOME_GUI_FOLDERWATCHER_H
+
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+class QFileSystemWatcher;
+class QSocketNotifier;
+
+namespace some::cli {
+
+    // Reports files that appear in a directory tree once they are completely written.
+    //
+    // On Linux the tree is watched with inotify: a file is a candidate when a writer closes it
+    // (IN_CLOSE_WRITE) or it is moved in (IN_MOVED_TO). Elsewhere, QFileSystemWatcher reports which
+    // directory changed and only that directory is listed. Either way, a candidate is reported once
+    // its size and modification time have not changed for the debounce interval, so a writer that
+    // closes and reopens a file, or a copy without close events, is not picked up half-way.
+    // Nothing is polled while no files arrive.
+    class FolderWatcher : public QObject {
+        Q_OBJECT
+    public:
+        FolderWatcher(const QString &root, const QStringList &nameFilters, int debounceMs,
+                      QObject *parent = nullptr);
+        ~FolderWatcher() override;
+
+        // Starts watching the root and every directory below it. Returns false and sets `error`
+        // if the root can't be watched.
+        bool start(QString *error = nullptr);
+        // Treats every matching file already in the tree as new.
+        void addExisting();
+
+        bool usesInotify() const;
+        int watchedDirectories() const;
+
+    Q_SIGNALS:
+        void fileReady(const QString &path);
+
+    private:
+        struct Candidate {
+            qint64 size = -1;
+            QDateTime modified;
+            qint64 deadline = 0;  // ms on m_clock
+        };
+
+        void watchTree(const QString &dir, bool addFiles);
+        void watchDirectory(const QString &dir);
+        void readInotifyEvents();
+        void directoryChanged(const QString &dir);
+        void touch(const QString &path);
+        void checkCandidates();
+        void armTimer();
+        bool matches(const QString &fileName) const;
+
+        QDir m_root;
+        QStringList m_nameFilters;
+        int m_debounceMs;
+        QElapsedTimer m_clock;
+        QTimer m_timer;
+        QHash<QString, Candidate> m_candidates;
+
+        int m_inotifyFd = -1;
+        QSocketNotifier *m_notifier = nullptr;
+        QHash<int, QString> m_watchDirs;  // inotify watch descriptor -> directory
+
+        QFileSystemWatcher *m_fsWatcher = nullptr;
+        // Fallback only: size and modification time of every file last seen, to tell which files
+        // a directory change was about.
+        QHash<QString, QPair<qint64, QDateTime>> m_known;
+        QSet<QString> m_directories;
+    };  // class FolderWatcher
+
+}  // namespace some::cli
+
+#endif //SOME_GUI_FOLDERWATCHER_H
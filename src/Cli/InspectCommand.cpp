@@ -0,0 +1,49 @@
+#include <cstdio>
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+
+#include "Inference/ModelScanner.h"
+#include "Commands.h"
+
+namespace some::cli {
+
+    int runInspectCommand(const QStringList &arguments) {
+        QCommandLineParser parser;
+        parser.setApplicationDescription(
+                "Print the inputs, outputs, opset and metadata of ONNX models without loading them,\n"
+                "and whether SOME can use them. Directories are searched for *.onnx files.");
+        parser.addHelpOption();
+        parser.addPositionalArgument("paths", "Model files or directories.", "<path>...");
+        parser.process(arguments);
+
+        QStringList modelPaths;
+        for (const auto &path : parser.positionalArguments()) {
+            QFileInfo info(path);
+            if (info.isDir()) {
+                for (const auto &entry : QDir(path).entryInfoList({"*.onnx"}, QDir::Files, QDir::Name)) {
+                    modelPaths << entry.filePath();
+                }
+            }
+            else {
+                modelPaths << path;
+            }
+        }
+        if (modelPaths.isEmpty()) {
+            parser.showHelp(1);
+        }
+
+        int invalidCount = 0;
+        for (const auto &path : modelPaths) {
+            auto result = ModelScanner::inspect(path);
+            std::printf("%s: %s\n", qPrintable(path), result.isValid() ? "ok" : qPrintable(result.error));
+            for (const auto &line : onnx::describe(result.info).split('\n')) {
+                std::printf("    %s\n", qPrintable(line));
+            }
+            invalidCount += result.isValid() ? 0 : 1;
+        }
+        return invalidCount == 0 ? 0 : 2;
+    }
+
+}  // namespace some::cli
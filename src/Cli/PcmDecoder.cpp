@@ -0,0 +1,206 @@
+#include <cstdint>
+#include <cstring>
+
+#include "Dsp/Kernels.h"
+#include "PcmDecoder.h"
+
+namespace some::cli {
+
+    namespace {
+        constexpr std::size_t kMaxHeaderSize = 1 << 20;
+
+        std::uint32_t readLe16(const char *p) {
+            auto u = reinterpret_cast<const unsigned char *>(p);
+            return static_cast<std::uint32_t>(u[0]) | (static_cast<std::uint32_t>(u[1]) << 8);
+        }
+
+        std::uint32_t readLe32(const char *p) {
+            return readLe16(p) | (readLe16(p + 2) << 16);
+        }
+    }
+
+    int PcmFormat::bytesPerSample() const {
+        switch (sampleFormat) {
+            case SampleFormat::S16LE:
+                return 2;
+            case SampleFormat::S24LE:
+                return 3;
+            case SampleFormat::S32LE:
+            case SampleFormat::F32LE:
+                return 4;
+        }
+        return 0;
+    }
+
+    int PcmFormat::bytesPerFrame() const {
+        return bytesPerSample() * channels;
+    }
+
+    bool parseSampleFormat(const QString &name, SampleFormat &format) {
+        if (name == "s16le") {
+            format = SampleFormat::S16LE;
+        }
+        else if (name == "s24le") {
+            format = SampleFormat::S24LE;
+        }
+        else if (name == "s32le") {
+            format = SampleFormat::S32LE;
+        }
+        else if (name == "f32le") {
+            format = SampleFormat::F32LE;
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+
+    PcmDecoder::PcmDecoder(const PcmFormat &rawFormat, bool detectWav)
+            : m_format(rawFormat), m_state(detectWav ? State::Detect : State::Data) {}
+
+    bool PcmDecoder::feed(const char *data, std::size_t size, std::vector<float> &frames) {
+        if (m_state == State::Error) {
+            return false;
+        }
+        m_buffer.insert(m_buffer.end(), data, data + size);
+
+        if (m_state == State::Detect) {
+            if (m_buffer.size() < 12) {
+                return true;
+            }
+            if (std::memcmp(m_buffer.data(), "RIFF", 4) == 0 && std::memcmp(m_buffer.data() + 8, "WAVE", 4) == 0) {
+                m_state = State::Header;
+                m_headerPos = 12;
+            }
+            else {
+                m_state = State::Data;
+            }
+        }
+        if (m_state == State::Header && !parseHeader()) {
+            return m_state != State::Error;
+        }
+        if (m_state == State::Data) {
+            decode(frames);
+        }
+        return true;
+    }
+
+    bool PcmDecoder::isReady() const {
+        return m_state == State::Data;
+    }
+
+    const PcmFormat &PcmDecoder::format() const {
+        return m_format;
+    }
+
+    QString PcmDecoder::errorString() const {
+        return m_error;
+    }
+
+    bool PcmDecoder::parseHeader() {
+        // Returns true once the data chunk is reached, false if more bytes are needed or on error.
+        while (m_headerPos + 8 <= m_buffer.size()) {
+            const char *chunk = m_buffer.data() + m_headerPos;
+            auto chunkSize = readLe32(chunk + 4);
+            if (std::memcmp(chunk, "data", 4) == 0) {
+                if (!m_hasFormat) {
+                    m_state = State::Error;
+                    m_error = "WAV data chunk before the fmt chunk.";
+                    return false;
+                }
+                m_buffer.erase(m_buffer.begin(), m_buffer.begin() + static_cast<std::ptrdiff_t>(m_headerPos + 8));
+                m_state = State::Data;
+                return true;
+            }
+            std::size_t paddedSize = chunkSize + (chunkSize & 1);
+            if (m_headerPos + 8 + paddedSize > kMaxHeaderSize) {
+                m_state = State::Error;
+                m_error = "WAV header is too large.";
+                return false;
+            }
+            if (m_headerPos + 8 + paddedSize > m_buffer.size()) {
+                return false;
+            }
+            if (std::memcmp(chunk, "fmt ", 4) == 0) {
+                if (chunkSize < 16) {
+                    m_state = State::Error;
+                    m_error = "WAV fmt chunk is too short.";
+                    return false;
+                }
+                const char *fmt = chunk + 8;
+                auto audioFormat = readLe16(fmt);
+                auto channels = static_cast<int>(readLe16(fmt + 2));
+                auto sampleRate = static_cast<int>(readLe32(fmt + 4));
+                auto bitsPerSample = readLe16(fmt + 14);
+                if (audioFormat == 0xFFFE && chunkSize >= 40) {
+                    // WAVE_FORMAT_EXTENSIBLE: the format tag is the start of the sub-format GUID.
+                    audioFormat = readLe16(fmt + 24);
+                }
+                if (audioFormat == 1 && bitsPerSample == 16) {
+                    m_format.sampleFormat = SampleFormat::S16LE;
+                }
+                else if (audioFormat == 1 && bitsPerSample == 24) {
+                    m_format.sampleFormat = SampleFormat::S24LE;
+                }
+                else if (audioFormat == 1 && bitsPerSample == 32) {
+                    m_format.sampleFormat = SampleFormat::S32LE;
+                }
+                else if (audioFormat == 3 && bitsPerSample == 32) {
+                    m_format.sampleFormat = SampleFormat::F32LE;
+                }
+                else {
+                    m_state = State::Error;
+                    m_error = QString("Unsupported WAV sample format %1 with %2 bits.")
+                            .arg(audioFormat).arg(bitsPerSample);
+                    return false;
+                }
+                if (channels <= 0 || sampleRate <= 0) {
+                    m_state = State::Error;
+                    m_error = "Invalid WAV channel count or sample rate.";
+                    return false;
+                }
+                m_format.channels = channels;
+                m_format.sampleRate = sampleRate;
+                m_hasFormat = true;
+            }
+            m_headerPos += 8 + paddedSize;
+        }
+        return false;
+    }
+
+    void PcmDecoder::decode(std::vector<float> &frames) {
+        auto bytesPerFrame = static_cast<std::size_t>(m_format.bytesPerFrame());
+        auto frameCount = m_buffer.size() / bytesPerFrame;
+        auto sampleCount = frameCount * m_format.channels;
+        auto first = frames.size();
+        frames.resize(first + sampleCount);
+        float *out = frames.data() + first;
+        const char *in = m_buffer.data();
+
+        switch (m_format.sampleFormat) {
+            case SampleFormat::S16LE:
+                dsp::s16ToFloat(in, out, sampleCount);
+                break;
+            case SampleFormat::S24LE:
+                for (std::size_t i = 0; i < sampleCount; ++i) {
+                    auto u = reinterpret_cast<const unsigned char *>(in + 3 * i);
+                    auto v = static_cast<std::int32_t>(static_cast<std::uint32_t>(u[0]) << 8 |
+                                                       static_cast<std::uint32_t>(u[1]) << 16 |
+                                                       static_cast<std::uint32_t>(u[2]) << 24) >> 8;
+                    out[i] = static_cast<float>(v) / 8388608.0f;
+                }
+                break;
+            case SampleFormat::S32LE:
+                dsp::s32ToFloat(in, out, sampleCount);
+                break;
+            case SampleFormat::F32LE:
+                for (std::size_t i = 0; i < sampleCount; ++i) {
+                    auto bits = readLe32(in + 4 * i);
+                    std::memcpy(out + i, &bits, sizeof(float));
+                }
+                break;
+        }
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + static_cast<std::ptrdiff_t>(frameCount * bytesPerFrame));
+    }
+
+}  // namespace some::cli
@@ -0,0 +1,66 @@
+#ifndef SOME_GUI_PCMDECODER_H
+#define SOME_GUI_PCMDECODER_H
+
+#include <cstddef>
+#include <vector>
+
+#include <QString>
+
+namespace some::cli {
+
+    enum class SampleFormat {
+        S16LE,
+        S24LE,
+        S32LE,
+        F32LE,
+    };
+
+    struct PcmFormat {
+        SampleFormat sampleFormat = SampleFormat::S16LE;
+        int sampleRate = 44100;
+        int channels = 1;
+
+        int bytesPerSample() const;
+        int bytesPerFrame() const;
+    };
+
+    bool parseSampleFormat(const QString &name, SampleFormat &format);
+
+    // Turns a byte stream of PCM into interleaved float frames, block by block.
+    // If the stream starts with a RIFF/WAVE header, the format is taken from it; otherwise the bytes
+    // are raw samples in the fallback format. Partial frames are carried over to the next block.
+    // The WAV data chunk size is ignored, so headers written for unknown lengths work too.
+    class PcmDecoder {
+    public:
+        explicit PcmDecoder(const PcmFormat &rawFormat, bool detectWav = true);
+
+        // Appends decoded frames to `frames`. Returns false if the header is invalid.
+        bool feed(const char *data, std::size_t size, std::vector<float> &frames);
+
+        // True once the format is known.
+        bool isReady() const;
+        const PcmFormat &format() const;
+        QString errorString() const;
+
+    private:
+        enum class State {
+            Detect,
+            Header,
+            Data,
+            Error,
+        };
+
+        bool parseHeader();
+        void decode(std::vector<float> &frames);
+
+        PcmFormat m_format;
+        State m_state;
+        std::vector<char> m_buffer;
+        std::size_t m_headerPos = 0;
+        bool m_hasFormat = false;
+        QString m_error;
+    };  // class PcmDecoder
+
+}  // namespace some::cli
+
+#endif //SOME_GUI_PCMDECODER_H
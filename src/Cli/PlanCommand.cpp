@@ -0,0 +1,29 @@
+#include <cstdio>
+
+#include <QCommandLineParser>
+
+#include "Pipeline/ThreadPlanner.h"
+#include "Commands.h"
+#include "ThreadOptions.h"
+
+namespace some::cli {
+
+    int runPlanCommand(const QStringList &arguments) {
+        QCommandLineParser parser;
+        parser.setApplicationDescription(
+                "Show the CPU topology of this machine and how the thread planner divides it\n"
+                "between ONNX Runtime sessions and the pipeline stages.");
+        parser.addHelpOption();
+        QCommandLineOption sessionsOption({"j", "sessions"}, "Sessions running at the same time.", "count", "1");
+        parser.addOption(sessionsOption);
+        ThreadOptions threadOptions;
+        threadOptions.addTo(parser);
+        parser.process(arguments);
+
+        auto options = threadOptions.planOptions(parser);
+        options.sessions = parser.value(sessionsOption).toInt();
+        std::printf("%s\n", ThreadPlanner().plan(options).describe().c_str());
+        return 0;
+    }
+
+}  // namespace some::cli
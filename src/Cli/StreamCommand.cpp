@@ -0,0 +1,421 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#ifndef NOMINMAX
+#define NOMINMAX  // std::min and std::max are used below
+#endif
+#include <windows.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+#include <QCommandLineParser>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "Dsp/Kernels.h"
+#include "Pipeline/StreamResampler.h"
+#include "Pipeline/StreamingSlicer.h"
+#include "BackendOptions.h"
+#include "Commands.h"
+#include "PcmDecoder.h"
+
+namespace some::cli {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        struct InputBlock {
+            std::vector<char> data;
+            Clock::time_point arrival;
+            bool eof = false;
+        };
+
+        // Blocks read ahead of the slicer; 4 MiB of input at 64 KiB per block.
+        constexpr std::size_t kQueueBlocks = 64;
+        // How often a reader waiting for input checks whether it was stopped.
+        constexpr int kReaderPollMs = 100;
+
+        class BlockQueue {
+        public:
+            explicit BlockQueue(std::size_t capacity) : m_capacity(capacity) {}
+
+            // Waits while the queue is full, so a producer that outruns inference is held back by
+            // the pipe instead of filling memory. Returns false once the queue is closed.
+            bool push(InputBlock block) {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_notFull.wait(lock, [this]() { return m_closed || m_blocks.size() < m_capacity; });
+                    if (m_closed) {
+                        return false;
+                    }
+                    m_blocks.push_back(std::move(block));
+                }
+                m_notEmpty.notify_one();
+                return true;
+            }
+
+            InputBlock pop() {
+                InputBlock block;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_notEmpty.wait(lock, [this]() { return !m_blocks.empty(); });
+                    block = std::move(m_blocks.front());
+                    m_blocks.pop_front();
+                }
+                m_notFull.notify_one();
+                return block;
+            }
+
+            // Stops the reader: a waiting push() returns false, and so does every later one.
+            void close() {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_closed = true;
+                }
+                m_notFull.notify_all();
+            }
+
+            bool isClosed() const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_closed;
+            }
+
+        private:
+            std::size_t m_capacity;
+            mutable std::mutex m_mutex;
+            std::condition_variable m_notEmpty;
+            std::condition_variable m_notFull;
+            std::deque<InputBlock> m_blocks;
+            bool m_closed = false;
+        };
+
+        // Reads stdin on its own thread and stamps every block with its arrival time, so a producer
+        // writing into the pipe is not blocked while a chunk is being inferred, up to the capacity
+        // of the queue. Returns at the end of the input or once the queue is closed.
+        void readStdin(const std::shared_ptr<BlockQueue> &queue, std::size_t blockBytes) {
+#ifdef _WIN32
+            _setmode(_fileno(stdin), _O_BINARY);
+#endif
+            for (;;) {
+                if (queue->isClosed()) {
+                    return;
+                }
+#ifndef _WIN32
+                // Waits with a timeout, so a closed queue is noticed without any input arriving.
+                pollfd input {STDIN_FILENO, POLLIN, 0};
+                auto ready = ::poll(&input, 1, kReaderPollMs);
+                if (ready == 0 || (ready < 0 && errno == EINTR)) {
+                    continue;
+                }
+#endif
+                InputBlock block;
+                block.data.resize(blockBytes);
+#ifdef _WIN32
+                auto n = _read(0, block.data.data(), static_cast<unsigned int>(blockBytes));
+#else
+                auto n = ::read(STDIN_FILENO, block.data.data(), blockBytes);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+#endif
+                block.arrival = Clock::now();
+                if (n <= 0) {
+                    block.data.clear();
+                    block.eof = true;
+                    queue->push(std::move(block));
+                    return;
+                }
+                block.data.resize(static_cast<std::size_t>(n));
+                if (!queue->push(std::move(block))) {
+                    return;
+                }
+            }
+        }
+
+        // Closes the queue and joins the reader, which may be waiting for input.
+        void stopReader(BlockQueue &queue, std::thread &reader) {
+            queue.close();
+#if defined(_WIN32) && defined(_MSC_VER)
+            // A blocking read of a pipe or console is cancelled; repeated in case the reader had not
+            // started it yet.
+            auto handle = static_cast<HANDLE>(reader.native_handle());
+            do {
+                CancelSynchronousIo(handle);
+            } while (WaitForSingleObject(handle, kReaderPollMs) == WAIT_TIMEOUT);
+#endif
+            reader.join();
+        }
+
+        void writeEvent(const QJsonObject &event) {
+            auto line = QJsonDocument(event).toJson(QJsonDocument::Compact);
+            line += '\n';
+            std::fwrite(line.constData(), 1, static_cast<std::size_t>(line.size()), stdout);
+            std::fflush(stdout);
+        }
+
+        double percentile(std::vector<double> values, double p) {
+            if (values.empty()) {
+                return 0;
+            }
+            std::sort(values.begin(), values.end());
+            auto rank = static_cast<std::size_t>(std::ceil(p * values.size()));
+            return values[std::clamp<std::size_t>(rank, 1, values.size()) - 1];
+        }
+
+        double milliseconds(Clock::duration duration) {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+    }
+
+    int runStreamCommand(const QStringList &arguments) {
+        QCommandLineParser parser;
+        parser.setApplicationDescription(
+                "Read PCM audio from stdin, slice it as it arrives and write notes as NDJSON to stdout.\n"
+                "WAV input is detected from its header; anything else is raw PCM in the given format.\n"
+                "A latency report is written to stderr at the end of the stream.");
+        parser.addHelpOption();
+        BackendOptions backendOptions;
+        backendOptions.addTo(parser);
+        PreprocessOptions defaults;
+        QCommandLineOption formatOption("format", "Raw sample format: s16le, s24le, s32le or f32le.", "format",
+                                        "s16le");
+        QCommandLineOption rateOption("rate", "Raw sample rate in Hz.", "Hz", "44100");
+        QCommandLineOption channelsOption("channels", "Raw channel count.", "count", "1");
+        QCommandLineOption rawOption("raw", "Treat the input as raw PCM even if it starts with a WAV header.");
+        QCommandLineOption maxChunkOption("max-chunk", "Cut a chunk after this many seconds without a silence.",
+                                          "seconds", "15");
+        QCommandLineOption thresholdOption("threshold", "Slicer silence threshold in dB.", "dB",
+                                           QString::number(defaults.slicerThreshold));
+        QCommandLineOption minLengthOption("min-length", "Slicer minimum chunk length in ms.", "ms",
+                                           QString::number(defaults.slicerMinLength));
+        QCommandLineOption minIntervalOption("min-interval", "Slicer minimum silence length in ms.", "ms",
+                                             QString::number(defaults.slicerMinInterval));
+        QCommandLineOption maxSilKeptOption("max-sil-kept", "Slicer maximum silence kept around a chunk in ms.",
+                                            "ms", QString::number(defaults.slicerMaxSilKept));
+        parser.addOptions({formatOption, rateOption, channelsOption, rawOption, maxChunkOption,
+                           thresholdOption, minLengthOption, minIntervalOption, maxSilKeptOption});
+        parser.process(arguments);
+
+        PcmFormat rawFormat;
+        if (!parseSampleFormat(parser.value(formatOption), rawFormat.sampleFormat)) {
+            std::fprintf(stderr, "Unknown sample format: %s\n", qPrintable(parser.value(formatOption)));
+            return 1;
+        }
+        rawFormat.sampleRate = parser.value(rateOption).toInt();
+        rawFormat.channels = parser.value(channelsOption).toInt();
+        if (rawFormat.sampleRate <= 0 || rawFormat.channels <= 0) {
+            std::fprintf(stderr, "Invalid sample rate or channel count.\n");
+            return 1;
+        }
+
+        PreprocessOptions options;
+        options.slicerThreshold = parser.value(thresholdOption).toDouble();
+        options.slicerMinLength = parser.value(minLengthOption).toULongLong();
+        options.slicerMinInterval = parser.value(minIntervalOption).toULongLong();
+        options.slicerMaxSilKept = parser.value(maxSilKeptOption).toULongLong();
+        const double maxChunkSeconds = parser.value(maxChunkOption).toDouble();
+        const int modelRate = Pipeline::kTargetSampleRate;
+        // Checked before anything is read: a slicer that rejects its options never settles a chunk.
+        auto slicer = std::make_unique<StreamingSlicer>(modelRate, options, maxChunkSeconds);
+        if (!slicer->isValid()) {
+            std::fprintf(stderr, "%s\n", qPrintable(slicer->errorString()));
+            return 1;
+        }
+
+        QString error;
+        auto backend = backendOptions.create(parser, error);
+        if (!backend) {
+            std::fprintf(stderr, "%s\n", qPrintable(error));
+            return 1;
+        }
+
+        auto queue = std::make_shared<BlockQueue>(kQueueBlocks);
+        std::thread reader(readStdin, queue, std::size_t(64 * 1024));
+
+        PcmDecoder decoder(rawFormat, !parser.isSet(rawOption));
+        std::unique_ptr<StreamResampler> resampler;
+
+        // Input frame count at the end of every block and when it arrived, to find when the last
+        // sample of a chunk reached us.
+        struct Arrival {
+            std::uint64_t inputEnd;
+            Clock::time_point time;
+        };
+        std::deque<Arrival> arrivals;
+        std::uint64_t inputFrames = 0;
+        const auto streamStart = Clock::now();
+
+        std::size_t chunkCount = 0;
+        std::size_t forcedCount = 0;
+        std::size_t noteCount = 0;
+        double inferenceSeconds = 0;
+        std::vector<double> latencies;
+
+        auto inputFrameOf = [&](std::uint64_t modelFrame) {
+            return (modelFrame * decoder.format().sampleRate + modelRate - 1) / modelRate;
+        };
+        auto arrivalOf = [&](std::uint64_t modelFrame) {
+            auto inputFrame = inputFrameOf(modelFrame);
+            for (const auto &arrival : arrivals) {
+                if (arrival.inputEnd >= inputFrame) {
+                    return arrival.time;
+                }
+            }
+            return arrivals.empty() ? streamStart : arrivals.back().time;
+        };
+
+        auto handleChunks = [&](const std::vector<StreamChunk> &chunks) {
+            for (const auto &chunk : chunks) {
+                auto inferStart = Clock::now();
+                auto notes = backend->infer(chunk.samples, 0, chunk.samples.size());
+                auto emitted = Clock::now();
+                auto latency = milliseconds(emitted - arrivalOf(chunk.end));
+                auto inferMs = milliseconds(emitted - inferStart);
+
+                double onset = static_cast<double>(chunk.begin) / modelRate;
+                double chunkEnd = static_cast<double>(chunk.end) / modelRate;
+                std::size_t chunkNotes = 0;
+                for (std::size_t i = 0; i < notes.note_midi.size() && i < notes.note_dur.size(); ++i) {
+                    double offset = std::min(onset + notes.note_dur[i], chunkEnd);
+                    if (i < notes.note_rest.size() && !notes.note_rest[i] && offset > onset) {
+                        QJsonObject event;
+                        event["event"] = "note";
+                        event["chunk"] = static_cast<qint64>(chunkCount);
+                        event["onset"] = onset;
+                        event["offset"] = offset;
+                        event["pitch"] = notes.note_midi[i];
+                        event["midi"] = static_cast<int>(std::lround(notes.note_midi[i]));
+                        event["latency_ms"] = latency;
+                        writeEvent(event);
+                        ++chunkNotes;
+                    }
+                    onset = offset;
+                }
+
+                QJsonObject event;
+                event["event"] = "chunk";
+                event["index"] = static_cast<qint64>(chunkCount);
+                event["begin"] = static_cast<double>(chunk.begin) / modelRate;
+                event["end"] = chunkEnd;
+                event["notes"] = static_cast<qint64>(chunkNotes);
+                event["forced"] = chunk.forced;
+                event["inference_ms"] = inferMs;
+                event["latency_ms"] = latency;
+                writeEvent(event);
+
+                ++chunkCount;
+                forcedCount += chunk.forced ? 1 : 0;
+                noteCount += chunkNotes;
+                inferenceSeconds += inferMs / 1000.0;
+                latencies.push_back(latency);
+            }
+            // Arrivals before the pending window are no longer needed.
+            auto pendingInput = inputFrameOf(slicer->pendingBegin());
+            while (arrivals.size() > 1 && arrivals.front().inputEnd < pendingInput) {
+                arrivals.pop_front();
+            }
+        };
+
+        std::vector<float> interleaved;
+        std::vector<float> mono;
+        std::vector<float> resampled;
+        for (;;) {
+            auto block = queue->pop();
+            if (block.eof) {
+                break;
+            }
+            interleaved.clear();
+            if (!decoder.feed(block.data.data(), block.data.size(), interleaved)) {
+                std::fprintf(stderr, "%s\n", qPrintable(decoder.errorString()));
+                stopReader(*queue, reader);
+                return 1;
+            }
+            if (!decoder.isReady()) {
+                continue;
+            }
+            const auto &format = decoder.format();
+            if (!resampler) {
+                resampler = std::make_unique<StreamResampler>(format.sampleRate, modelRate);
+                if (!resampler->isValid()) {
+                    std::fprintf(stderr, "%s\n", qPrintable(resampler->errorString()));
+                    stopReader(*queue, reader);
+                    return 1;
+                }
+                QJsonObject event;
+                event["event"] = "start";
+                event["sample_rate"] = format.sampleRate;
+                event["channels"] = format.channels;
+                event["model_sample_rate"] = modelRate;
+                writeEvent(event);
+            }
+
+            auto frames = interleaved.size() / format.channels;
+            if (frames == 0) {
+                continue;
+            }
+            inputFrames += frames;
+            arrivals.push_back({inputFrames, block.arrival});
+
+            mono.resize(frames);
+            dsp::downmix(interleaved.data(), mono.data(), frames, format.channels);
+            resampled.clear();
+            if (!resampler->process(mono.data(), mono.size(), resampled)) {
+                std::fprintf(stderr, "%s\n", qPrintable(resampler->errorString()));
+                stopReader(*queue, reader);
+                return 1;
+            }
+            handleChunks(slicer->push(resampled.data(), resampled.size()));
+        }
+        reader.join();
+
+        if (resampler) {
+            resampled.clear();
+            if (!resampler->flush(resampled)) {
+                std::fprintf(stderr, "%s\n", qPrintable(resampler->errorString()));
+                return 1;
+            }
+            handleChunks(slicer->push(resampled.data(), resampled.size()));
+            handleChunks(slicer->finish());
+        }
+
+        double audioSeconds = decoder.isReady() ? static_cast<double>(inputFrames) / decoder.format().sampleRate : 0;
+        double p50 = percentile(latencies, 0.50);
+        double p95 = percentile(latencies, 0.95);
+        double max = latencies.empty() ? 0 : *std::max_element(latencies.begin(), latencies.end());
+
+        QJsonObject latencyObject;
+        latencyObject["p50"] = p50;
+        latencyObject["p95"] = p95;
+        latencyObject["max"] = max;
+        QJsonObject event;
+        event["event"] = "end";
+        event["audio_seconds"] = audioSeconds;
+        event["chunks"] = static_cast<qint64>(chunkCount);
+        event["notes"] = static_cast<qint64>(noteCount);
+        event["latency_ms"] = latencyObject;
+        writeEvent(event);
+
+        std::fprintf(stderr, "Stream: %.2f s of audio, %zu chunks (%zu cut at --max-chunk), %zu notes\n",
+                     audioSeconds, chunkCount, forcedCount, noteCount);
+        std::fprintf(stderr, "Latency from audio arrival to note emission: p50 %.0f ms, p95 %.0f ms, max %.0f ms\n",
+                     p50, p95, max);
+        std::fprintf(stderr, "Inference: %.3f s total, RTF %.4f\n",
+                     inferenceSeconds, audioSeconds > 0 ? inferenceSeconds / audioSeconds : 0.0);
+        return 0;
+    }
+
+}  // namespace some::cli
@@ -0,0 +1,18 @@
+#include "ThreadOptions.h"
+
+namespace some::cli {
+
+    void ThreadOptions::addTo(QCommandLineParser &parser) const {
+        parser.addOptions({pipelineThreads, smt, globalPools, pin});
+    }
+
+    ThreadPlanOptions ThreadOptions::planOptions(const QCommandLineParser &parser) const {
+        ThreadPlanOptions options;
+        options.pipelineThreads = parser.value(pipelineThreads).toInt();
+        options.useSmt = parser.isSet(smt);
+        options.globalThreadPools = parser.isSet(globalPools);
+        options.pinThreads = parser.isSet(pin);
+        return options;
+    }
+
+}  // namespace some::cli
@@ -0,0 +1,26 @@
+#ifndef SOME_GUI_THREADOPTIONS_H
+#define SOME_GUI_THREADOPTIONS_H
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+
+#include "Pipeline/ThreadPlanner.h"
+
+namespace some::cli {
+
+    // Command line options of the thread planner, shared by the some-cli commands.
+    struct ThreadOptions {
+        QCommandLineOption pipelineThreads{"pipeline-threads", "Threads kept free for decoding and MIDI writing.",
+                                           "count", "1"};
+        QCommandLineOption smt{"smt", "Give sessions both hyper-threads of a core."};
+        QCommandLineOption globalPools{"global-pools", "One intra-op thread pool shared by all sessions."};
+        QCommandLineOption pin{"pin", "Pin session threads to the CPUs of the plan."};
+
+        void addTo(QCommandLineParser &parser) const;
+
+        ThreadPlanOptions planOptions(const QCommandLineParser &parser) const;
+    };
+
+}  // namespace some::cli
+
+#endif //SOME_GUI_THREADOPTIONS_H
@@ -0,0 +1,270 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+
+#include "Pipeline/Pipeline.h"
+#include "BackendOptions.h"
+#include "Commands.h"
+#include "FolderWatcher.h"
+
+namespace some::cli {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        void writeEvent(const QJsonObject &event) {
+            auto line = QJsonDocument(event).toJson(QJsonDocument::Compact);
+            line += '\n';
+            std::fwrite(line.constData(), 1, static_cast<std::size_t>(line.size()), stdout);
+            std::fflush(stdout);
+        }
+
+        QByteArray fileHash(const QString &path) {
+            QFile file(path);
+            QCryptographicHash hash(QCryptographicHash::Sha1);
+            if (!file.open(QIODevice::ReadOnly) || !hash.addData(&file)) {
+                return {};
+            }
+            return hash.result();
+        }
+
+        // Runs the pipeline for queued files on a fixed number of threads, one inference backend each.
+        // A path is queued once until it is done, and content that was already converted during this
+        // run (the same recording saved under another name, or saved again unchanged) is skipped.
+        class IngestQueue {
+        public:
+            IngestQueue(QDir root, QString outRoot, double tempo, bool verbose)
+                    : m_root(std::move(root)), m_outRoot(std::move(outRoot)), m_tempo(tempo), m_verbose(verbose) {}
+
+            ~IngestQueue() {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stopping = true;
+                }
+                m_cv.notify_all();
+                for (auto &thread : m_threads) {
+                    thread.join();
+                }
+            }
+
+            void start(std::vector<std::unique_ptr<InferenceBackend>> backends) {
+                m_backends = std::move(backends);
+                for (auto &backend : m_backends) {
+                    m_threads.emplace_back([this, backend = backend.get()]() {
+                        work(*backend);
+                    });
+                }
+            }
+
+            void push(const QString &path) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (m_pending.contains(path)) {
+                        return;
+                    }
+                    m_pending.insert(path);
+                    m_queue.push_back({path, Clock::now()});
+                }
+                m_cv.notify_one();
+            }
+
+            QString outputPath(const QString &audioPath) const {
+                QFileInfo info(audioPath);
+                auto name = info.completeBaseName() + ".mid";
+                if (m_outRoot.isEmpty()) {
+                    return info.dir().filePath(name);
+                }
+                auto relativeDir = m_root.relativeFilePath(info.absolutePath());
+                return QDir::cleanPath(QDir(m_outRoot).filePath(relativeDir) + '/' + name);
+            }
+
+        private:
+            struct Item {
+                QString path;
+                Clock::time_point queued;
+            };
+
+            void work(InferenceBackend &backend) {
+                for (;;) {
+                    Item item;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_cv.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+                        if (m_stopping) {
+                            return;
+                        }
+                        item = std::move(m_queue.front());
+                        m_queue.pop_front();
+                    }
+                    process(backend, item);
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_pending.remove(item.path);
+                }
+            }
+
+            void process(InferenceBackend &backend, const Item &item) {
+                auto start = Clock::now();
+                QJsonObject event;
+                event["audio"] = item.path;
+                auto skip = [&event](const QString &reason) {
+                    event["event"] = "skip";
+                    event["reason"] = reason;
+                    writeEvent(event);
+                };
+
+                auto outPath = outputPath(item.path);
+                QFileInfo outInfo(outPath);
+                if (outInfo.exists() && outInfo.lastModified() >= QFileInfo(item.path).lastModified()) {
+                    skip("up to date");
+                    return;
+                }
+                auto hash = fileHash(item.path);
+                if (hash.isEmpty()) {
+                    skip("unreadable");
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto it = m_converted.constFind(hash);
+                    if (it != m_converted.constEnd()) {
+                        event["same_as"] = *it;
+                        skip("duplicate");
+                        return;
+                    }
+                    m_converted.insert(hash, item.path);
+                }
+
+                bool ok = QDir().mkpath(outInfo.absolutePath());
+                Pipeline pipeline;
+                QObject::connect(&pipeline, &Pipeline::logMsgError, [&item](const QString &msg) {
+                    std::fprintf(stderr, "%s: %s\n", qPrintable(item.path), qPrintable(msg));
+                });
+                if (m_verbose) {
+                    QObject::connect(&pipeline, &Pipeline::logMsgInfo, [&item](const QString &msg) {
+                        std::fprintf(stderr, "%s: %s\n", qPrintable(item.path), qPrintable(msg));
+                    });
+                }
+                ok = ok && pipeline.run(backend, item.path, outPath, m_tempo);
+                if (!ok) {
+                    // Let a later, complete copy of the same content through.
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_converted.remove(hash);
+                }
+                const auto &stats = pipeline.stats();
+                event["event"] = ok ? "done" : "failed";
+                event["midi"] = outPath;
+                event["audio_s"] = stats.audioSeconds;
+                event["queued_s"] = std::chrono::duration<double>(start - item.queued).count();
+                event["seconds"] = std::chrono::duration<double>(Clock::now() - start).count();
+                event["notes"] = static_cast<qint64>(stats.noteCount);
+                writeEvent(event);
+            }
+
+            QDir m_root;
+            QString m_outRoot;
+            double m_tempo;
+            bool m_verbose;
+            std::vector<std::unique_ptr<InferenceBackend>> m_backends;
+            std::vector<std::thread> m_threads;
+
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::deque<Item> m_queue;
+            QSet<QString> m_pending;                  // queued or running
+            QHash<QByteArray, QString> m_converted;   // content hash -> first path
+            bool m_stopping = false;
+        };
+    }
+
+    int runWatchCommand(const QStringList &arguments) {
+        QCommandLineParser parser;
+        parser.setApplicationDescription(
+                "Watch a directory tree and convert every audio file written into it to MIDI.\n"
+                "A file is picked up once it has been closed and left unchanged for the debounce interval.\n"
+                "The MIDI file is written next to the audio, or at the same relative path under --out-dir.\n"
+                "One JSON object per file is written to stdout.");
+        parser.addHelpOption();
+        parser.addPositionalArgument("dir", "Directory to watch.", "<dir>");
+        BackendOptions backendOptions;
+        backendOptions.addTo(parser);
+        QCommandLineOption outDirOption({"o", "out-dir"}, "Mirror the watched tree here instead of writing beside "
+                                                          "the audio.", "dir");
+        QCommandLineOption jobsOption({"j", "jobs"}, "Files converted at the same time, one session each.", "count",
+                                      "1");
+        QCommandLineOption debounceOption("debounce", "Quiet time before a written file is picked up.", "ms",
+                                          "1000");
+        QCommandLineOption filterOption("filter", "File name patterns to pick up, separated by ';'.", "patterns",
+                                        "*.wav;*.flac;*.ogg;*.aif;*.aiff");
+        QCommandLineOption existingOption("existing", "Also convert files already in the tree.");
+        QCommandLineOption tempoOption("tempo", "MIDI tempo.", "bpm", "120");
+        QCommandLineOption verboseOption({"v", "verbose"}, "Log every pipeline stage.");
+        parser.addOptions({outDirOption, jobsOption, debounceOption, filterOption, existingOption, tempoOption,
+                           verboseOption});
+        parser.process(arguments);
+
+        if (parser.positionalArguments().size() != 1) {
+            parser.showHelp(1);
+        }
+        QDir root(parser.positionalArguments().first());
+        root.makeAbsolute();
+        QString outRoot;
+        if (parser.isSet(outDirOption)) {
+            outRoot = QDir(parser.value(outDirOption)).absolutePath();
+            if (!QDir().mkpath(outRoot)) {
+                std::fprintf(stderr, "Can't create %s\n", qPrintable(outRoot));
+                return 1;
+            }
+        }
+
+        auto jobs = std::max(1, parser.value(jobsOption).toInt());
+        std::vector<std::unique_ptr<InferenceBackend>> backends;
+        for (int i = 0; i < jobs; ++i) {
+            QString error;
+            auto backend = backendOptions.create(parser, error);
+            if (!backend) {
+                std::fprintf(stderr, "%s\n", qPrintable(error));
+                return 1;
+            }
+            backends.push_back(std::move(backend));
+        }
+
+        IngestQueue queue(root, outRoot, parser.value(tempoOption).toDouble(), parser.isSet(verboseOption));
+        queue.start(std::move(backends));
+
+        auto patterns = parser.value(filterOption).split(';');
+        patterns.removeAll(QString());
+        FolderWatcher watcher(root.path(), patterns, parser.value(debounceOption).toInt());
+        QObject::connect(&watcher, &FolderWatcher::fileReady, [&queue](const QString &path) {
+            queue.push(path);
+        });
+        QString error;
+        if (!watcher.start(&error)) {
+            std::fprintf(stderr, "%s\n", qPrintable(error));
+            return 1;
+        }
+        std::fprintf(stderr, "Watching %d directories under %s with %s, %d job(s).\n",
+                     watcher.watchedDirectories(), qPrintable(root.path()),
+                     watcher.usesInotify() ? "inotify" : "QFileSystemWatcher", jobs);
+        if (parser.isSet(existingOption)) {
+            watcher.addExisting();
+        }
+        return QCoreApplication::exec();
+    }
+
+}  // namespace some::cli
@@ -0,0 +1,56 @@
+#include <cstdio>
+#include <cstring>
+
+#include <QCoreApplication>
+#include <QStringList>
+
+#include "Commands.h"
+
+using namespace some::cli;
+
+namespace {
+    struct Command {
+        const char *name;
+        const char *description;
+        int (*run)(const QStringList &arguments);
+    };
+
+    const Command kCommands[] = {
+            {"stream", "Read PCM from stdin and write notes as NDJSON while the audio arrives", runStreamCommand},
+            {"inspect", "Show the interface of ONNX models and check them without loading them", runInspectCommand},
+            {"compare", "Run several models over one preprocessing pass and compare their timings", runCompareCommand},
+            {"plan", "Show the CPU topology and how threads would be assigned to sessions", runPlanCommand},
+            {"watch", "Convert audio files to MIDI as they are written into a directory", runWatchCommand},
+    };
+
+    void printUsage() {
+        std::fprintf(stderr, "Usage: some-cli <command> [options]\n\nCommands:\n");
+        for (const auto &command : kCommands) {
+            std::fprintf(stderr, "  %-10s %s\n", command.name, command.description);
+        }
+        std::fprintf(stderr, "\nRun 'some-cli <command> --help' for the options of a command.\n");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("some-cli");
+
+    auto arguments = QCoreApplication::arguments();
+    if (arguments.size() < 2) {
+        printUsage();
+        return 1;
+    }
+    for (const auto &command : kCommands) {
+        if (arguments[1] == command.name) {
+            // The command's parser sees "some-cli <command>" as the program name.
+            arguments[0] += ' ' + arguments.takeAt(1);
+            return command.run(arguments);
+        }
+    }
+    if (arguments[1] != "-h" && arguments[1] != "--help") {
+        std::fprintf(stderr, "Unknown command: %s\n\n", qPrintable(arguments[1]));
+    }
+    printUsage();
+    return 1;
+}
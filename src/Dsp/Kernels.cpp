@@ -0,0 +1,152 @@
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+# include <intrin.h>
+# include <immintrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+# include <cpuid.h>
+#endif
+
+#include "Kernels.h"
+#include "KernelsImpl.h"
+
+namespace some::dsp {
+
+    namespace {
+        struct CpuFeatures {
+            bool avx2 = false;
+            bool avx512 = false;
+        };
+
+        CpuFeatures detectCpuFeatures() {
+            CpuFeatures features;
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+            unsigned int leaf1[4] = {}, leaf7[4] = {};
+# if defined(_MSC_VER)
+            int regs[4];
+            __cpuid(regs, 0);
+            int maxLeaf = regs[0];
+            __cpuidex(regs, 1, 0);
+            for (int i = 0; i < 4; ++i) {
+                leaf1[i] = static_cast<unsigned int>(regs[i]);
+            }
+            if (maxLeaf >= 7) {
+                __cpuidex(regs, 7, 0);
+                for (int i = 0; i < 4; ++i) {
+                    leaf7[i] = static_cast<unsigned int>(regs[i]);
+                }
+            }
+# else
+            __get_cpuid(1, &leaf1[0], &leaf1[1], &leaf1[2], &leaf1[3]);
+            __get_cpuid_count(7, 0, &leaf7[0], &leaf7[1], &leaf7[2], &leaf7[3]);
+# endif
+            // The CPU having the instructions is not enough: the OS must save the wider
+            // registers on context switches (XCR0), which it only does if it knows them.
+            bool osxsave = (leaf1[2] & (1u << 27)) != 0;
+            bool avx = (leaf1[2] & (1u << 28)) != 0;
+            if (!osxsave || !avx) {
+                return features;
+            }
+# if defined(_MSC_VER)
+            auto xcr0 = static_cast<unsigned long long>(_xgetbv(0));
+# else
+            unsigned int xcr0Low, xcr0High;
+            __asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+            auto xcr0 = static_cast<unsigned long long>(xcr0High) << 32 | xcr0Low;
+# endif
+            bool ymmState = (xcr0 & 0x6) == 0x6;     // SSE and AVX state
+            bool zmmState = (xcr0 & 0xe6) == 0xe6;   // plus opmask and the upper ZMM registers
+            features.avx2 = ymmState && (leaf7[1] & (1u << 5)) != 0;
+            features.avx512 = features.avx2 && zmmState && (leaf7[1] & (1u << 16)) != 0;  // AVX-512F
+#endif
+            return features;
+        }
+
+        const KernelTable *table(Isa isa) {
+            switch (isa) {
+                case Isa::Scalar:
+                    return detail::scalarKernels();
+                case Isa::Avx2:
+                    return detail::avx2Kernels();
+                case Isa::Avx512:
+                    return detail::avx512Kernels();
+                case Isa::Neon:
+                    return detail::neonKernels();
+            }
+            return nullptr;
+        }
+
+        bool cpuSupports(Isa isa) {
+            static const auto features = detectCpuFeatures();
+            switch (isa) {
+                case Isa::Avx2:
+                    return features.avx2;
+                case Isa::Avx512:
+                    return features.avx512;
+                default:
+                    return true;  // scalar; NEON is part of AArch64
+            }
+        }
+
+        const KernelTable *selectKernels() {
+            auto isas = supportedIsas();
+            if (auto name = std::getenv("SOME_DSP_ISA")) {
+                for (auto isa : isas) {
+                    if (std::strcmp(name, isaName(isa)) == 0) {
+                        return table(isa);
+                    }
+                }
+            }
+            return table(isas.back());
+        }
+
+        std::atomic<const KernelTable *> &activeKernels() {
+            static std::atomic<const KernelTable *> active {selectKernels()};
+            return active;
+        }
+    }
+
+    const char *isaName(Isa isa) {
+        switch (isa) {
+            case Isa::Scalar:
+                return "scalar";
+            case Isa::Avx2:
+                return "avx2";
+            case Isa::Avx512:
+                return "avx512";
+            case Isa::Neon:
+                return "neon";
+        }
+        return "unknown";
+    }
+
+    std::vector<Isa> supportedIsas() {
+        std::vector<Isa> isas;
+        for (auto isa : {Isa::Scalar, Isa::Neon, Isa::Avx2, Isa::Avx512}) {
+            if (table(isa) && cpuSupports(isa)) {
+                isas.push_back(isa);
+            }
+        }
+        return isas;
+    }
+
+    const KernelTable *kernels(Isa isa) {
+        return cpuSupports(isa) ? table(isa) : nullptr;
+    }
+
+    const KernelTable &kernels() {
+        return *activeKernels().load(std::memory_order_relaxed);
+    }
+
+    bool setActiveIsa(Isa isa) {
+        auto selected = kernels(isa);
+        if (!selected) {
+            return false;
+        }
+        activeKernels().store(selected, std::memory_order_relaxed);
+        return true;
+    }
+
+}  // namespace some::dsp
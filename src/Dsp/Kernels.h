@@ -0,0 +1,63 @@
+#ifndef SOME_GUI_KERNELS_H
+#define SOME_GUI_KERNELS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace some::dsp {
+
+    // Instruction sets the kernels are built for. The best one the CPU supports is chosen at
+    // startup; SOME_DSP_ISA=scalar|avx2|avx512|neon in the environment overrides the choice.
+    enum class Isa {
+        Scalar,
+        Avx2,
+        Avx512,
+        Neon,
+    };  // enum class Isa
+
+    // Every implementation gives bit-identical results to the scalar one: the same operations in
+    // the same order per sample, only several samples at a time.
+    struct KernelTable {
+        Isa isa;
+        // Mean of `channels` interleaved channels per frame. `out` may be `in` (in-place downmix).
+        void (*downmix)(const float *in, float *out, std::size_t frames, int channels);
+        // Sum of in[i]^2 in double precision. The squares go to 8 partial sums by i % 8, added up
+        // as ((s0 + s1) + (s2 + s3)) + ((s4 + s5) + (s6 + s7)), so every instruction set gets the
+        // same bits; the result differs slightly from a plain running sum.
+        double (*sumOfSquares)(const float *in, std::size_t count);
+        // Little-endian signed 16 / 32 bit PCM to float in [-1, 1). `in` needs no alignment.
+        void (*s16ToFloat)(const void *in, float *out, std::size_t count);
+        void (*s32ToFloat)(const void *in, float *out, std::size_t count);
+    };
+
+    const char *isaName(Isa isa);
+    // Instruction sets this build has kernels for and this CPU can run, scalar first.
+    std::vector<Isa> supportedIsas();
+    // Kernels for `isa`, or nullptr if they are not supported here.
+    const KernelTable *kernels(Isa isa);
+
+    // The kernels in use.
+    const KernelTable &kernels();
+    // Switches the kernels in use, e.g. to compare them in a benchmark. Returns false if `isa` is
+    // not supported.
+    bool setActiveIsa(Isa isa);
+
+    inline void downmix(const float *in, float *out, std::size_t frames, int channels) {
+        kernels().downmix(in, out, frames, channels);
+    }
+
+    inline double sumOfSquares(const float *in, std::size_t count) {
+        return kernels().sumOfSquares(in, count);
+    }
+
+    inline void s16ToFloat(const void *in, float *out, std::size_t count) {
+        kernels().s16ToFloat(in, out, count);
+    }
+
+    inline void s32ToFloat(const void *in, float *out, std::size_t count) {
+        kernels().s32ToFloat(in, out, count);
+    }
+
+}  // namespace some::dsp
+
+#endif //SOME_GUI_KERNELS_H
@@ -0,0 +1,119 @@
+#include <cstdint>
+
+#include "KernelsImpl.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+# define SOME_DSP_HAVE_AVX2
+# include <immintrin.h>
+#endif
+
+namespace some::dsp::detail {
+
+#ifdef SOME_DSP_HAVE_AVX2
+    namespace {
+        // x / c, as a multiplication when that is exact.
+        __m256 divide(__m256 x, __m256 divisor, __m256 reciprocal, bool exactReciprocal) {
+            return exactReciprocal ? _mm256_mul_ps(x, reciprocal) : _mm256_div_ps(x, divisor);
+        }
+
+        void downmix(const float *in, float *out, std::size_t frames, int channels) {
+            const bool exactReciprocal = (channels & (channels - 1)) == 0;
+            const __m256 divisor = _mm256_set1_ps(static_cast<float>(channels));
+            const __m256 reciprocal = _mm256_set1_ps(1.0f / static_cast<float>(channels));
+            std::size_t i = 0;
+            // All loads of an iteration come before its store, so `out` may be `in`.
+            if (channels == 2) {
+                for (; i + 8 <= frames; i += 8) {
+                    __m256 a = _mm256_loadu_ps(in + 2 * i);      // l0 r0 l1 r1 l2 r2 l3 r3
+                    __m256 b = _mm256_loadu_ps(in + 2 * i + 8);  // l4 r4 ... l7 r7
+                    // Within 128-bit lanes: l0 l1 l4 l5 | l2 l3 l6 l7, then restore the order.
+                    __m256 left = _mm256_castpd_ps(_mm256_permute4x64_pd(
+                            _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))),
+                            _MM_SHUFFLE(3, 1, 2, 0)));
+                    __m256 right = _mm256_castpd_ps(_mm256_permute4x64_pd(
+                            _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))),
+                            _MM_SHUFFLE(3, 1, 2, 0)));
+                    __m256 s = _mm256_add_ps(_mm256_setzero_ps(), divide(left, divisor, reciprocal, exactReciprocal));
+                    s = _mm256_add_ps(s, divide(right, divisor, reciprocal, exactReciprocal));
+                    _mm256_storeu_ps(out + i, s);
+                }
+            }
+            else if (channels > 2) {
+                const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                         _mm256_set1_epi32(channels));
+                for (; i + 8 <= frames; i += 8) {
+                    const float *frame = in + i * channels;
+                    __m256 s = _mm256_setzero_ps();
+                    for (int j = 0; j < channels; ++j) {
+                        __m256 x = _mm256_i32gather_ps(frame + j, index, 4);
+                        s = _mm256_add_ps(s, divide(x, divisor, reciprocal, exactReciprocal));
+                    }
+                    _mm256_storeu_ps(out + i, s);
+                }
+            }
+            downmixScalar(in + i * channels, out + i, frames - i, channels);
+        }
+
+        double sumOfSquares(const float *in, std::size_t count) {
+            // Lanes of `low` are partial sums 0-3, lanes of `high` 4-7. Squaring a float in double
+            // precision is exact, so there is nothing for a fused multiply-add to change either.
+            __m256d low = _mm256_setzero_pd();
+            __m256d high = _mm256_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m256 x = _mm256_loadu_ps(in + i);
+                __m256d xLow = _mm256_cvtps_pd(_mm256_castps256_ps128(x));
+                __m256d xHigh = _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1));
+                low = _mm256_add_pd(low, _mm256_mul_pd(xLow, xLow));
+                high = _mm256_add_pd(high, _mm256_mul_pd(xHigh, xHigh));
+            }
+            double partial[8];
+            _mm256_storeu_pd(partial, low);
+            _mm256_storeu_pd(partial + 4, high);
+            addSquaresScalar(in + i, count - i, partial);
+            return combinePartialSums(partial);
+        }
+
+        void s16ToFloat(const void *in, float *out, std::size_t count) {
+            auto samples = static_cast<const std::int16_t *>(in);
+            const __m256 scale = _mm256_set1_ps(1.0f / 32768.0f);  // exact: a power of two
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(samples + i));
+                _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v)), scale));
+            }
+            s16ToFloatScalar(samples + i, out + i, count - i);
+        }
+
+        void s32ToFloat(const void *in, float *out, std::size_t count) {
+            auto samples = static_cast<const std::int32_t *>(in);
+            // Rounding to float and then scaling by a power of two equals scaling in double and
+            // rounding, which is what the scalar kernel does.
+            const __m256 scale = _mm256_set1_ps(1.0f / 2147483648.0f);
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(samples + i));
+                _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+            }
+            s32ToFloatScalar(samples + i, out + i, count - i);
+        }
+
+        const KernelTable kTable = {
+                Isa::Avx2,
+                downmix,
+                sumOfSquares,
+                s16ToFloat,
+                s32ToFloat,
+        };
+    }
+
+    const KernelTable *avx2Kernels() {
+        return &kTable;
+    }
+#else
+    const KernelTable *avx2Kernels() {
+        return nullptr;
+    }
+#endif
+
+}  // namespace some::dsp::detail
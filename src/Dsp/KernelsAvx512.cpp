@@ -0,0 +1,111 @@
+#include <cstdint>
+
+#include "KernelsImpl.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+# define SOME_DSP_HAVE_AVX512
+# include <immintrin.h>
+#endif
+
+namespace some::dsp::detail {
+
+#ifdef SOME_DSP_HAVE_AVX512
+    namespace {
+        // x / c, as a multiplication when that is exact.
+        __m512 divide(__m512 x, __m512 divisor, __m512 reciprocal, bool exactReciprocal) {
+            return exactReciprocal ? _mm512_mul_ps(x, reciprocal) : _mm512_div_ps(x, divisor);
+        }
+
+        void downmix(const float *in, float *out, std::size_t frames, int channels) {
+            const bool exactReciprocal = (channels & (channels - 1)) == 0;
+            const __m512 divisor = _mm512_set1_ps(static_cast<float>(channels));
+            const __m512 reciprocal = _mm512_set1_ps(1.0f / static_cast<float>(channels));
+            std::size_t i = 0;
+            // All loads of an iteration come before its store, so `out` may be `in`.
+            if (channels == 2) {
+                const __m512i evens = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14,
+                                                        16, 18, 20, 22, 24, 26, 28, 30);
+                const __m512i odds = _mm512_add_epi32(evens, _mm512_set1_epi32(1));
+                for (; i + 16 <= frames; i += 16) {
+                    __m512 a = _mm512_loadu_ps(in + 2 * i);
+                    __m512 b = _mm512_loadu_ps(in + 2 * i + 16);
+                    __m512 left = _mm512_permutex2var_ps(a, evens, b);
+                    __m512 right = _mm512_permutex2var_ps(a, odds, b);
+                    __m512 s = _mm512_add_ps(_mm512_setzero_ps(), divide(left, divisor, reciprocal, exactReciprocal));
+                    s = _mm512_add_ps(s, divide(right, divisor, reciprocal, exactReciprocal));
+                    _mm512_storeu_ps(out + i, s);
+                }
+            }
+            else if (channels > 2) {
+                const __m512i index = _mm512_mullo_epi32(
+                        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                        _mm512_set1_epi32(channels));
+                for (; i + 16 <= frames; i += 16) {
+                    const float *frame = in + i * channels;
+                    __m512 s = _mm512_setzero_ps();
+                    for (int j = 0; j < channels; ++j) {
+                        __m512 x = _mm512_i32gather_ps(index, frame + j, 4);
+                        s = _mm512_add_ps(s, divide(x, divisor, reciprocal, exactReciprocal));
+                    }
+                    _mm512_storeu_ps(out + i, s);
+                }
+            }
+            downmixScalar(in + i * channels, out + i, frames - i, channels);
+        }
+
+        double sumOfSquares(const float *in, std::size_t count) {
+            // One lane per partial sum; see KernelsAvx2.cpp.
+            __m512d sums = _mm512_setzero_pd();
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m512d x = _mm512_cvtps_pd(_mm256_loadu_ps(in + i));
+                sums = _mm512_add_pd(sums, _mm512_mul_pd(x, x));
+            }
+            double partial[8];
+            _mm512_storeu_pd(partial, sums);
+            addSquaresScalar(in + i, count - i, partial);
+            return combinePartialSums(partial);
+        }
+
+        void s16ToFloat(const void *in, float *out, std::size_t count) {
+            auto samples = static_cast<const std::int16_t *>(in);
+            const __m512 scale = _mm512_set1_ps(1.0f / 32768.0f);  // exact: a power of two
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(samples + i));
+                _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(v)), scale));
+            }
+            s16ToFloatScalar(samples + i, out + i, count - i);
+        }
+
+        void s32ToFloat(const void *in, float *out, std::size_t count) {
+            auto samples = static_cast<const std::int32_t *>(in);
+            // Same as the scalar kernel; see KernelsAvx2.cpp.
+            const __m512 scale = _mm512_set1_ps(1.0f / 2147483648.0f);
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                __m512i v = _mm512_loadu_si512(samples + i);
+                _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_cvtepi32_ps(v), scale));
+            }
+            s32ToFloatScalar(samples + i, out + i, count - i);
+        }
+
+        const KernelTable kTable = {
+                Isa::Avx512,
+                downmix,
+                sumOfSquares,
+                s16ToFloat,
+                s32ToFloat,
+        };
+    }
+
+    const KernelTable *avx512Kernels() {
+        return &kTable;
+    }
+#else
+    const KernelTable *avx512Kernels() {
+        return nullptr;
+    }
+#endif
+
+}  // namespace some::dsp::detail
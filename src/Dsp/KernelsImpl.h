@@ -0,0 +1,30 @@
+#ifndef SOME_GUI_KERNELSIMPL_H
+#define SOME_GUI_KERNELSIMPL_H
+
+#include <cstddef>
+
+#include "Kernels.h"
+
+// Per instruction set kernels. Each KernelsXxx.cpp is compiled with the flags of its instruction
+// set, so it must not instantiate inline library code (std::min, containers, ...): the linker may
+// keep that copy for the whole program, and it would then run on CPUs without the instructions.
+namespace some::dsp::detail {
+
+    // nullptr if the build has no kernels for the instruction set.
+    const KernelTable *scalarKernels();
+    const KernelTable *avx2Kernels();
+    const KernelTable *avx512Kernels();
+    const KernelTable *neonKernels();
+
+    // The scalar kernels, for the tails the vector loops leave.
+    void downmixScalar(const float *in, float *out, std::size_t frames, int channels);
+    // Adds in[i]^2 to partial[i % 8], for the tails of sumOfSquares.
+    void addSquaresScalar(const float *in, std::size_t count, double partial[8]);
+    double combinePartialSums(const double partial[8]);
+    double sumOfSquaresScalar(const float *in, std::size_t count);
+    void s16ToFloatScalar(const void *in, float *out, std::size_t count);
+    void s32ToFloatScalar(const void *in, float *out, std::size_t count);
+
+}  // namespace some::dsp::detail
+
+#endif //SOME_GUI_KERNELSIMPL_H
@@ -0,0 +1,89 @@
+#include <cstdint>
+
+#include "KernelsImpl.h"
+
+// AArch64 only: it always has NEON, with float division and double precision vectors.
+#if (defined(__aarch64__) || defined(_M_ARM64)) && !defined(__ARM_BIG_ENDIAN)
+# define SOME_DSP_HAVE_NEON
+# include <arm_neon.h>
+#endif
+
+namespace some::dsp::detail {
+
+#ifdef SOME_DSP_HAVE_NEON
+    namespace {
+        void downmix(const float *in, float *out, std::size_t frames, int channels) {
+            std::size_t i = 0;
+            if (channels == 2) {
+                // 2 is a power of two, so multiplying by 0.5 is the same as dividing by 2.
+                for (; i + 4 <= frames; i += 4) {
+                    float32x4x2_t v = vld2q_f32(in + 2 * i);  // deinterleaves left and right
+                    float32x4_t s = vaddq_f32(vdupq_n_f32(0.0f), vmulq_n_f32(v.val[0], 0.5f));
+                    s = vaddq_f32(s, vmulq_n_f32(v.val[1], 0.5f));
+                    vst1q_f32(out + i, s);
+                }
+            }
+            downmixScalar(in + i * channels, out + i, frames - i, channels);
+        }
+
+        double sumOfSquares(const float *in, std::size_t count) {
+            // Four vectors of two lanes hold partial sums 0-7; see KernelsAvx2.cpp.
+            float64x2_t sums[4] = {vdupq_n_f64(0.0), vdupq_n_f64(0.0), vdupq_n_f64(0.0), vdupq_n_f64(0.0)};
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                float32x4_t a = vld1q_f32(in + i);
+                float32x4_t b = vld1q_f32(in + i + 4);
+                float64x2_t x[4] = {vcvt_f64_f32(vget_low_f32(a)), vcvt_high_f64_f32(a),
+                                    vcvt_f64_f32(vget_low_f32(b)), vcvt_high_f64_f32(b)};
+                for (int j = 0; j < 4; ++j) {
+                    sums[j] = vaddq_f64(sums[j], vmulq_f64(x[j], x[j]));
+                }
+            }
+            double partial[8];
+            for (int j = 0; j < 4; ++j) {
+                vst1q_f64(partial + 2 * j, sums[j]);
+            }
+            addSquaresScalar(in + i, count - i, partial);
+            return combinePartialSums(partial);
+        }
+
+        void s16ToFloat(const void *in, float *out, std::size_t count) {
+            auto samples = static_cast<const std::int16_t *>(in);
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                int16x8_t v = vld1q_s16(samples + i);
+                vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), 1.0f / 32768.0f));
+                vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_high_s16(v)), 1.0f / 32768.0f));
+            }
+            s16ToFloatScalar(samples + i, out + i, count - i);
+        }
+
+        void s32ToFloat(const void *in, float *out, std::size_t count) {
+            auto samples = static_cast<const std::int32_t *>(in);
+            // Same as the scalar kernel; see KernelsAvx2.cpp.
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(samples + i)), 1.0f / 2147483648.0f));
+            }
+            s32ToFloatScalar(samples + i, out + i, count - i);
+        }
+
+        const KernelTable kTable = {
+                Isa::Neon,
+                downmix,
+                sumOfSquares,
+                s16ToFloat,
+                s32ToFloat,
+        };
+    }
+
+    const KernelTable *neonKernels() {
+        return &kTable;
+    }
+#else
+    const KernelTable *neonKernels() {
+        return nullptr;
+    }
+#endif
+
+}  // namespace some::dsp::detail
@@ -0,0 +1,73 @@
+#include <cstdint>
+
+#include "KernelsImpl.h"
+
+namespace some::dsp::detail {
+
+    namespace {
+        std::uint32_t readLe16(const unsigned char *p) {
+            return static_cast<std::uint32_t>(p[0]) | static_cast<std::uint32_t>(p[1]) << 8;
+        }
+
+        std::uint32_t readLe32(const unsigned char *p) {
+            return static_cast<std::uint32_t>(p[0]) | static_cast<std::uint32_t>(p[1]) << 8 |
+                   static_cast<std::uint32_t>(p[2]) << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+        }
+
+        const KernelTable kTable = {
+                Isa::Scalar,
+                downmixScalar,
+                sumOfSquaresScalar,
+                s16ToFloatScalar,
+                s32ToFloatScalar,
+        };
+    }
+
+    void downmixScalar(const float *in, float *out, std::size_t frames, int channels) {
+        for (std::size_t i = 0; i < frames; ++i) {
+            float s = 0;
+            for (int j = 0; j < channels; ++j) {
+                s += in[i * channels + j] / static_cast<float>(channels);
+            }
+            out[i] = s;
+        }
+    }
+
+    void addSquaresScalar(const float *in, std::size_t count, double partial[8]) {
+        for (std::size_t i = 0; i < count; ++i) {
+            partial[i % 8] += static_cast<double>(in[i]) * in[i];
+        }
+    }
+
+    double combinePartialSums(const double partial[8]) {
+        return ((partial[0] + partial[1]) + (partial[2] + partial[3])) +
+               ((partial[4] + partial[5]) + (partial[6] + partial[7]));
+    }
+
+    double sumOfSquaresScalar(const float *in, std::size_t count) {
+        double partial[8] = {};
+        addSquaresScalar(in, count, partial);
+        return combinePartialSums(partial);
+    }
+
+    void s16ToFloatScalar(const void *in, float *out, std::size_t count) {
+        auto bytes = static_cast<const unsigned char *>(in);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto v = static_cast<std::int16_t>(readLe16(bytes + 2 * i));
+            out[i] = static_cast<float>(v) / 32768.0f;
+        }
+    }
+
+    void s32ToFloatScalar(const void *in, float *out, std::size_t count) {
+        auto bytes = static_cast<const unsigned char *>(in);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto v = static_cast<std::int32_t>(readLe32(bytes + 4 * i));
+            out[i] = static_cast<float>(static_cast<double>(v) / 2147483648.0);
+        }
+    }
+
+    const KernelTable *scalarKernels() {
+        return &kTable;
+    }
+
+}  // namespace some::dsp::detail
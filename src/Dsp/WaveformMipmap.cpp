@@ -0,0 +1,177 @@
+#include <algorithm>
+
+#include "Kernels.h"
+#include "WaveformMipmap.h"
+
+namespace some::dsp {
+
+    namespace {
+        MinMax merge(const MinMax &a, const MinMax &b) {
+            return {std::min(a.min, b.min), std::max(a.max, b.max)};
+        }
+    }
+
+    int WaveformMipmap::sampleRate() const {
+        return m_sampleRate;
+    }
+
+    std::size_t WaveformMipmap::frames() const {
+        return m_frames;
+    }
+
+    double WaveformMipmap::durationSeconds() const {
+        return m_sampleRate > 0 ? static_cast<double>(m_frames) / m_sampleRate : 0.0;
+    }
+
+    int WaveformMipmap::levelCount() const {
+        return static_cast<int>(m_levels.size());
+    }
+
+    std::size_t WaveformMipmap::framesPerEntry(int level) const {
+        return kBaseFrames << level;
+    }
+
+    const std::vector<MinMax> &WaveformMipmap::level(int level) const {
+        return m_levels[level];
+    }
+
+    MinMax WaveformMipmap::range(std::size_t begin, std::size_t end) const {
+        end = std::min(end, m_frames);
+        if (begin >= end || m_levels.empty()) {
+            return {};
+        }
+        auto lo = begin / kBaseFrames;
+        auto hi = (end + kBaseFrames - 1) / kBaseFrames;
+        MinMax result {m_levels[0][lo].min, m_levels[0][lo].max};
+        // Entry i of a level covers entries 2i and 2i + 1 of the level below.
+        for (std::size_t level = 0; lo < hi; ++level, lo /= 2, hi /= 2) {
+            const auto &entries = m_levels[level];
+            if (lo & 1) {
+                result = merge(result, entries[lo++]);
+            }
+            if (hi & 1) {
+                result = merge(result, entries[--hi]);
+            }
+        }
+        return result;
+    }
+
+    void WaveformMipmap::buildUpperLevels() {
+        m_levels.resize(1);
+        while (m_levels.back().size() > 1) {
+            const auto &below = m_levels.back();
+            std::vector<MinMax> level((below.size() + 1) / 2);
+            for (std::size_t i = 0; i < level.size(); ++i) {
+                auto j = 2 * i;
+                level[i] = (j + 1 < below.size()) ? merge(below[j], below[j + 1]) : below[j];
+            }
+            m_levels.push_back(std::move(level));
+        }
+    }
+
+    WaveformMipmapBuilder::~WaveformMipmapBuilder() {
+        finish();
+    }
+
+    void WaveformMipmapBuilder::start(const float *interleaved, std::size_t frames, int channels, int sampleRate) {
+        finish();
+        m_samples = interleaved;
+        m_frames = frames;
+        m_channels = std::max(channels, 1);
+        m_mipmap = std::make_unique<WaveformMipmap>();
+        m_mipmap->m_sampleRate = sampleRate;
+        m_mipmap->m_levels.emplace_back();
+        m_mipmap->m_levels[0].reserve((frames + WaveformMipmap::kBaseFrames - 1) / WaveformMipmap::kBaseFrames);
+        m_finalFrames = 0;
+        m_finishing = false;
+        m_thread = std::thread(&WaveformMipmapBuilder::run, this);
+    }
+
+    void WaveformMipmapBuilder::advance(std::size_t finalFrames) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_finalFrames = std::min(std::max(m_finalFrames, finalFrames), m_frames);
+        }
+        m_cv.notify_one();
+    }
+
+    WaveformMipmapPtr WaveformMipmapBuilder::finish() {
+        if (!m_thread.joinable()) {
+            return nullptr;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_finishing = true;
+        }
+        m_cv.notify_one();
+        m_thread.join();
+        m_mipmap->m_frames = m_finalFrames;
+        m_mipmap->buildUpperLevels();
+        m_samples = nullptr;
+        return std::move(m_mipmap);
+    }
+
+    WaveformMipmapPtr WaveformMipmapBuilder::build(const float *interleaved, std::size_t frames, int channels,
+                                                   int sampleRate) {
+        WaveformMipmapBuilder builder;
+        builder.start(interleaved, frames, channels, sampleRate);
+        builder.advance(frames);
+        return builder.finish();
+    }
+
+    WaveformMipmapPtr WaveformMipmapBuilder::fromBaseLevel(std::vector<MinMax> base, std::size_t frames,
+                                                           int sampleRate) {
+        if (base.size() != (frames + WaveformMipmap::kBaseFrames - 1) / WaveformMipmap::kBaseFrames) {
+            return nullptr;
+        }
+        auto mipmap = std::make_shared<WaveformMipmap>();
+        mipmap->m_sampleRate = sampleRate;
+        mipmap->m_frames = frames;
+        mipmap->m_levels.push_back(std::move(base));
+        mipmap->buildUpperLevels();
+        return mipmap;
+    }
+
+    void WaveformMipmapBuilder::run() {
+        constexpr auto kBase = WaveformMipmap::kBaseFrames;
+        std::vector<float> mono(kBase);
+        std::size_t done = 0;
+        while (true) {
+            std::size_t available;
+            bool finishing;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [&]() {
+                    return m_finishing || m_finalFrames >= done + kBase || m_finalFrames == m_frames;
+                });
+                available = m_finalFrames;
+                finishing = m_finishing;
+            }
+            // Whole entries only, except for the end of the buffer or of what finish() leaves.
+            auto end = (available == m_frames || finishing) ? available : available / kBase * kBase;
+            if (end > done) {
+                reduce(done, end, mono);
+                done = end;
+            }
+            if (finishing || done == m_frames) {
+                return;
+            }
+        }
+    }
+
+    void WaveformMipmapBuilder::reduce(std::size_t beginFrame, std::size_t endFrame, std::vector<float> &mono) {
+        constexpr auto kBase = WaveformMipmap::kBaseFrames;
+        auto &entries = m_mipmap->m_levels[0];
+        for (auto frame = beginFrame; frame < endFrame; frame += kBase) {
+            auto count = std::min(kBase, endFrame - frame);
+            const float *block = m_samples + frame * m_channels;
+            if (m_channels > 1) {
+                downmix(block, mono.data(), count, m_channels);
+                block = mono.data();
+            }
+            auto [low, high] = std::minmax_element(block, block + count);
+            entries.push_back({*low, *high});
+        }
+    }
+
+}  // namespace some::dsp
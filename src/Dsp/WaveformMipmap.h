@@ -0,0 +1,95 @@
+#ifndef SOME_GUI_WAVEFORMMIPMAP_H
+#define SOME_GUI_WAVEFORMMIPMAP_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace some::dsp {
+
+    struct MinMax {
+        float min = 0.0f;
+        float max = 0.0f;
+    };
+
+    // Min/max pyramid of a mono waveform for drawing it at any zoom. Level 0 has one entry per
+    // kBaseFrames frames; every level above merges two entries of the level below. A query covers
+    // its range with the largest entries that fit, like a segment tree, so it reads at most two
+    // entries per level below the length of the range however long the waveform is. Ranges are
+    // widened to whole level-0 entries.
+    class WaveformMipmap {
+    public:
+        static constexpr std::size_t kBaseFrames = 128;
+
+        WaveformMipmap() = default;
+
+        int sampleRate() const;
+        std::size_t frames() const;
+        double durationSeconds() const;
+
+        int levelCount() const;
+        std::size_t framesPerEntry(int level) const;
+        const std::vector<MinMax> &level(int level) const;
+
+        // Min and max of the frames [begin, end); zeros if the range is empty.
+        MinMax range(std::size_t begin, std::size_t end) const;
+
+    private:
+        friend class WaveformMipmapBuilder;
+
+        void buildUpperLevels();
+
+        int m_sampleRate = 0;
+        std::size_t m_frames = 0;
+        std::vector<std::vector<MinMax>> m_levels;
+    };  // class WaveformMipmap
+
+    using WaveformMipmapPtr = std::shared_ptr<const WaveformMipmap>;
+
+    // Builds a WaveformMipmap on a thread of its own while the caller is still filling the buffer,
+    // for example while decoding. The caller reports how many frames from the start are final with
+    // advance(); the builder downmixes and reduces those behind it without copying the buffer.
+    // The buffer must stay in place and unchanged up to the advanced frame until finish() returns.
+    class WaveformMipmapBuilder {
+    public:
+        WaveformMipmapBuilder() = default;
+        ~WaveformMipmapBuilder();
+
+        WaveformMipmapBuilder(const WaveformMipmapBuilder &) = delete;
+        WaveformMipmapBuilder &operator=(const WaveformMipmapBuilder &) = delete;
+
+        // `interleaved` holds `frames` frames of `channels` channels once it is complete.
+        void start(const float *interleaved, std::size_t frames, int channels, int sampleRate);
+        void advance(std::size_t finalFrames);
+        // Waits for the frames advanced so far and returns the mipmap. Frames never advanced
+        // are left out. Returns nullptr if start() was not called.
+        WaveformMipmapPtr finish();
+
+        // Builds on the calling thread from a complete buffer.
+        static WaveformMipmapPtr build(const float *interleaved, std::size_t frames, int channels, int sampleRate);
+        // Rebuilds a mipmap from its level 0, e.g. as stored in the preprocess cache. Returns nullptr
+        // if `base` doesn't have one entry per kBaseFrames frames.
+        static WaveformMipmapPtr fromBaseLevel(std::vector<MinMax> base, std::size_t frames, int sampleRate);
+
+    private:
+        void run();
+        void reduce(std::size_t beginFrame, std::size_t endFrame, std::vector<float> &mono);
+
+        const float *m_samples = nullptr;
+        std::size_t m_frames = 0;
+        int m_channels = 1;
+        std::unique_ptr<WaveformMipmap> m_mipmap;
+
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::size_t m_finalFrames = 0;  // guarded by m_mutex
+        bool m_finishing = false;       // guarded by m_mutex
+    };  // class WaveformMipmapBuilder
+
+}  // namespace some::dsp
+
+#endif //SOME_GUI_WAVEFORMMIPMAP_H
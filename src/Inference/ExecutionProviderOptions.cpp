@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <string>
+
+#include <onnxruntime_cxx_api.h>
+
+#include "ExecutionProviderOptions.h"
+
+namespace some {
+
+    namespace {
+        const ExecutionProvider kAllProviders[] = {
+                ExecutionProvider::CPU,
+                ExecutionProvider::CUDA,
+                ExecutionProvider::DirectML,
+                ExecutionProvider::XNNPACK,
+                ExecutionProvider::DNNL,
+                ExecutionProvider::OpenVINO,
+        };
+    }
+
+    const char *executionProviderName(ExecutionProvider ep) {
+        switch (ep) {
+            case ExecutionProvider::CUDA: return "cuda";
+            case ExecutionProvider::DirectML: return "dml";
+            case ExecutionProvider::XNNPACK: return "xnnpack";
+            case ExecutionProvider::DNNL: return "dnnl";
+            case ExecutionProvider::OpenVINO: return "openvino";
+            default: return "cpu";
+        }
+    }
+
+    const char *executionProviderDisplayName(ExecutionProvider ep) {
+        switch (ep) {
+            case ExecutionProvider::CUDA: return "CUDA";
+            case ExecutionProvider::DirectML: return "DirectML";
+            case ExecutionProvider::XNNPACK: return "XNNPACK";
+            case ExecutionProvider::DNNL: return "oneDNN";
+            case ExecutionProvider::OpenVINO: return "OpenVINO (CPU)";
+            default: return "CPU";
+        }
+    }
+
+    const char *ortExecutionProviderName(ExecutionProvider ep) {
+        switch (ep) {
+            case ExecutionProvider::CUDA: return "CUDAExecutionProvider";
+            case ExecutionProvider::DirectML: return "DmlExecutionProvider";
+            case ExecutionProvider::XNNPACK: return "XnnpackExecutionProvider";
+            case ExecutionProvider::DNNL: return "DnnlExecutionProvider";
+            case ExecutionProvider::OpenVINO: return "OpenVINOExecutionProvider";
+            default: return "CPUExecutionProvider";
+        }
+    }
+
+    bool parseExecutionProvider(const QString &name, ExecutionProvider &ep) {
+        auto lower = name.trimmed().toLower();
+        if (lower == "directml") {
+            lower = "dml";
+        }
+        else if (lower == "onednn") {
+            lower = "dnnl";
+        }
+        for (auto provider : kAllProviders) {
+            if (lower == executionProviderName(provider)) {
+                ep = provider;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isGpuExecutionProvider(ExecutionProvider ep) {
+        return ep == ExecutionProvider::CUDA || ep == ExecutionProvider::DirectML;
+    }
+
+    bool isExecutionProviderAvailable(ExecutionProvider ep) {
+        switch (ep) {
+            case ExecutionProvider::CPU:
+                return true;
+#ifndef ONNXRUNTIME_ENABLE_CUDA
+            case ExecutionProvider::CUDA:
+                return false;
+#endif
+#ifndef ONNXRUNTIME_ENABLE_DML
+            case ExecutionProvider::DirectML:
+                return false;
+#endif
+            default:
+                break;
+        }
+        try {
+            auto providers = Ort::GetAvailableProviders();
+            return std::find(providers.begin(), providers.end(), ortExecutionProviderName(ep)) != providers.end();
+        }
+        catch (const Ort::Exception &) {
+            return false;
+        }
+    }
+
+    std::vector<ExecutionProvider> availableExecutionProviders() {
+        std::vector<ExecutionProvider> providers;
+        for (auto provider : kAllProviders) {
+            if (isExecutionProviderAvailable(provider)) {
+                providers.push_back(provider);
+            }
+        }
+        return providers;
+    }
+
+}  // namespace some
@@ -1,15 +1,38 @@
 #ifndef SOME_GUI_EXECUTIONPROVIDEROPTIONS_H
 #define SOME_GUI_EXECUTIONPROVIDEROPTIONS_H
 
+#include <vector>
+
 #include <QObject>
 #include <QMetaType>
+#include <QString>
 
 namespace some {
     enum class ExecutionProvider {
         CPU,
         CUDA,
-        DirectML
+        DirectML,
+        // CPU accelerators; whether they exist depends on the ONNX Runtime build that is loaded.
+        XNNPACK,
+        DNNL,      // oneDNN
+        OpenVINO,  // OpenVINO on the CPU device
     };  // enum class ExecutionProvider
+
+    // Short lower-case name used on the command line and in settings keys, e.g. "cuda".
+    const char *executionProviderName(ExecutionProvider ep);
+    // Name shown to the user, e.g. "DirectML".
+    const char *executionProviderDisplayName(ExecutionProvider ep);
+    // Name ONNX Runtime lists in GetAvailableProviders(), e.g. "XnnpackExecutionProvider".
+    const char *ortExecutionProviderName(ExecutionProvider ep);
+    // Accepts the short names, "directml" and "onednn". Returns false for anything else.
+    bool parseExecutionProvider(const QString &name, ExecutionProvider &ep);
+    bool isGpuExecutionProvider(ExecutionProvider ep);
+
+    // Whether the loaded ONNX Runtime library has the provider, and this program was built to use
+    // it (CUDA and DirectML need build options). The ONNX Runtime API must be initialized.
+    bool isExecutionProviderAvailable(ExecutionProvider ep);
+    // The available providers, CPU first.
+    std::vector<ExecutionProvider> availableExecutionProviders();
 }  // namespace some
 
 Q_DECLARE_METATYPE(some::ExecutionProvider)
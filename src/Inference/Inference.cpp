@@ -1,28 +1,125 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
 
 #ifdef ONNXRUNTIME_ENABLE_DML
 #include <dml_provider_factory.h>
 #endif
 
 #include "Inference.h"
+#include "Utils/ProcessMemory.h"
 
 namespace some {
 
+    namespace {
+        std::atomic<int> liveInstances {0};
+        std::mutex globalEnvMutex;
+        // Lives until the process exits, so every later Ort::Env shares its pools.
+        Ort::Env *globalEnv = nullptr;
+
+        // ONNX Runtime's affinity format: one entry per thread after the caller, separated by ';',
+        // with logical processor ids starting from 1.
+        std::string affinityString(const std::vector<int> &cpus, int threads) {
+            std::string text;
+            for (int i = 1; i < threads && i < static_cast<int>(cpus.size()); ++i) {
+                if (!text.empty()) {
+                    text += ';';
+                }
+                text += std::to_string(cpus[i] + 1);
+            }
+            return text;
+        }
+    }
+
     Inference::Inference(const QString &modelPath, QObject *parent)
             : QObject(parent),
               m_modelPath(modelPath),
               m_env(ORT_LOGGING_LEVEL_WARNING, "SOME"),
               m_session(nullptr),
-              ortApi(Ort::GetApi()) {}
+              ortApi(Ort::GetApi()) {
+        ++liveInstances;
+    }
+
+    Inference::~Inference() {
+        --liveInstances;
+    }
+
+    bool Inference::initGlobalThreadPools(int intraOpThreads, const std::vector<int> &cpus, QString *errorMessage) {
+        auto fail = [errorMessage](const QString &message) {
+            if (errorMessage) {
+                *errorMessage = message;
+            }
+            return false;
+        };
+        std::lock_guard<std::mutex> lock(globalEnvMutex);
+        if (globalEnv) {
+            return true;
+        }
+        if (liveInstances > 0) {
+            return fail("Global thread pools must be set up before the first model is loaded.");
+        }
+        try {
+            Ort::ThreadingOptions threadingOptions;
+            threadingOptions.SetGlobalIntraOpNumThreads(std::max(1, intraOpThreads));
+            threadingOptions.SetGlobalInterOpNumThreads(1);
+            auto affinities = affinityString(cpus, intraOpThreads);
+            if (!affinities.empty()) {
+#if ORT_API_VERSION >= 14
+                Ort::ThrowOnError(Ort::GetApi().SetGlobalIntraOpThreadAffinity(threadingOptions, affinities.c_str()));
+#endif
+            }
+            globalEnv = new Ort::Env(threadingOptions, ORT_LOGGING_LEVEL_WARNING, "SOME");
+        }
+        catch (const Ort::Exception &ortException) {
+            return fail(QString("[ONNXRuntimeError] : %1 : %2")
+                                .arg(ortException.GetOrtErrorCode())
+                                .arg(ortException.what()));
+        }
+        return true;
+    }
 
     QString Inference::getModelPath() {
         return m_modelPath;
     }
 
+    void Inference::setSessionConfig(const SessionConfig &config) {
+        m_config = config;
+    }
+
+    const SessionConfig &Inference::sessionConfig() const {
+        return m_config;
+    }
+
     bool Inference::initSession(ExecutionProvider ep, int deviceIndex) {
+        m_activeProvider = ExecutionProvider::CPU;
+        m_profiling = false;
         try {
             auto options = Ort::SessionOptions();
+            if (!m_config.profilePrefix.empty()) {
+#ifdef _WIN32
+                options.EnableProfiling(QString::fromStdString(m_config.profilePrefix).toStdWString().c_str());
+#else
+                options.EnableProfiling(m_config.profilePrefix.c_str());
+#endif
+            }
+            if (m_config.globalThreadPools) {
+                options.DisablePerSessionThreads();
+            }
+            else if (m_config.intraOpThreads > 0) {
+                options.SetIntraOpNumThreads(m_config.intraOpThreads);
+                auto affinities = affinityString(m_config.intraOpCpus, m_config.intraOpThreads);
+                if (!affinities.empty()) {
+                    options.AddConfigEntry("session.intra_op_thread_affinities", affinities.c_str());
+                }
+            }
             switch (ep) {
                 case ExecutionProvider::DirectML:
 #ifdef ONNXRUNTIME_ENABLE_DML
@@ -38,6 +135,7 @@ namespace some {
                         auto status = Ort::Status(ortDmlApi->SessionOptionsAppendExecutionProvider_DML(options, deviceIndex));
                         if (status.IsOK()) {
                             Q_EMIT logMsgInfo("Successfully appended DirectML Execution Provider.");
+                            m_activeProvider = ep;
                         }
                         else {
                             Q_EMIT logMsgError(
@@ -94,6 +192,7 @@ namespace some {
 
                     if (status.IsOK()) {
                         Q_EMIT logMsgInfo("Successfully appended CUDA Execution Provider.");
+                        m_activeProvider = ep;
                     }
                     else {
                         Q_EMIT logMsgError(
@@ -108,21 +207,21 @@ namespace some {
                     Q_EMIT logMsgInfo("The software is not built with CUDA support. Use CPU instead.");
 #endif
                     break;
+                case ExecutionProvider::XNNPACK:
+                case ExecutionProvider::DNNL:
+                case ExecutionProvider::OpenVINO:
+                    if (appendCpuProvider(options, ep)) {
+                        m_activeProvider = ep;
+                    }
+                    break;
                 default:
                     // CPU and other
                     Q_EMIT logMsgInfo("Use CPU.");
                     break;
             }
 
-            m_session = Ort::Session(
-                    m_env,
-                    m_modelPath
-#ifdef _WIN32
-                    .toStdWString()
-#else
-                    .toStdString()
-#endif
-                    .c_str(), options);
+            createSession(options);
+            m_profiling = !m_config.profilePrefix.empty();
 
             return postInitCheck();
         }
@@ -135,6 +234,233 @@ namespace some {
     }
 
 
+    bool Inference::appendCpuProvider(Ort::SessionOptions &options, ExecutionProvider ep) {
+        QString name = executionProviderDisplayName(ep);
+        Q_EMIT logMsgInfo(QString("Try %1...").arg(name));
+        if (!isExecutionProviderAvailable(ep)) {
+            Q_EMIT logMsgError(QString("%1 is not available in the loaded ONNX Runtime library. Use CPU instead.")
+                                       .arg(name));
+            return false;
+        }
+        // The provider's own thread count: the configured intra-op threads, or one per logical CPU.
+        auto threads = m_config.intraOpThreads > 0 ? m_config.intraOpThreads
+                                                   : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        auto threadsStr = std::to_string(threads);
+        try {
+            switch (ep) {
+                case ExecutionProvider::XNNPACK:
+#if ORT_API_VERSION >= 14
+                    options.AppendExecutionProvider("XNNPACK", {{"intra_op_num_threads", threadsStr}});
+                    // XNNPACK runs its kernels on its own pool; a default-sized ONNX Runtime pool would
+                    // only spin next to it, so the nodes left to the CPU provider run on the caller.
+                    if (!m_config.globalThreadPools && m_config.intraOpThreads == 0) {
+                        options.SetIntraOpNumThreads(1);
+                    }
+                    break;
+#else
+                    throw Ort::Exception("XNNPACK needs ONNX Runtime 1.14 or later.", ORT_NOT_IMPLEMENTED);
+#endif
+                case ExecutionProvider::DNNL: {
+#if ORT_API_VERSION >= 15
+                    OrtDnnlProviderOptions *dnnlOptions = nullptr;
+                    Ort::ThrowOnError(ortApi.CreateDnnlProviderOptions(&dnnlOptions));
+                    auto status = Ort::Status(ortApi.SessionOptionsAppendExecutionProvider_Dnnl(options, dnnlOptions));
+                    ortApi.ReleaseDnnlProviderOptions(dnnlOptions);
+                    if (!status.IsOK()) {
+                        throw Ort::Exception(status.GetErrorMessage(), status.GetErrorCode());
+                    }
+                    break;
+#else
+                    throw Ort::Exception("oneDNN needs ONNX Runtime 1.15 or later.", ORT_NOT_IMPLEMENTED);
+#endif
+                }
+                case ExecutionProvider::OpenVINO: {
+#if ORT_API_VERSION >= 18
+                    options.AppendExecutionProvider_OpenVINO_V2({{"device_type", "CPU"},
+                                                                 {"num_of_threads", threadsStr}});
+#else
+                    OrtOpenVINOProviderOptions openVinoOptions;
+                    openVinoOptions.device_type = "CPU_FP32";
+                    openVinoOptions.num_of_threads = static_cast<size_t>(threads);
+                    options.AppendExecutionProvider_OpenVINO(openVinoOptions);
+#endif
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        catch (const Ort::Exception &ortException) {
+            Q_EMIT logMsgError(QString("Failed to append %1 Execution Provider. Use CPU instead. "
+                                       "Error code: %2, Reason: %3")
+                                       .arg(name)
+                                       .arg(ortException.GetOrtErrorCode())
+                                       .arg(ortException.what()));
+            return false;
+        }
+        Q_EMIT logMsgInfo(QString("Successfully appended %1 Execution Provider (%2 threads).").arg(name).arg(threads));
+        return true;
+    }
+
+    QString Inference::endProfiling() {
+        if (!m_session || !m_profiling) {
+            return {};
+        }
+        m_profiling = false;
+        try {
+            Ort::AllocatorWithDefaultOptions allocator;
+#if ORT_API_VERSION >= 13
+            auto path = m_session.EndProfilingAllocated(allocator);
+            return QString::fromUtf8(path.get());
+#else
+            auto path = m_session.EndProfiling(allocator);
+            auto result = QString::fromUtf8(path);
+            allocator.Free(path);
+            return result;
+#endif
+        }
+        catch (const Ort::Exception &ortException) {
+            Q_EMIT logMsgError(QString("[ONNXRuntimeError] : %1 : %2")
+                                       .arg(ortException.GetOrtErrorCode())
+                                       .arg(ortException.what()));
+        }
+        return {};
+    }
+
+    ExecutionProvider Inference::activeProvider() const {
+        return m_activeProvider;
+    }
+
+    void Inference::createSession(Ort::SessionOptions &options) {
+        // Drop the previous session before the memory its initializers point into.
+        m_session = Ort::Session(nullptr);
+        m_externalInitializers.clear();
+        m_weightFiles.clear();
+
+        auto memoryBefore = getProcessMemory();
+        auto start = std::chrono::steady_clock::now();
+        auto modelPath = m_modelPath
+#ifdef _WIN32
+                .toStdWString();
+#else
+                .toStdString();
+#endif
+        QString loadDescription = "read from file";
+
+        if (m_config.loadMode == ModelLoadMode::MemoryMap) {
+            QFile modelFile(m_modelPath);
+            const uchar *modelData = nullptr;
+            if (modelFile.open(QIODevice::ReadOnly)) {
+                modelData = modelFile.map(0, modelFile.size());
+            }
+            if (modelData) {
+                auto modelSize = static_cast<std::size_t>(modelFile.size());
+                std::vector<onnx::ExternalTensor> externalTensors;
+                if (!onnx::readExternalTensors(reinterpret_cast<const char *>(modelData), modelSize,
+                                               externalTensors)) {
+                    // Loaded by path below: ONNX Runtime reports what is wrong with the model, and can
+                    // still resolve external data relative to its directory.
+                    Q_EMIT logMsgInfo("Could not read the model's initializers. Loading it by path instead.");
+                }
+                else if (externalTensors.empty()) {
+                    // Weights are embedded: parsing straight from the mapping saves reading the file
+                    // into a buffer first. The mapping is only needed while the session is created.
+                    m_session = Ort::Session(m_env, modelData, modelSize, options);
+                    loadDescription = "memory-mapped";
+                }
+                else {
+                    auto mapped = addMappedInitializers(externalTensors, options);
+                    // Loaded by path, so ONNX Runtime can still find any external data we didn't map.
+                    m_session = Ort::Session(m_env, modelPath.c_str(), options);
+                    loadDescription = QString("external data, %1 of %2 initializers memory-mapped")
+                            .arg(mapped).arg(externalTensors.size());
+                }
+            }
+            else {
+                Q_EMIT logMsgInfo("Could not map the model file. Reading it instead.");
+            }
+        }
+        if (!m_session) {
+            m_session = Ort::Session(m_env, modelPath.c_str(), options);
+        }
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        auto memoryAfter = getProcessMemory();
+        auto deltaMegabytes = [](std::size_t before, std::size_t after) {
+            return QString::number((static_cast<double>(after) - static_cast<double>(before)) / (1024.0 * 1024.0),
+                                   'f', 1);
+        };
+        Q_EMIT logMsgInfo(QString("Model loaded in %1 ms (%2). Resident memory %3 MB, private %4 MB.")
+                                  .arg(QString::number(elapsed.count(), 'f', 0))
+                                  .arg(loadDescription)
+                                  .arg(deltaMegabytes(memoryBefore.resident, memoryAfter.resident))
+                                  .arg(deltaMegabytes(memoryBefore.privateResident, memoryAfter.privateResident)));
+    }
+
+    std::size_t Inference::addMappedInitializers(const std::vector<onnx::ExternalTensor> &tensors,
+                                                 Ort::SessionOptions &options) {
+#if ORT_API_VERSION >= 12
+        struct Mapping {
+            const uchar *data;
+            std::uint64_t size;
+        };
+        QHash<QString, Mapping> mappings;
+        QDir modelDir = QFileInfo(m_modelPath).absoluteDir();
+        auto memoryInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+        std::vector<std::string> names;
+
+        for (const auto &tensor : tensors) {
+            auto elementSize = onnx::elementSize(tensor.dataType);
+            if (elementSize == 0 || tensor.location.empty()) {
+                continue;
+            }
+            auto path = modelDir.filePath(QString::fromStdString(tensor.location));
+            auto it = mappings.find(path);
+            if (it == mappings.end()) {
+                auto file = std::make_unique<QFile>(path);
+                Mapping mapping {nullptr, 0};
+                if (file->open(QIODevice::ReadOnly)) {
+                    mapping = {file->map(0, file->size()), static_cast<std::uint64_t>(file->size())};
+                }
+                if (mapping.data) {
+                    m_weightFiles.push_back(std::move(file));
+                }
+                it = mappings.insert(path, mapping);
+            }
+            if (!it->data) {
+                continue;
+            }
+
+            std::uint64_t bytes = elementSize;
+            bool validDims = true;
+            for (auto dim : tensor.dims) {
+                validDims = validDims && dim >= 0;
+                bytes *= static_cast<std::uint64_t>(std::max<std::int64_t>(dim, 0));
+            }
+            if (!validDims || (tensor.length != 0 && tensor.length != bytes) || tensor.offset + bytes > it->size) {
+                continue;
+            }
+            auto data = it->data + tensor.offset;
+            // Kernels expect naturally aligned elements; let ONNX Runtime copy the others.
+            if (reinterpret_cast<std::uintptr_t>(data) % elementSize != 0) {
+                continue;
+            }
+            m_externalInitializers.push_back(Ort::Value::CreateTensor(
+                    memoryInfo, const_cast<uchar *>(data), static_cast<std::size_t>(bytes),
+                    tensor.dims.data(), tensor.dims.size(), static_cast<ONNXTensorElementDataType>(tensor.dataType)));
+            names.push_back(tensor.name);
+        }
+        if (!names.empty()) {
+            options.AddExternalInitializers(names, m_externalInitializers);
+        }
+        return names.size();
+#else
+        Q_UNUSED(tensors)
+        Q_UNUSED(options)
+        return 0;
+#endif
+    }
+
     bool Inference::hasSession() {
         return m_session;
     }
@@ -144,6 +470,8 @@ namespace some {
             Ort::Session emptySession(nullptr);
             std::swap(m_session, emptySession);
         }
+        m_externalInitializers.clear();
+        m_weightFiles.clear();
         postCleanup();
     }
 
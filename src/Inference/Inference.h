@@ -2,14 +2,19 @@
 #ifndef SOME_GUI_INFERENCE_H
 #define SOME_GUI_INFERENCE_H
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
+#include <QFile>
 #include <QObject>
 #include <QString>
 
 #include <onnxruntime_cxx_api.h>
 
 #include "ExecutionProviderOptions.h"
+#include "OnnxProto.h"
+#include "SessionConfig.h"
 
 namespace some {
 
@@ -17,8 +22,23 @@ namespace some {
         Q_OBJECT
     public:
         explicit Inference(const QString &modelPath, QObject *parent = nullptr);
+        ~Inference() override;
 
+        // Creates the process-wide ONNX Runtime environment with one intra-op pool of
+        // `intraOpThreads` threads, pinned to `cpus` unless it is empty, for sessions with
+        // SessionConfig::globalThreadPools. ONNX Runtime has one environment per process and the
+        // first one created decides its pools, so this fails once an Inference exists.
+        static bool initGlobalThreadPools(int intraOpThreads, const std::vector<int> &cpus,
+                                          QString *errorMessage = nullptr);
+
+        // A provider that can't be used is reported and replaced by the CPU provider.
         bool initSession(ExecutionProvider ep = ExecutionProvider::CPU, int deviceIndex = 0);
+        // The provider the session was created with, after any fallback to the CPU.
+        ExecutionProvider activeProvider() const;
+
+        // Stops the profiler of a session created with SessionConfig::profilePrefix and returns the
+        // path of the profile it wrote, or an empty string if the session wasn't profiled.
+        QString endProfiling();
 
         void endSession();
 
@@ -26,6 +46,10 @@ namespace some {
 
         QString getModelPath();
 
+        // Takes effect at the next initSession().
+        void setSessionConfig(const SessionConfig &config);
+        const SessionConfig &sessionConfig() const;
+
     Q_SIGNALS:
         void logMsgInfo(const QString &msg);
         void logMsgError(const QString &msg);
@@ -37,12 +61,26 @@ namespace some {
         // (In this class, it should be defined before Ort::Session)
         // Otherwise, access violation will occur when Ort::Session destructor is called.
         Ort::Env m_env;
+        // Mapped external data files and the initializers pointing into them. They must outlive
+        // the session, so they are declared before it.
+        std::vector<std::unique_ptr<QFile>> m_weightFiles;
+        std::vector<Ort::Value> m_externalInitializers;
         Ort::Session m_session;
         OrtApi const &ortApi; // Uses ORT_API_VERSION
+        SessionConfig m_config;
+        ExecutionProvider m_activeProvider = ExecutionProvider::CPU;
+        bool m_profiling = false;
     protected:
         virtual bool postInitCheck();
 
         virtual void postCleanup();
+
+    private:
+        void createSession(Ort::SessionOptions &options);
+        // XNNPACK, oneDNN or OpenVINO. Returns false, after logging why, if the provider is missing.
+        bool appendCpuProvider(Ort::SessionOptions &options, ExecutionProvider ep);
+        std::size_t addMappedInitializers(const std::vector<onnx::ExternalTensor> &tensors,
+                                          Ort::SessionOptions &options);
     };  // class Inference
 
 }  // namespace some
@@ -0,0 +1,26 @@
+#ifndef SOME_GUI_INFERENCEBACKEND_H
+#define SOME_GUI_INFERENCEBACKEND_H
+
+#include <cstddef>
+#include <vector>
+
+#include "NotesStruct.h"
+
+namespace some {
+
+    // Anything that turns a range of a 44.1 kHz mono waveform into notes.
+    // SOMEInference runs an ONNX model; MockInference stands in for it when no model is available.
+    class InferenceBackend {
+    public:
+        virtual ~InferenceBackend() = default;
+
+        virtual Notes infer(const std::vector<float> &waveform, std::size_t begin, std::size_t count) = 0;
+
+        // Makes an infer() running on another thread return as soon as the backend can stop it, and
+        // every later call return at once, all with no notes. Safe to call from any thread.
+        virtual void cancel() {}
+    };  // class InferenceBackend
+
+}  // namespace some
+
+#endif //SOME_GUI_INFERENCEBACKEND_H
@@ -6,6 +6,8 @@
 #include <iostream>
 #include <unordered_set>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #include <onnxruntime_cxx_api.h>
 
@@ -45,6 +47,9 @@ namespace some {
 
     inline bool hasKey(const std::unordered_set<std::string> &container, const std::string &key);
 
+    template<class T_vector, class T_tensor>
+    inline void copyToTensorBuffer(const std::vector<T_vector> &vec, T_tensor *buffer);
+
 
     /* IMPLEMENTATION BELOW */
 
@@ -78,6 +83,21 @@ namespace some {
         return supportedOutputNames;
     }
 
+    template<class T_vector, class T_tensor>
+    void copyToTensorBuffer(const std::vector<T_vector> &vec, T_tensor *buffer) {
+        if constexpr (std::is_same_v<T_vector, T_tensor> && !std::is_same_v<T_vector, bool>) {
+            // Same type: one memcpy, which the C library vectorizes for the CPU it runs on.
+            if (!vec.empty()) {
+                std::memcpy(buffer, vec.data(), vec.size() * sizeof(T_tensor));
+            }
+        }
+        else {
+            for (size_t i = 0; i < vec.size(); i++) {
+                buffer[i] = static_cast<T_tensor>(vec[i]);
+            }
+        }
+    }
+
     template<class T_vector, class T_tensor>
     Ort::Value vectorToTensor(const std::vector<T_vector> &vec) {
         int64_t shape[] = { 1, static_cast<int64_t>(vec.size()) };  // shape = {1, N}
@@ -86,9 +106,7 @@ namespace some {
         Ort::AllocatorWithDefaultOptions allocator;
         auto tensor = Ort::Value::CreateTensor<T_tensor>(allocator, shape, shapeSize);
         auto buffer = tensor.template GetTensorMutableData<T_tensor>();
-        for (size_t i = 0; i < vec.size(); i++) {
-            buffer[i] = static_cast<T_tensor>(vec[i]);
-        }
+        copyToTensorBuffer(vec, buffer);
 
         return tensor;
     }
@@ -100,9 +118,7 @@ namespace some {
         Ort::AllocatorWithDefaultOptions allocator;
         auto tensor = Ort::Value::CreateTensor<T_tensor>(allocator, shape.data(), shapeSize);
         auto buffer = tensor.template GetTensorMutableData<T_tensor>();
-        for (size_t i = 0; i < vec.size(); i++) {
-            buffer[i] = static_cast<T_tensor>(vec[i]);
-        }
+        copyToTensorBuffer(vec, buffer);
 
         return tensor;
     }
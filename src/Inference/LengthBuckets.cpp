@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cmath>
+
+#include "LengthBuckets.h"
+
+namespace some {
+
+    LengthBuckets::LengthBuckets(const LengthBucketOptions &options) : m_options(options) {
+        m_options.hopSize = std::max<std::size_t>(m_options.hopSize, 1);
+        m_options.growth = std::max(m_options.growth, 1.0);
+    }
+
+    bool LengthBuckets::enabled() const {
+        return m_options.enabled;
+    }
+
+    const LengthBucketOptions &LengthBuckets::options() const {
+        return m_options;
+    }
+
+    std::size_t LengthBuckets::alignUp(std::size_t length) const {
+        auto hop = m_options.hopSize;
+        return (length + hop - 1) / hop * hop;
+    }
+
+    std::size_t LengthBuckets::nextBucket(std::size_t bucket) const {
+        // At least one hop longer, so a growth close to 1 still terminates.
+        auto grown = static_cast<std::size_t>(std::ceil(static_cast<double>(bucket) * m_options.growth));
+        return alignUp(std::max(grown, bucket + m_options.hopSize));
+    }
+
+    std::size_t LengthBuckets::bucketFor(std::size_t count) const {
+        if (!m_options.enabled) {
+            return count;
+        }
+        auto bucket = alignUp(std::max<std::size_t>(m_options.minLength, 1));
+        while (bucket < count) {
+            bucket = nextBucket(bucket);
+        }
+        return bucket;
+    }
+
+    std::vector<std::size_t> LengthBuckets::bucketsUpTo(std::size_t maxCount) const {
+        std::vector<std::size_t> buckets;
+        if (!m_options.enabled) {
+            return buckets;
+        }
+        auto bucket = alignUp(std::max<std::size_t>(m_options.minLength, 1));
+        buckets.push_back(bucket);
+        while (bucket < maxCount) {
+            bucket = nextBucket(bucket);
+            buckets.push_back(bucket);
+        }
+        return buckets;
+    }
+
+    void trimNotes(Notes &notes, double seconds) {
+        auto count = std::min({notes.note_midi.size(), notes.note_rest.size(), notes.note_dur.size()});
+        double onset = 0.0;
+        std::size_t keep = 0;
+        for (; keep < count && onset < seconds; ++keep) {
+            double offset = onset + notes.note_dur[keep];
+            if (offset > seconds) {
+                notes.note_dur[keep] = static_cast<float>(seconds - onset);
+            }
+            onset = offset;
+        }
+        notes.note_midi.resize(keep);
+        notes.note_rest.resize(keep);
+        notes.note_dur.resize(keep);
+    }
+
+}  // namespace some
@@ -0,0 +1,51 @@
+#ifndef SOME_GUI_LENGTHBUCKETS_H
+#define SOME_GUI_LENGTHBUCKETS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "NotesStruct.h"
+
+namespace some {
+
+    // Pads model inputs to a small set of lengths. ONNX Runtime plans the memory of a run from the
+    // input shapes and reuses the plan (the "memory pattern") for the next run of the same shape, so
+    // every distinct chunk length otherwise costs a fresh plan and possibly another arena extension.
+    // Bucket lengths grow geometrically from `minLength` and are aligned to the model's hop size, so
+    // the padding never adds more than `growth - 1` of a chunk plus one hop.
+    struct LengthBucketOptions {
+        bool enabled = false;
+        double growth = 1.25;
+        // Samples per frame of the model (512 at 44.1 kHz for SOME).
+        std::size_t hopSize = 512;
+        // Shortest bucket, in samples; rounded up to the hop size.
+        std::size_t minLength = 22050;
+    };
+
+    class LengthBuckets {
+    public:
+        LengthBuckets() = default;
+        explicit LengthBuckets(const LengthBucketOptions &options);
+
+        bool enabled() const;
+        const LengthBucketOptions &options() const;
+
+        // Smallest bucket that holds `count` samples; `count` itself if bucketing is off.
+        std::size_t bucketFor(std::size_t count) const;
+        // The buckets up to and including the one for `maxCount`.
+        std::vector<std::size_t> bucketsUpTo(std::size_t maxCount) const;
+
+    private:
+        std::size_t alignUp(std::size_t length) const;
+        std::size_t nextBucket(std::size_t bucket) const;
+
+        LengthBucketOptions m_options;
+    };  // class LengthBuckets
+
+    // Drops the notes a model produced for zero padding after the first `seconds` of its input, and
+    // shortens the note that crosses that point.
+    void trimNotes(Notes &notes, double seconds);
+
+}  // namespace some
+
+#endif //SOME_GUI_LENGTHBUCKETS_H
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "MockInference.h"
+
+namespace some {
+
+    MockInference::MockInference(double costFactor, CostMode costMode, int sampleRate)
+            : m_costFactor(std::max(0.0, costFactor)), m_costMode(costMode),
+              m_sampleRate(sampleRate > 0 ? sampleRate : 44100) {}
+
+    Notes MockInference::infer(const std::vector<float> &waveform, std::size_t begin, std::size_t count) {
+        if (m_cancelled || begin >= waveform.size()) {
+            return {};
+        }
+        count = std::min(count, waveform.size() - begin);
+        if (count == 0) {
+            return {};
+        }
+
+        // 0.25 s segments, the last one absorbs the remainder.
+        const std::size_t segmentLength = static_cast<std::size_t>(m_sampleRate) / 4;
+        const std::size_t segmentCount = std::max<std::size_t>(1, count / segmentLength);
+        constexpr double kRestThreshold = 0.01;
+
+        Notes notes;
+        notes.note_midi.reserve(segmentCount);
+        notes.note_rest.reserve(segmentCount);
+        notes.note_dur.reserve(segmentCount);
+
+        for (std::size_t segment = 0; segment < segmentCount; ++segment) {
+            auto segBegin = begin + segment * segmentLength;
+            auto segEnd = (segment == segmentCount - 1) ? begin + count : segBegin + segmentLength;
+            auto segSize = segEnd - segBegin;
+
+            double sumSquares = 0.0;
+            std::size_t crossings = 0;
+            for (auto i = segBegin; i < segEnd; ++i) {
+                sumSquares += static_cast<double>(waveform[i]) * waveform[i];
+                if (i > segBegin && ((waveform[i - 1] < 0.0f) != (waveform[i] < 0.0f))) {
+                    ++crossings;
+                }
+            }
+            auto duration = static_cast<double>(segSize) / m_sampleRate;
+            auto rms = std::sqrt(sumSquares / static_cast<double>(segSize));
+            auto frequency = static_cast<double>(crossings) / 2.0 / duration;
+
+            bool rest = (rms < kRestThreshold) || (frequency <= 0.0);
+            float midi = 0.0f;
+            if (!rest) {
+                midi = static_cast<float>(std::clamp(69.0 + 12.0 * std::log2(frequency / 440.0), 0.0, 127.0));
+            }
+            notes.note_midi.push_back(midi);
+            notes.note_rest.push_back(static_cast<char>(rest));
+            notes.note_dur.push_back(static_cast<float>(duration));
+        }
+
+        simulateCost(static_cast<double>(count) / m_sampleRate);
+        if (m_cancelled) {
+            return {};
+        }
+        return notes;
+    }
+
+    void MockInference::cancel() {
+        m_cancelled = true;
+    }
+
+    void MockInference::simulateCost(double audioSeconds) const {
+        if (m_costFactor <= 0.0) {
+            return;
+        }
+        auto cost = std::chrono::duration<double>(audioSeconds * m_costFactor);
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::duration_cast<std::chrono::steady_clock::duration>(cost);
+        if (m_costMode == CostMode::Sleep) {
+            constexpr auto kSlice = std::chrono::milliseconds(1);
+            for (auto now = std::chrono::steady_clock::now(); now < deadline && !m_cancelled;
+                 now = std::chrono::steady_clock::now()) {
+                std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(kSlice, deadline - now));
+            }
+            return;
+        }
+        volatile double sink = 0.0;
+        while (std::chrono::steady_clock::now() < deadline && !m_cancelled) {
+            for (int i = 0; i < 256; ++i) {
+                sink = sink + 1e-9 * i;
+            }
+        }
+    }
+
+    double MockInference::costFactor() const {
+        return m_costFactor;
+    }
+
+    void MockInference::setCostFactor(double costFactor) {
+        m_costFactor = std::max(0.0, costFactor);
+    }
+
+    MockInference::CostMode MockInference::costMode() const {
+        return m_costMode;
+    }
+
+    void MockInference::setCostMode(CostMode costMode) {
+        m_costMode = costMode;
+    }
+
+}  // namespace some
@@ -0,0 +1,47 @@
+#ifndef SOME_GUI_MOCKINFERENCE_H
+#define SOME_GUI_MOCKINFERENCE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "InferenceBackend.h"
+
+namespace some {
+
+    // Deterministic stand-in for SOMEInference that needs no model.
+    // Each chunk is cut into fixed segments; a segment becomes a rest if it is quiet, otherwise a note
+    // whose pitch is estimated from zero crossings. The same input always yields the same notes.
+    //
+    // The compute cost is simulated: for every second of audio the backend spends `costFactor` seconds
+    // either spinning a core (like a CPU session would) or sleeping.
+    class MockInference : public InferenceBackend {
+    public:
+        enum class CostMode {
+            Spin,
+            Sleep
+        };
+
+        explicit MockInference(double costFactor = 0.0, CostMode costMode = CostMode::Spin, int sampleRate = 44100);
+
+        Notes infer(const std::vector<float> &waveform, std::size_t begin, std::size_t count) override;
+        // The simulated cost is checked about every millisecond.
+        void cancel() override;
+
+        double costFactor() const;
+        void setCostFactor(double costFactor);
+        CostMode costMode() const;
+        void setCostMode(CostMode costMode);
+
+    private:
+        void simulateCost(double audioSeconds) const;
+
+        double m_costFactor;
+        CostMode m_costMode;
+        int m_sampleRate;
+        std::atomic<bool> m_cancelled {false};
+    };  // class MockInference
+
+}  // namespace some
+
+#endif //SOME_GUI_MOCKINFERENCE_H
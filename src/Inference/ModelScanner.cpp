@@ -0,0 +1,138 @@
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "ModelScanner.h"
+#include "SOMEInference.h"
+
+namespace some {
+
+    namespace {
+        constexpr int kCacheVersion = 1;
+
+        QString cacheFilePath() {
+            auto location = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+            return location.isEmpty() ? QString() : location + "/model-info.json";
+        }
+
+        QJsonObject loadCache() {
+            QFile file(cacheFilePath());
+            if (!file.open(QIODevice::ReadOnly)) {
+                return {};
+            }
+            auto root = QJsonDocument::fromJson(file.readAll()).object();
+            if (root["version"].toInt() != kCacheVersion) {
+                return {};
+            }
+            return root["models"].toObject();
+        }
+
+        void saveCache(const QJsonObject &models) {
+            auto path = cacheFilePath();
+            if (path.isEmpty() || !QDir().mkpath(QFileInfo(path).absolutePath())) {
+                return;
+            }
+            QJsonObject root;
+            root["version"] = kCacheVersion;
+            root["models"] = models;
+            QSaveFile file(path);
+            if (file.open(QIODevice::WriteOnly)) {
+                file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+                file.commit();
+            }
+        }
+    }
+
+    bool ModelScanResult::isValid() const {
+        return error.isEmpty();
+    }
+
+    ModelScanner::ModelScanner(const QString &directory, QObject *parent)
+            : QThread(parent), m_directory(directory) {
+        qRegisterMetaType<some::ModelScanResult>();
+    }
+
+    ModelScanner::ModelScanner(const QStringList &files, QObject *parent)
+            : QThread(parent), m_files(files) {
+        qRegisterMetaType<some::ModelScanResult>();
+    }
+
+    ModelScanResult ModelScanner::inspect(const QString &path) {
+        ModelScanResult result;
+        result.path = path;
+        result.fileName = QFileInfo(path).fileName();
+        QString readError;
+        if (!onnx::readModelInfoFile(path, result.info, &readError)) {
+            result.error = readError;
+        }
+        else {
+            result.error = SOMEInference::checkModelInfo(result.info);
+        }
+        return result;
+    }
+
+    void ModelScanner::run() {
+        auto cachedModels = loadCache();
+        QJsonObject models;
+
+        bool scanDirectory = m_files.isEmpty();
+        QDir dir(m_directory);
+        QFileInfoList files;
+        if (scanDirectory) {
+            dir.setNameFilters({"*.onnx"});
+            files = dir.entryInfoList(QDir::Files, QDir::Name);
+        }
+        for (const auto &file : m_files) {
+            files.append(QFileInfo(file));
+        }
+        for (const auto &fileInfo : files) {
+            if (isInterruptionRequested()) {
+                return;
+            }
+            auto path = QDir::cleanPath(fileInfo.absoluteFilePath());
+            if (!fileInfo.isFile()) {
+                Q_EMIT modelScanned(inspect(path));
+                continue;
+            }
+            auto size = fileInfo.size();
+            auto modified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+            ModelScanResult result;
+            auto cached = cachedModels[path].toObject();
+            if (!cached.isEmpty() && cached["size"].toDouble() == size && cached["modified"].toDouble() == modified) {
+                result.path = path;
+                result.fileName = fileInfo.fileName();
+                result.info = onnx::modelInfoFromJson(cached["info"].toObject());
+                result.error = cached["error"].toString();
+                result.fromCache = true;
+            }
+            else {
+                result = inspect(path);
+            }
+
+            QJsonObject entry;
+            entry["size"] = size;
+            entry["modified"] = modified;
+            entry["info"] = onnx::toJson(result.info);
+            entry["error"] = result.error;
+            models[path] = entry;
+
+            Q_EMIT modelScanned(result);
+        }
+
+        // Entries of models from other directories, or of other files, are kept; removed files are dropped.
+        for (auto it = cachedModels.begin(); it != cachedModels.end(); ++it) {
+            if (!models.contains(it.key()) && (!scanDirectory || QFileInfo(it.key()).dir() != dir) &&
+                QFileInfo::exists(it.key())) {
+                models[it.key()] = it.value();
+            }
+        }
+        saveCache(models);
+    }
+
+}  // namespace some
@@ -0,0 +1,53 @@
+#ifndef SOME_GUI_MODELSCANNER_H
+#define SOME_GUI_MODELSCANNER_H
+
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+
+#include "OnnxModelInfo.h"
+
+namespace some {
+
+    struct ModelScanResult {
+        QString path;
+        QString fileName;
+        onnx::ModelInfo info;
+        // Why SOME can't use the model; empty if it can.
+        QString error;
+        bool fromCache = false;
+
+        bool isValid() const;
+    };
+
+    // Reads the interface of every *.onnx file in a directory on a background thread and reports
+    // each model as soon as it is known. Results are cached on disk by path, size and modification
+    // time, so unchanged models are reported without opening them.
+    class ModelScanner : public QThread {
+        Q_OBJECT
+    public:
+        explicit ModelScanner(const QString &directory, QObject *parent = nullptr);
+        // Scans these files instead of a directory, e.g. a model chosen by path. They share the cache
+        // with the directory scans.
+        explicit ModelScanner(const QStringList &files, QObject *parent = nullptr);
+
+        // Inspects a single model now, without the cache.
+        static ModelScanResult inspect(const QString &path);
+
+    Q_SIGNALS:
+        void modelScanned(const some::ModelScanResult &result);
+
+    protected:
+        void run() override;
+
+    private:
+        QString m_directory;
+        QStringList m_files;
+    };  // class ModelScanner
+
+}  // namespace some
+
+Q_DECLARE_METATYPE(some::ModelScanResult)
+
+#endif //SOME_GUI_MODELSCANNER_H
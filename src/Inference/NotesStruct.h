@@ -1,17 +1,47 @@
 #ifndef SOME_GUI_STRUCT_NOTES_
 #define SOME_GUI_STRUCT_NOTES_
 
+#include <memory>
 #include <vector>
 #include <QMetaType>
 
+#include "Utils/CopyStats.h"
+
 namespace some {
     struct Notes {
         std::vector<float> note_midi;
         std::vector<char> note_rest;
         std::vector<float> note_dur;
+
+        Notes() = default;
+        Notes(Notes &&) noexcept = default;
+        Notes &operator=(Notes &&) noexcept = default;
+        // Copies are counted; results are meant to be shared as NotesPtr instead.
+        Notes(const Notes &other)
+                : note_midi(other.note_midi), note_rest(other.note_rest), note_dur(other.note_dur) {
+            recordCopy(other.byteSize());
+        }
+        Notes &operator=(const Notes &other) {
+            if (this != &other) {
+                note_midi = other.note_midi;
+                note_rest = other.note_rest;
+                note_dur = other.note_dur;
+                recordCopy(other.byteSize());
+            }
+            return *this;
+        }
+
+        std::size_t byteSize() const {
+            return note_midi.size() * sizeof(float) + note_rest.size() * sizeof(char) +
+                   note_dur.size() * sizeof(float);
+        }
     };
+
+    // Notes of one chunk, immutable once inference has produced them.
+    using NotesPtr = std::shared_ptr<const Notes>;
 }  // namespace some
 
 Q_DECLARE_METATYPE(some::Notes)
+Q_DECLARE_METATYPE(some::NotesPtr)
 
-#endif  // SOME_GUI_STRUCT_NOTES_
\ No newline at end of file
+#endif  // SOME_GUI_STRUCT_NOTES_
@@ -0,0 +1,351 @@
+#include <algorithm>
+#include <unordered_set>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QStringList>
+
+#include "OnnxModelInfo.h"
+#include "OnnxProto.h"
+
+namespace some::onnx {
+
+    using namespace field;
+
+    namespace {
+        void readValueInfo(ProtoReader reader, ValueInfo &value) {
+            while (reader.next()) {
+                if (reader.field() == kValueInfoName) {
+                    value.name = reader.string();
+                }
+                else if (reader.field() == kValueInfoType) {
+                    auto type = reader.message();
+                    while (type.next()) {
+                        if (type.field() != kTypeTensorType) {
+                            continue;  // sequence, map, optional: not a tensor
+                        }
+                        auto tensorType = type.message();
+                        while (tensorType.next()) {
+                            if (tensorType.field() == kTensorTypeElemType) {
+                                value.elemType = static_cast<int>(tensorType.varint());
+                            }
+                            else if (tensorType.field() == kTensorTypeShape) {
+                                value.hasShape = true;
+                                auto shape = tensorType.message();
+                                while (shape.next()) {
+                                    if (shape.field() != kShapeDim) {
+                                        continue;
+                                    }
+                                    std::int64_t dimValue = -1;
+                                    std::string dimParam;
+                                    auto dim = shape.message();
+                                    while (dim.next()) {
+                                        if (dim.field() == kDimValue) {
+                                            dimValue = static_cast<std::int64_t>(dim.varint());
+                                        }
+                                        else if (dim.field() == kDimParam) {
+                                            dimParam = dim.string();
+                                        }
+                                    }
+                                    value.shape.push_back(dimValue);
+                                    value.dimParams.push_back(dimParam);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void readInitializer(ProtoReader reader, std::unordered_set<std::string> &names, bool &external) {
+            // Only the name and location; raw data is skipped without being touched.
+            while (reader.next()) {
+                if (reader.field() == kTensorName) {
+                    names.insert(reader.string());
+                }
+                else if (reader.field() == kTensorDataLocation && reader.varint() == kDataLocationExternal) {
+                    external = true;
+                }
+            }
+        }
+
+        std::pair<std::string, std::string> readEntry(ProtoReader reader) {
+            std::pair<std::string, std::string> entry;
+            while (reader.next()) {
+                if (reader.field() == kEntryKey) {
+                    entry.first = reader.string();
+                }
+                else if (reader.field() == kEntryValue) {
+                    entry.second = reader.string();
+                }
+            }
+            return entry;
+        }
+
+        QJsonObject valueToJson(const ValueInfo &value) {
+            QJsonArray shape;
+            for (std::size_t i = 0; i < value.shape.size(); ++i) {
+                if (value.shape[i] >= 0) {
+                    shape.append(static_cast<qint64>(value.shape[i]));
+                }
+                else {
+                    shape.append(QString::fromStdString(value.dimParams[i]));
+                }
+            }
+            QJsonObject object;
+            object["name"] = QString::fromStdString(value.name);
+            object["elem_type"] = value.elemType;
+            if (value.hasShape) {
+                object["shape"] = shape;
+            }
+            return object;
+        }
+
+        ValueInfo valueFromJson(const QJsonObject &object) {
+            ValueInfo value;
+            value.name = object["name"].toString().toStdString();
+            value.elemType = object["elem_type"].toInt();
+            value.hasShape = object.contains("shape");
+            for (const auto &dim : object["shape"].toArray()) {
+                if (dim.isString()) {
+                    value.shape.push_back(-1);
+                    value.dimParams.push_back(dim.toString().toStdString());
+                }
+                else {
+                    value.shape.push_back(static_cast<std::int64_t>(dim.toDouble()));
+                    value.dimParams.emplace_back();
+                }
+            }
+            return value;
+        }
+    }
+
+    std::int64_t ModelInfo::opsetVersion() const {
+        for (const auto &[opsetDomain, version] : opsets) {
+            if (opsetDomain.empty() || opsetDomain == "ai.onnx") {
+                return version;
+            }
+        }
+        return 0;
+    }
+
+    bool readModelInfo(const char *data, std::size_t size, ModelInfo &info) {
+        info = {};
+        bool hasGraph = false;
+        std::unordered_set<std::string> initializerNames;
+        ProtoReader model(data, size);
+        while (model.next()) {
+            switch (model.field()) {
+                case kModelIrVersion:
+                    info.irVersion = static_cast<std::int64_t>(model.varint());
+                    break;
+                case kModelProducerName:
+                    info.producerName = model.string();
+                    break;
+                case kModelProducerVersion:
+                    info.producerVersion = model.string();
+                    break;
+                case kModelDomain:
+                    info.domain = model.string();
+                    break;
+                case kModelVersion:
+                    info.modelVersion = static_cast<std::int64_t>(model.varint());
+                    break;
+                case kModelOpsetImport: {
+                    std::pair<std::string, std::int64_t> opset;
+                    auto reader = model.message();
+                    while (reader.next()) {
+                        if (reader.field() == kOpsetDomain) {
+                            opset.first = reader.string();
+                        }
+                        else if (reader.field() == kOpsetVersion) {
+                            opset.second = static_cast<std::int64_t>(reader.varint());
+                        }
+                    }
+                    info.opsets.push_back(std::move(opset));
+                    break;
+                }
+                case kModelMetadataProps:
+                    info.metadata.push_back(readEntry(model.message()));
+                    break;
+                case kModelGraph: {
+                    hasGraph = true;
+                    auto graph = model.message();
+                    while (graph.next()) {
+                        switch (graph.field()) {
+                            case kGraphInitializer:
+                                ++info.initializerCount;
+                                readInitializer(graph.message(), initializerNames, info.hasExternalData);
+                                break;
+                            case kGraphInput:
+                                info.inputs.emplace_back();
+                                readValueInfo(graph.message(), info.inputs.back());
+                                break;
+                            case kGraphOutput:
+                                info.outputs.emplace_back();
+                                readValueInfo(graph.message(), info.outputs.back());
+                                break;
+                            default:
+                                break;
+                        }
+                    }
+                    if (graph.hasError()) {
+                        return false;
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+        // IR version < 4 lists initializers as graph inputs too.
+        info.inputs.erase(std::remove_if(info.inputs.begin(), info.inputs.end(), [&](const ValueInfo &value) {
+            return initializerNames.count(value.name) > 0;
+        }), info.inputs.end());
+        return !model.hasError() && hasGraph;
+    }
+
+    bool readModelInfoFile(const QString &path, ModelInfo &info, QString *errorMessage) {
+        auto fail = [errorMessage](const QString &message) {
+            if (errorMessage) {
+                *errorMessage = message;
+            }
+            return false;
+        };
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return fail(file.errorString());
+        }
+        if (file.size() == 0) {
+            return fail("The file is empty.");
+        }
+        auto data = file.map(0, file.size());
+        if (!data) {
+            return fail(file.errorString());
+        }
+        if (!readModelInfo(reinterpret_cast<const char *>(data), static_cast<std::size_t>(file.size()), info)) {
+            return fail("Not a valid ONNX model.");
+        }
+        return true;
+    }
+
+    QString elemTypeName(int elemType) {
+        switch (elemType) {
+            case 1: return "float32";
+            case 2: return "uint8";
+            case 3: return "int8";
+            case 4: return "uint16";
+            case 5: return "int16";
+            case 6: return "int32";
+            case 7: return "int64";
+            case 8: return "string";
+            case 9: return "bool";
+            case 10: return "float16";
+            case 11: return "float64";
+            case 12: return "uint32";
+            case 13: return "uint64";
+            case 14: return "complex64";
+            case 15: return "complex128";
+            case 16: return "bfloat16";
+            case 0: return "non-tensor";
+            default: return QString("type%1").arg(elemType);
+        }
+    }
+
+    QString describe(const ValueInfo &value) {
+        auto text = QString("%1: %2").arg(QString::fromStdString(value.name), elemTypeName(value.elemType));
+        if (value.hasShape) {
+            QStringList dims;
+            for (std::size_t i = 0; i < value.shape.size(); ++i) {
+                if (value.shape[i] >= 0) {
+                    dims << QString::number(value.shape[i]);
+                }
+                else {
+                    dims << (value.dimParams[i].empty() ? QString("?") : QString::fromStdString(value.dimParams[i]));
+                }
+            }
+            text += '[' + dims.join(", ") + ']';
+        }
+        return text;
+    }
+
+    QString describe(const ModelInfo &info) {
+        QStringList lines;
+        lines << QString("Opset %1, IR version %2").arg(info.opsetVersion()).arg(info.irVersion);
+        if (!info.producerName.empty()) {
+            lines << QString("Producer: %1 %2").arg(QString::fromStdString(info.producerName),
+                                                   QString::fromStdString(info.producerVersion)).trimmed();
+        }
+        for (const auto &input : info.inputs) {
+            lines << "Input " + describe(input);
+        }
+        for (const auto &output : info.outputs) {
+            lines << "Output " + describe(output);
+        }
+        for (const auto &[key, value] : info.metadata) {
+            lines << QString("%1 = %2").arg(QString::fromStdString(key), QString::fromStdString(value));
+        }
+        if (info.hasExternalData) {
+            lines << "Weights in external data files";
+        }
+        return lines.join('\n');
+    }
+
+    QJsonObject toJson(const ModelInfo &info) {
+        QJsonObject object;
+        object["ir_version"] = static_cast<qint64>(info.irVersion);
+        object["producer_name"] = QString::fromStdString(info.producerName);
+        object["producer_version"] = QString::fromStdString(info.producerVersion);
+        object["domain"] = QString::fromStdString(info.domain);
+        object["model_version"] = static_cast<qint64>(info.modelVersion);
+        QJsonObject opsets;
+        for (const auto &[opsetDomain, version] : info.opsets) {
+            opsets[QString::fromStdString(opsetDomain)] = static_cast<qint64>(version);
+        }
+        object["opsets"] = opsets;
+        QJsonArray inputs, outputs;
+        for (const auto &input : info.inputs) {
+            inputs.append(valueToJson(input));
+        }
+        for (const auto &output : info.outputs) {
+            outputs.append(valueToJson(output));
+        }
+        object["inputs"] = inputs;
+        object["outputs"] = outputs;
+        QJsonArray metadata;
+        for (const auto &[key, value] : info.metadata) {
+            metadata.append(QJsonArray{QString::fromStdString(key), QString::fromStdString(value)});
+        }
+        object["metadata"] = metadata;
+        object["initializers"] = static_cast<qint64>(info.initializerCount);
+        object["external_data"] = info.hasExternalData;
+        return object;
+    }
+
+    ModelInfo modelInfoFromJson(const QJsonObject &object) {
+        ModelInfo info;
+        info.irVersion = static_cast<std::int64_t>(object["ir_version"].toDouble());
+        info.producerName = object["producer_name"].toString().toStdString();
+        info.producerVersion = object["producer_version"].toString().toStdString();
+        info.domain = object["domain"].toString().toStdString();
+        info.modelVersion = static_cast<std::int64_t>(object["model_version"].toDouble());
+        auto opsets = object["opsets"].toObject();
+        for (auto it = opsets.begin(); it != opsets.end(); ++it) {
+            info.opsets.emplace_back(it.key().toStdString(), static_cast<std::int64_t>(it.value().toDouble()));
+        }
+        for (const auto &input : object["inputs"].toArray()) {
+            info.inputs.push_back(valueFromJson(input.toObject()));
+        }
+        for (const auto &output : object["outputs"].toArray()) {
+            info.outputs.push_back(valueFromJson(output.toObject()));
+        }
+        for (const auto &entry : object["metadata"].toArray()) {
+            auto pair = entry.toArray();
+            info.metadata.emplace_back(pair.at(0).toString().toStdString(), pair.at(1).toString().toStdString());
+        }
+        info.initializerCount = static_cast<std::size_t>(object["initializers"].toDouble());
+        info.hasExternalData = object["external_data"].toBool();
+        return info;
+    }
+
+}  // namespace some::onnx
@@ -0,0 +1,62 @@
+#ifndef SOME_GUI_ONNXMODELINFO_H
+#define SOME_GUI_ONNXMODELINFO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QJsonObject>
+#include <QString>
+
+namespace some::onnx {
+
+    // A graph input or output.
+    struct ValueInfo {
+        std::string name;
+        int elemType = 0;  // TensorProto.DataType; 0 if not a tensor
+        bool hasShape = false;
+        // -1 for a dynamic dimension; its symbolic name, if any, is in dimParams.
+        std::vector<std::int64_t> shape;
+        std::vector<std::string> dimParams;
+    };
+
+    // What a model declares about itself, read from the ModelProto without creating a session.
+    struct ModelInfo {
+        std::int64_t irVersion = 0;
+        std::string producerName;
+        std::string producerVersion;
+        std::string domain;
+        std::int64_t modelVersion = 0;
+        // Operator set imports: (domain, version). The default domain is "" or "ai.onnx".
+        std::vector<std::pair<std::string, std::int64_t>> opsets;
+        // Graph inputs without the initializers that older exporters also list as inputs.
+        std::vector<ValueInfo> inputs;
+        std::vector<ValueInfo> outputs;
+        std::vector<std::pair<std::string, std::string>> metadata;
+        std::size_t initializerCount = 0;
+        bool hasExternalData = false;
+
+        // Version of the default operator set, or 0 if it is not imported.
+        std::int64_t opsetVersion() const;
+    };
+
+    // Parses a serialized ModelProto. Returns false if it is malformed or has no graph.
+    bool readModelInfo(const char *data, std::size_t size, ModelInfo &info);
+    // Maps the file and parses it. Large embedded weights are skipped, not read.
+    bool readModelInfoFile(const QString &path, ModelInfo &info, QString *errorMessage = nullptr);
+
+    // Name of a TensorProto.DataType, e.g. "float32".
+    QString elemTypeName(int elemType);
+    // e.g. "waveform: float32[1, n_samples]"
+    QString describe(const ValueInfo &value);
+    // Multi-line summary for tool tips and logs.
+    QString describe(const ModelInfo &info);
+
+    QJsonObject toJson(const ModelInfo &info);
+    ModelInfo modelInfoFromJson(const QJsonObject &object);
+
+}  // namespace some::onnx
+
+#endif //SOME_GUI_ONNXMODELINFO_H
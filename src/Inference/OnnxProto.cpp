@@ -0,0 +1,233 @@
+#include <exception>
+
+#include "OnnxProto.h"
+
+namespace some::onnx {
+
+    namespace {
+        using namespace field;
+
+        bool readTensor(const ProtoReader &tensorMessage, ExternalTensor &tensor, bool &external) {
+            auto reader = tensorMessage;
+            external = false;
+            while (reader.next()) {
+                switch (reader.field()) {
+                    case kTensorDims:
+                        reader.appendVarints(tensor.dims);
+                        break;
+                    case kTensorDataType:
+                        tensor.dataType = static_cast<int>(reader.varint());
+                        break;
+                    case kTensorName:
+                        tensor.name = reader.string();
+                        break;
+                    case kTensorDataLocation:
+                        external = (reader.varint() == kDataLocationExternal);
+                        break;
+                    case kTensorExternalData: {
+                        std::string key, value;
+                        auto entry = reader.message();
+                        while (entry.next()) {
+                            if (entry.field() == kEntryKey) {
+                                key = entry.string();
+                            }
+                            else if (entry.field() == kEntryValue) {
+                                value = entry.string();
+                            }
+                        }
+                        if (key == "location") {
+                            tensor.location = value;
+                        }
+                        else if (key == "offset") {
+                            tensor.offset = std::stoull(value);
+                        }
+                        else if (key == "length") {
+                            tensor.length = std::stoull(value);
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+            return !reader.hasError();
+        }
+    }
+
+    ProtoReader::ProtoReader(const char *data, std::size_t size) : m_pos(data), m_end(data + size) {}
+
+    bool ProtoReader::next() {
+        if (m_error || m_pos >= m_end) {
+            return false;
+        }
+        std::uint64_t key;
+        if (!readVarint(key)) {
+            return false;
+        }
+        m_field = static_cast<std::uint32_t>(key >> 3);
+        m_wireType = static_cast<int>(key & 7);
+        switch (m_wireType) {
+            case Varint:
+                return readVarint(m_varint);
+            case Fixed64:
+            case Fixed32: {
+                std::size_t width = (m_wireType == Fixed64) ? 8 : 4;
+                if (static_cast<std::size_t>(m_end - m_pos) < width) {
+                    m_error = true;
+                    return false;
+                }
+                m_value = m_pos;
+                m_valueSize = width;
+                m_pos += width;
+                return true;
+            }
+            case LengthDelimited: {
+                std::uint64_t length;
+                if (!readVarint(length) || length > static_cast<std::uint64_t>(m_end - m_pos)) {
+                    m_error = true;
+                    return false;
+                }
+                m_value = m_pos;
+                m_valueSize = static_cast<std::size_t>(length);
+                m_pos += length;
+                return true;
+            }
+            default:
+                // Groups are deprecated and never used by ONNX.
+                m_error = true;
+                return false;
+        }
+    }
+
+    bool ProtoReader::hasError() const {
+        return m_error;
+    }
+
+    std::uint32_t ProtoReader::field() const {
+        return m_field;
+    }
+
+    int ProtoReader::wireType() const {
+        return m_wireType;
+    }
+
+    std::uint64_t ProtoReader::varint() const {
+        return m_wireType == Varint ? m_varint : 0;
+    }
+
+    ProtoReader ProtoReader::message() const {
+        if (m_wireType != LengthDelimited) {
+            return {};
+        }
+        return {m_value, m_valueSize};
+    }
+
+    std::string ProtoReader::string() const {
+        if (m_wireType != LengthDelimited) {
+            return {};
+        }
+        return {m_value, m_valueSize};
+    }
+
+    const char *ProtoReader::data() const {
+        return m_value;
+    }
+
+    std::size_t ProtoReader::size() const {
+        return m_valueSize;
+    }
+
+    void ProtoReader::appendVarints(std::vector<std::int64_t> &values) const {
+        if (m_wireType == Varint) {
+            values.push_back(static_cast<std::int64_t>(m_varint));
+        }
+        else if (m_wireType == LengthDelimited) {
+            ProtoReader packed(m_value, m_valueSize);
+            std::uint64_t value;
+            while (packed.m_pos < packed.m_end && packed.readVarint(value)) {
+                values.push_back(static_cast<std::int64_t>(value));
+            }
+        }
+    }
+
+    bool ProtoReader::readVarint(std::uint64_t &value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (m_pos >= m_end) {
+                break;
+            }
+            auto byte = static_cast<unsigned char>(*m_pos++);
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        m_error = true;
+        return false;
+    }
+
+    std::size_t elementSize(int dataType) {
+        switch (dataType) {
+            case 2:   // UINT8
+            case 3:   // INT8
+            case 9:   // BOOL
+            case 17:  // FLOAT8E4M3FN
+            case 18:  // FLOAT8E4M3FNUZ
+            case 19:  // FLOAT8E5M2
+            case 20:  // FLOAT8E5M2FNUZ
+                return 1;
+            case 4:   // UINT16
+            case 5:   // INT16
+            case 10:  // FLOAT16
+            case 16:  // BFLOAT16
+                return 2;
+            case 1:   // FLOAT
+            case 6:   // INT32
+            case 12:  // UINT32
+                return 4;
+            case 7:   // INT64
+            case 11:  // DOUBLE
+            case 13:  // UINT64
+            case 14:  // COMPLEX64
+                return 8;
+            case 15:  // COMPLEX128
+                return 16;
+            default:  // STRING, UNDEFINED
+                return 0;
+        }
+    }
+
+    bool readExternalTensors(const char *data, std::size_t size, std::vector<ExternalTensor> &tensors) {
+        ProtoReader model(data, size);
+        while (model.next()) {
+            if (model.field() != kModelGraph || model.wireType() != ProtoReader::LengthDelimited) {
+                continue;
+            }
+            auto graph = model.message();
+            while (graph.next()) {
+                if (graph.field() != kGraphInitializer || graph.wireType() != ProtoReader::LengthDelimited) {
+                    continue;
+                }
+                ExternalTensor tensor;
+                bool external;
+                try {
+                    if (!readTensor(graph.message(), tensor, external)) {
+                        return false;
+                    }
+                }
+                catch (const std::exception &) {
+                    // Non-numeric offset or length
+                    return false;
+                }
+                if (external) {
+                    tensors.push_back(std::move(tensor));
+                }
+            }
+            if (graph.hasError()) {
+                return false;
+            }
+        }
+        return !model.hasError();
+    }
+
+}  // namespace some::onnx
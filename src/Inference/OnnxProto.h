@@ -0,0 +1,113 @@
+#ifndef SOME_GUI_ONNXPROTO_H
+#define SOME_GUI_ONNXPROTO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace some::onnx {
+
+    // Minimal reader for the protobuf wire format, enough to walk an ONNX model without linking
+    // protobuf. It never copies: strings and sub-messages point into the original buffer.
+    class ProtoReader {
+    public:
+        enum WireType {
+            Varint = 0,
+            Fixed64 = 1,
+            LengthDelimited = 2,
+            Fixed32 = 5,
+        };
+
+        ProtoReader() = default;
+        ProtoReader(const char *data, std::size_t size);
+
+        // Advances to the next field. Returns false at the end of the message or on malformed input.
+        bool next();
+        bool hasError() const;
+
+        std::uint32_t field() const;
+        int wireType() const;
+
+        // Value of the current field. Only meaningful for the matching wire type.
+        std::uint64_t varint() const;
+        ProtoReader message() const;
+        std::string string() const;
+        const char *data() const;
+        std::size_t size() const;
+
+        // Elements of a repeated varint field, packed or not, appended to `values`.
+        void appendVarints(std::vector<std::int64_t> &values) const;
+
+    private:
+        bool readVarint(std::uint64_t &value);
+
+        const char *m_pos = nullptr;
+        const char *m_end = nullptr;
+        bool m_error = false;
+
+        std::uint32_t m_field = 0;
+        int m_wireType = 0;
+        std::uint64_t m_varint = 0;
+        const char *m_value = nullptr;
+        std::size_t m_valueSize = 0;
+    };  // class ProtoReader
+
+    // Field numbers from onnx.proto, for the messages SOME reads.
+    namespace field {
+        constexpr std::uint32_t kModelIrVersion = 1;
+        constexpr std::uint32_t kModelProducerName = 2;
+        constexpr std::uint32_t kModelProducerVersion = 3;
+        constexpr std::uint32_t kModelDomain = 4;
+        constexpr std::uint32_t kModelVersion = 5;
+        constexpr std::uint32_t kModelGraph = 7;
+        constexpr std::uint32_t kModelOpsetImport = 8;
+        constexpr std::uint32_t kModelMetadataProps = 14;
+
+        constexpr std::uint32_t kOpsetDomain = 1;
+        constexpr std::uint32_t kOpsetVersion = 2;
+
+        constexpr std::uint32_t kEntryKey = 1;
+        constexpr std::uint32_t kEntryValue = 2;
+
+        constexpr std::uint32_t kGraphInitializer = 5;
+        constexpr std::uint32_t kGraphInput = 11;
+        constexpr std::uint32_t kGraphOutput = 12;
+
+        constexpr std::uint32_t kTensorDims = 1;
+        constexpr std::uint32_t kTensorDataType = 2;
+        constexpr std::uint32_t kTensorName = 8;
+        constexpr std::uint32_t kTensorExternalData = 13;
+        constexpr std::uint32_t kTensorDataLocation = 14;
+        constexpr std::uint64_t kDataLocationExternal = 1;
+
+        constexpr std::uint32_t kValueInfoName = 1;
+        constexpr std::uint32_t kValueInfoType = 2;
+        constexpr std::uint32_t kTypeTensorType = 1;
+        constexpr std::uint32_t kTensorTypeElemType = 1;
+        constexpr std::uint32_t kTensorTypeShape = 2;
+        constexpr std::uint32_t kShapeDim = 1;
+        constexpr std::uint32_t kDimValue = 1;
+        constexpr std::uint32_t kDimParam = 2;
+    }  // namespace field
+
+    // An initializer whose data lives in a separate file (TensorProto.data_location == EXTERNAL).
+    struct ExternalTensor {
+        std::string name;
+        int dataType = 0;  // TensorProto.DataType, same values as ONNXTensorElementDataType
+        std::vector<std::int64_t> dims;
+        std::string location;  // relative to the model directory
+        std::uint64_t offset = 0;
+        std::uint64_t length = 0;  // 0: to the end of the file
+    };
+
+    // Size in bytes of one element of a TensorProto.DataType, or 0 for strings and unknown types.
+    std::size_t elementSize(int dataType);
+
+    // The external initializers of the main graph of a serialized ModelProto.
+    // Returns false if the buffer is not a valid model.
+    bool readExternalTensors(const char *data, std::size_t size, std::vector<ExternalTensor> &tensors);
+
+}  // namespace some::onnx
+
+#endif //SOME_GUI_ONNXPROTO_H
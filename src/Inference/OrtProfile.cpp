@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <unordered_map>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+#include "OrtProfile.h"
+
+namespace some {
+
+    namespace {
+        // Node events are also written for the fences around a kernel; only the kernel is counted.
+        constexpr char kKernelSuffix[] = "_kernel_time";
+
+        void addTime(std::unordered_map<std::string, OrtProfileSummary::OpTime> &times, const std::string &key,
+                     const std::string &opType, const std::string &provider, double ms) {
+            auto &time = times[key];
+            if (time.name.empty()) {
+                time.name = key;
+                time.opType = opType;
+                time.provider = provider;
+            }
+            ++time.calls;
+            time.totalMs += ms;
+        }
+
+        std::vector<OrtProfileSummary::OpTime> sortedTimes(
+                std::unordered_map<std::string, OrtProfileSummary::OpTime> &times) {
+            std::vector<OrtProfileSummary::OpTime> sorted;
+            sorted.reserve(times.size());
+            for (auto &entry : times) {
+                sorted.push_back(std::move(entry.second));
+            }
+            std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+                return a.totalMs > b.totalMs || (a.totalMs == b.totalMs && a.name < b.name);
+            });
+            return sorted;
+        }
+    }
+
+    bool readOrtProfile(const QString &path, const std::vector<std::int64_t> &runInputLengths, double sampleRate,
+                        OrtProfileSummary &summary, QString *errorMessage, double bucketSeconds) {
+        auto fail = [errorMessage](const QString &message) {
+            if (errorMessage) {
+                *errorMessage = message;
+            }
+            return false;
+        };
+        summary = {};
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return fail(file.errorString());
+        }
+        QJsonParseError parseError {};
+        auto document = QJsonDocument::fromJson(file.readAll(), &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            return fail(parseError.errorString());
+        }
+        if (!document.isArray()) {
+            return fail("Not an ONNX Runtime profile.");
+        }
+
+        std::unordered_map<std::string, OrtProfileSummary::OpTime> nodes, opTypes, providers;
+        std::map<std::int64_t, OrtProfileSummary::BucketTime> buckets;
+        const auto suffixLength = sizeof(kKernelSuffix) - 1;
+        for (const auto &value : document.array()) {
+            auto event = value.toObject();
+            auto category = event["cat"].toString();
+            auto name = event["name"].toString().toStdString();
+            // Durations are in microseconds.
+            double ms = event["dur"].toDouble() / 1000.0;
+            if (category == "Session" && name == "model_run") {
+                auto run = summary.runs++;
+                summary.runMs += ms;
+                if (run < runInputLengths.size() && sampleRate > 0 && bucketSeconds > 0) {
+                    double seconds = static_cast<double>(runInputLengths[run]) / sampleRate;
+                    auto index = static_cast<std::int64_t>(std::floor(seconds / bucketSeconds));
+                    auto &bucket = buckets[index];
+                    bucket.minSeconds = static_cast<double>(index) * bucketSeconds;
+                    bucket.maxSeconds = bucket.minSeconds + bucketSeconds;
+                    ++bucket.runs;
+                    bucket.audioSeconds += seconds;
+                    bucket.totalMs += ms;
+                }
+            }
+            else if (category == "Node" && name.size() > suffixLength &&
+                     name.compare(name.size() - suffixLength, suffixLength, kKernelSuffix) == 0) {
+                auto args = event["args"].toObject();
+                auto opType = args["op_name"].toString().toStdString();
+                auto provider = args["provider"].toString().toStdString();
+                summary.kernelMs += ms;
+                addTime(nodes, name.substr(0, name.size() - suffixLength), opType, provider, ms);
+                addTime(opTypes, opType, opType, {}, ms);
+                addTime(providers, provider, {}, provider, ms);
+            }
+        }
+        summary.nodes = sortedTimes(nodes);
+        summary.opTypes = sortedTimes(opTypes);
+        summary.providers = sortedTimes(providers);
+        for (const auto &entry : buckets) {
+            summary.buckets.push_back(entry.second);
+        }
+        return true;
+    }
+
+    QString OrtProfileSummary::describe(std::size_t topNodes) const {
+        QStringList lines;
+        auto share = [this](double ms) {
+            return kernelMs > 0 ? 100.0 * ms / kernelMs : 0.0;
+        };
+        lines << QString("%1 runs in %2 ms, %3 ms of them in kernels.")
+                .arg(runs).arg(runMs, 0, 'f', 1).arg(kernelMs, 0, 'f', 1);
+
+        lines << "" << QString("Slowest %1 of %2 nodes:").arg(std::min(topNodes, nodes.size())).arg(nodes.size());
+        lines << QString("%1 %2 %3 %4 %5 %6")
+                .arg("node", -40).arg("op type", -20).arg("provider", -28)
+                .arg("calls", 7).arg("total(ms)", 11).arg("share", 7);
+        for (std::size_t i = 0; i < nodes.size() && i < topNodes; ++i) {
+            const auto &node = nodes[i];
+            lines << QString("%1 %2 %3 %4 %5 %6%")
+                    .arg(QString::fromStdString(node.name), -40)
+                    .arg(QString::fromStdString(node.opType), -20)
+                    .arg(QString::fromStdString(node.provider), -28)
+                    .arg(node.calls, 7)
+                    .arg(node.totalMs, 11, 'f', 2)
+                    .arg(share(node.totalMs), 6, 'f', 1);
+        }
+
+        auto addTable = [&](const QString &title, const std::vector<OpTime> &times) {
+            lines << "" << title;
+            lines << QString("%1 %2 %3 %4").arg("", -40).arg("calls", 7).arg("total(ms)", 11).arg("share", 7);
+            for (const auto &time : times) {
+                lines << QString("%1 %2 %3 %4%")
+                        .arg(QString::fromStdString(time.name), -40)
+                        .arg(time.calls, 7)
+                        .arg(time.totalMs, 11, 'f', 2)
+                        .arg(share(time.totalMs), 6, 'f', 1);
+            }
+        };
+        addTable("Time per op type:", opTypes);
+        addTable("Time per execution provider:", providers);
+
+        lines << "" << "Time per chunk length:";
+        lines << QString("%1 %2 %3 %4 %5 %6")
+                .arg("length(s)", -12).arg("runs", 6).arg("audio(s)", 10).arg("total(ms)", 11)
+                .arg("ms/run", 10).arg("ms/audio s", 11);
+        for (const auto &bucket : buckets) {
+            lines << QString("%1 %2 %3 %4 %5 %6")
+                    .arg(QString("%1-%2").arg(bucket.minSeconds).arg(bucket.maxSeconds), -12)
+                    .arg(bucket.runs, 6)
+                    .arg(bucket.audioSeconds, 10, 'f', 2)
+                    .arg(bucket.totalMs, 11, 'f', 1)
+                    .arg(bucket.runs ? bucket.totalMs / bucket.runs : 0.0, 10, 'f', 1)
+                    .arg(bucket.audioSeconds > 0 ? bucket.totalMs / bucket.audioSeconds : 0.0, 11, 'f', 1);
+        }
+        return lines.join('\n');
+    }
+
+}  // namespace some
@@ -0,0 +1,52 @@
+#ifndef SOME_GUI_ORTPROFILE_H
+#define SOME_GUI_ORTPROFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <QString>
+
+namespace some {
+
+    // Where the time of the runs in an ONNX Runtime profile went (SessionOptions::EnableProfiling).
+    struct OrtProfileSummary {
+        struct OpTime {
+            std::string name;  // node name, op type or provider
+            std::string opType;
+            std::string provider;
+            std::size_t calls = 0;
+            double totalMs = 0.0;
+        };
+        struct BucketTime {
+            double minSeconds = 0.0;  // input length of the runs, [minSeconds, maxSeconds)
+            double maxSeconds = 0.0;
+            std::size_t runs = 0;
+            double audioSeconds = 0.0;
+            double totalMs = 0.0;
+        };
+
+        std::size_t runs = 0;
+        double runMs = 0.0;  // sum of the model_run events
+        double kernelMs = 0.0;  // sum of the node kernels; the rest is spent between them
+        // Sorted by total time, longest first.
+        std::vector<OpTime> nodes;
+        std::vector<OpTime> opTypes;
+        std::vector<OpTime> providers;
+        // Sorted by length.
+        std::vector<BucketTime> buckets;
+
+        // The `topNodes` slowest nodes, then every op type, provider and bucket, as plain text.
+        QString describe(std::size_t topNodes = 25) const;
+    };
+
+    // Reads the profile JSON written by ONNX Runtime. `runInputLengths` has the input length in
+    // samples of each run, in run order, to group the runs by chunk length in buckets of
+    // `bucketSeconds`; runs without a length are left out of the buckets.
+    bool readOrtProfile(const QString &path, const std::vector<std::int64_t> &runInputLengths, double sampleRate,
+                        OrtProfileSummary &summary, QString *errorMessage = nullptr, double bucketSeconds = 5.0);
+
+}  // namespace some
+
+#endif //SOME_GUI_ORTPROFILE_H
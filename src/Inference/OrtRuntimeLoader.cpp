@@ -0,0 +1,62 @@
+#include <chrono>
+
+#include <QLibrary>
+
+#include <onnxruntime_cxx_api.h>
+
+#include "OrtLoader.h"
+#include "OrtRuntimeLoader.h"
+
+namespace some {
+
+    OrtRuntimeLoader::OrtRuntimeLoader(QObject *parent) : QThread(parent) {}
+
+    bool OrtRuntimeLoader::isOk() const {
+        return m_ok;
+    }
+
+    QString OrtRuntimeLoader::errorString() const {
+        return m_errorString;
+    }
+
+    QStringList OrtRuntimeLoader::providers() const {
+        return m_providers;
+    }
+
+    double OrtRuntimeLoader::loadSeconds() const {
+        return m_loadSeconds;
+    }
+
+    void OrtRuntimeLoader::run() {
+        // The members are only written here and only read after loaded(), which is queued to the
+        // receiver after this function has returned.
+        auto start = std::chrono::steady_clock::now();
+        m_ok = InitOrtLibrary(&m_errorString);
+        if (m_ok) {
+            try {
+                for (const auto &provider : Ort::GetAvailableProviders()) {
+                    m_providers << QString::fromStdString(provider);
+                }
+            }
+            catch (const Ort::Exception &ortException) {
+                m_ok = false;
+                m_errorString = QString("[ONNXRuntimeError] : %1 : %2")
+                        .arg(ortException.GetOrtErrorCode())
+                        .arg(ortException.what());
+            }
+        }
+#ifdef ONNXRUNTIME_ENABLE_CUDA
+        // ONNX Runtime opens the CUDA provider library (and cuDNN, cuBLAS behind it) when the first
+        // CUDA session is created. Opening it now moves that wait off the Start button; the loader
+        // reuses the already mapped library later. Failing here is not an error, the session
+        // reports it and falls back to CPU.
+        if (m_ok && m_providers.contains("CUDAExecutionProvider")) {
+            QLibrary cudaProvider("onnxruntime_providers_cuda");
+            cudaProvider.load();  // stays loaded: QLibrary does not unload on destruction
+        }
+#endif
+        m_loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        Q_EMIT loaded(m_ok);
+    }
+
+}  // namespace some
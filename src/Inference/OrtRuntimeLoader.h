@@ -0,0 +1,40 @@
+#ifndef SOME_GUI_ORTRUNTIMELOADER_H
+#define SOME_GUI_ORTRUNTIMELOADER_H
+
+#include <QString>
+#include <QStringList>
+#include <QThread>
+
+namespace some {
+
+    // Loads and initializes ONNX Runtime on a background thread, so the window can appear while
+    // the library (and, in CUDA builds, the CUDA provider library) is read from disk. Also asks
+    // ONNX Runtime which execution providers it was built with. The results are valid once
+    // loaded() has been emitted.
+    class OrtRuntimeLoader : public QThread {
+        Q_OBJECT
+    public:
+        explicit OrtRuntimeLoader(QObject *parent = nullptr);
+
+        bool isOk() const;
+        QString errorString() const;
+        // Execution providers available in the loaded library, e.g. "CPUExecutionProvider".
+        QStringList providers() const;
+        double loadSeconds() const;
+
+    Q_SIGNALS:
+        void loaded(bool ok);
+
+    protected:
+        void run() override;
+
+    private:
+        bool m_ok = false;
+        QString m_errorString;
+        QStringList m_providers;
+        double m_loadSeconds = 0.0;
+    };  // class OrtRuntimeLoader
+
+}  // namespace some
+
+#endif //SOME_GUI_ORTRUNTIMELOADER_H
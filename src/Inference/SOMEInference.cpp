@@ -1,9 +1,46 @@
+#include <algorithm>
+#include <chrono>
 #include <limits>
 
+#include <QFile>
+#include <QFileInfo>
+
+#include "Utils/ProcessMemory.h"
+#include "OrtProfile.h"
 #include "SOMEInference.h"
 #include "InferenceUtils.hpp"
 
 namespace some {
+    namespace {
+        // Sample rate SOME models expect; note durations are in seconds.
+        constexpr double kModelSampleRate = 44100.0;
+        constexpr std::size_t kGrowthThreshold = 1024 * 1024;
+
+        double percentile(std::vector<double> values, double p) {
+            if (values.empty()) {
+                return 0.0;
+            }
+            auto index = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+            std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+            return values[index];
+        }
+    }
+
+    QString InferenceRunStats::summary() const {
+        double padding = inputSamples > 0 ? 100.0 * static_cast<double>(paddedSamples) / inputSamples : 0.0;
+        double growth = (static_cast<double>(privateAfter) - static_cast<double>(privateBefore)) / (1024.0 * 1024.0);
+        return QString("%1 runs, %2 input lengths, padding %3%, latency p50 %4 ms, p95 %5 ms, max %6 ms, "
+                       "private memory +%7 MB in %8 steps")
+                .arg(latencyMs.size())
+                .arg(inputLengths.size())
+                .arg(padding, 0, 'f', 1)
+                .arg(percentile(latencyMs, 0.5), 0, 'f', 1)
+                .arg(percentile(latencyMs, 0.95), 0, 'f', 1)
+                .arg(latencyMs.empty() ? 0.0 : *std::max_element(latencyMs.begin(), latencyMs.end()), 0, 'f', 1)
+                .arg(growth, 0, 'f', 1)
+                .arg(growthSteps);
+    }
+
     SOMEInference::SOMEInference(const QString &modelPath, QObject *parent)
             : Inference(modelPath, parent), m_supportBatch(false) {}
 
@@ -11,7 +48,15 @@ namespace some {
         return infer(waveform, static_cast<size_t>(0), waveform.size());
     }
 
+    void SOMEInference::cancel() {
+        m_cancelled = true;
+        m_runOptions.SetTerminate();
+    }
+
     Notes SOMEInference::infer(const std::vector<float> &waveform, size_t begin, size_t count) {
+        if (m_cancelled) {
+            return {};
+        }
         if (!m_session) {
             logMsgError("Session is not initialized!");
             return {};
@@ -45,15 +90,24 @@ namespace some {
 
         // waveform
 
+        if (count > kInt64Max) {
+            count = kInt64Max;
+        }
+        // The samples after the chunk belong to the next one, so the padding is a copy with zeros.
+        const float *input = waveform.data() + begin;
+        size_t inputLength = m_lengthBuckets.bucketFor(count);
+        if (inputLength > count) {
+            m_paddedInput.assign(input, input + count);
+            m_paddedInput.resize(inputLength, 0.0f);
+            recordCopy(count * sizeof(float));
+            input = m_paddedInput.data();
+        }
         {
-            if (count > kInt64Max) {
-                count = kInt64Max;
-            }
-            std::vector<int64_t> inputShape = {1, static_cast<int64_t>(count)};
+            std::vector<int64_t> inputShape = {1, static_cast<int64_t>(inputLength)};
             inputTensors.emplace_back(Ort::Value::CreateTensor<float>(
                     allocator.GetInfo(),
-                    const_cast<float *>(waveform.data() + begin),
-                    count,
+                    const_cast<float *>(input),
+                    inputLength,
                     inputShape.data(),
                     inputShape.size()
             ));
@@ -63,10 +117,16 @@ namespace some {
         // Create output names
         std::vector<const char *> outputNames = { "note_midi", "note_rest", "note_dur" };
 
+        if (m_runStats.latencyMs.empty()) {
+            m_runStats.privateBefore = getProcessMemory().privateResident;
+            m_runStats.privateAfter = m_runStats.privateBefore;
+        }
+        auto runStart = std::chrono::steady_clock::now();
+
         try {
             // Run the session
             auto outputTensors = m_session.Run(
-                    Ort::RunOptions{},
+                    m_runOptions,
                     inputNames.data(),
                     inputTensors.data(),
                     inputNames.size(),
@@ -90,12 +150,30 @@ namespace some {
                 auto dataPtr = note_dur.GetTensorData<float>();
                 notes.note_dur = std::vector<float>(dataPtr, dataPtr + note_dur.GetTensorTypeAndShapeInfo().GetElementCount());
             }
+            if (inputLength > count) {
+                trimNotes(notes, static_cast<double>(count) / kModelSampleRate);
+            }
+
+            std::chrono::duration<double, std::milli> latency = std::chrono::steady_clock::now() - runStart;
+            auto privateNow = getProcessMemory().privateResident;
+            m_runStats.latencyMs.push_back(latency.count());
+            m_runStats.runInputLengths.push_back(static_cast<int64_t>(inputLength));
+            m_runStats.inputSamples += count;
+            m_runStats.paddedSamples += inputLength - count;
+            m_runStats.inputLengths.insert(static_cast<int64_t>(inputLength));
+            if (privateNow > m_runStats.privateAfter + kGrowthThreshold) {
+                ++m_runStats.growthSteps;
+            }
+            m_runStats.privateAfter = std::max(m_runStats.privateAfter, privateNow);
             return notes;
         }
         catch (const Ort::Exception &ortException) {
-            Q_EMIT logMsgError(QString("[ONNXRuntimeError] : %1 : %2")
-                                       .arg(ortException.GetOrtErrorCode())
-                                       .arg(ortException.what()));
+            // A terminated run is not an error.
+            if (!m_cancelled) {
+                Q_EMIT logMsgError(QString("[ONNXRuntimeError] : %1 : %2")
+                                           .arg(ortException.GetOrtErrorCode())
+                                           .arg(ortException.what()));
+            }
         }
         return {};
     }
@@ -119,7 +197,7 @@ namespace some {
             return false;
         }
         auto inputShape = m_session.GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
-        if (inputShape.size() != 2 && inputShape[0] != 1 && inputShape[0] != -1 && inputShape[1] != -1) {
+        if (inputShape.size() != 2 || (inputShape[0] != 1 && inputShape[0] != -1) || inputShape[1] != -1) {
             endSession();
             QString errMsg = "Invalid model! The input shape should be 2 dimensions. "
                              "The first dimension should be 1 or dynamic, "
@@ -140,6 +218,33 @@ namespace some {
     }
 
 
+    QString SOMEInference::checkModelInfo(const onnx::ModelInfo &info) {
+        if (info.inputs.size() != 1) {
+            return QString("The input count should be 1, but the model has %1.").arg(info.inputs.size());
+        }
+        const auto &input = info.inputs.front();
+        if (input.name != "waveform") {
+            return "The model should contain input name `waveform`.";
+        }
+        if (input.elemType != 1) {
+            return QString("Input `waveform` should be float32, but it is %1.").arg(onnx::elemTypeName(input.elemType));
+        }
+        // Without shape information the session check decides.
+        if (input.hasShape &&
+            (input.shape.size() != 2 || (input.shape[0] != 1 && input.shape[0] != -1) || input.shape[1] != -1)) {
+            return QString("The input shape should be [1 or dynamic, dynamic]. Actual: %1").arg(onnx::describe(input));
+        }
+        for (const char *name : {"note_midi", "note_rest", "note_dur"}) {
+            bool found = std::any_of(info.outputs.begin(), info.outputs.end(), [name](const onnx::ValueInfo &output) {
+                return output.name == name;
+            });
+            if (!found) {
+                return QString("The model should contain output name `%1`.").arg(name);
+            }
+        }
+        return {};
+    }
+
     void SOMEInference::postCleanup() {
         m_supportBatch = false;
     }
@@ -147,4 +252,46 @@ namespace some {
     bool SOMEInference::supportBatch() const {
         return m_supportBatch;
     }
+
+    void SOMEInference::setLengthBuckets(const LengthBucketOptions &options) {
+        m_lengthBuckets = LengthBuckets(options);
+        if (!options.enabled) {
+            m_paddedInput = {};
+        }
+    }
+
+    const InferenceRunStats &SOMEInference::runStats() const {
+        return m_runStats;
+    }
+
+    void SOMEInference::resetRunStats() {
+        m_runStats = {};
+    }
+
+    bool SOMEInference::writeProfileSummary(const QString &summaryPath) {
+        auto profilePath = endProfiling();
+        if (profilePath.isEmpty()) {
+            Q_EMIT logMsgError("The session was not profiled.");
+            return false;
+        }
+        // The profile lists the runs in the order they were made, like the run stats.
+        OrtProfileSummary summary;
+        QString errorMessage;
+        if (!readOrtProfile(profilePath, m_runStats.runInputLengths, kModelSampleRate, summary, &errorMessage)) {
+            Q_EMIT logMsgError(QString("Could not read the ONNX Runtime profile %1: %2").arg(profilePath, errorMessage));
+            return false;
+        }
+        QFile file(summaryPath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            Q_EMIT logMsgError(QString("Could not write %1: %2").arg(summaryPath, file.errorString()));
+            return false;
+        }
+        auto text = QString("ONNX Runtime profile of %1 on %2 (%3)\n\n")
+                .arg(QFileInfo(m_modelPath).fileName())
+                .arg(executionProviderName(m_activeProvider))
+                .arg(QFileInfo(profilePath).fileName());
+        file.write((text + summary.describe() + '\n').toUtf8());
+        Q_EMIT logMsgInfo(QString("ONNX Runtime profile summary written to %1").arg(summaryPath));
+        return true;
+    }
 } // namespace some
\ No newline at end of file
@@ -1,30 +1,74 @@
 #ifndef SOME_GUI_SOMEINFERENCE_H
 #define SOME_GUI_SOMEINFERENCE_H
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <set>
+#include <vector>
 
 #include <QObject>
 #include <QString>
 #include <QVector>
 
 #include "Inference.h"
+#include "InferenceBackend.h"
+#include "LengthBuckets.h"
 #include "NotesStruct.h"
+#include "OnnxModelInfo.h"
 
 namespace some {
 
-    class SOMEInference : public Inference {
+    // What the runs of a SOMEInference cost, for comparing runs with and without length buckets.
+    struct InferenceRunStats {
+        std::vector<double> latencyMs;  // one per run, in run order
+        std::vector<std::int64_t> runInputLengths;  // samples, padding included; one per run
+        std::size_t inputSamples = 0;
+        std::size_t paddedSamples = 0;  // zeros added by the length buckets
+        std::set<std::int64_t> inputLengths;  // distinct input shapes the session has seen
+        // Private memory around the runs. The growth is mostly the session's arena; it is counted as
+        // a growth step when a run leaves more than 1 MB behind.
+        std::size_t privateBefore = 0;
+        std::size_t privateAfter = 0;
+        int growthSteps = 0;
+
+        QString summary() const;
+    };
+
+    class SOMEInference : public Inference, public InferenceBackend {
         Q_OBJECT
         Q_PROPERTY(bool supportBatch READ supportBatch)
     public:
         explicit SOMEInference(const QString &modelPath, QObject *parent = nullptr);
         Notes infer(const std::vector<float> &waveform);
-        Notes infer(const std::vector<float> &waveform, size_t begin, size_t count);
+        Notes infer(const std::vector<float> &waveform, size_t begin, size_t count) override;
+        // Sets the terminate flag of the run options, which ONNX Runtime checks between kernels.
+        void cancel() override;
         bool supportBatch() const;
+
+        // Pads each chunk with zeros to its length bucket and trims the notes of the padding.
+        void setLengthBuckets(const LengthBucketOptions &options);
+        const InferenceRunStats &runStats() const;
+        void resetRunStats();
+        // Ends profiling (see SessionConfig::profilePrefix), summarizes the profile by node, op type
+        // and chunk length, and writes the summary to `summaryPath` as text. Logs the reason and
+        // returns false if the session wasn't profiled or the profile can't be read.
+        bool writeProfileSummary(const QString &summaryPath);
+
+        // Checks the interface a model declares, without creating a session.
+        // Returns an empty string if SOME can use the model, otherwise the reason.
+        static QString checkModelInfo(const onnx::ModelInfo &info);
     protected:
         bool postInitCheck() override;
         void postCleanup() override;
     private:
         bool m_supportBatch;
+        LengthBuckets m_lengthBuckets;
+        std::vector<float> m_paddedInput;
+        InferenceRunStats m_runStats;
+        // Shared by every run, so cancel() reaches a run in progress.
+        Ort::RunOptions m_runOptions;
+        std::atomic<bool> m_cancelled {false};
     };
 
 } // namespace some
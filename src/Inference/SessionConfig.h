@@ -0,0 +1,35 @@
+#ifndef SOME_GUI_SESSIONCONFIG_H
+#define SOME_GUI_SESSIONCONFIG_H
+
+#include <string>
+#include <vector>
+
+namespace some {
+
+    enum class ModelLoadMode {
+        // ONNX Runtime reads the model file into private memory.
+        Path,
+        // The model and its external data files are memory-mapped. External weights are handed to
+        // ONNX Runtime in place, so processes loading the same model share them through the page cache.
+        MemoryMap,
+    };  // enum class ModelLoadMode
+
+    // How Inference creates its ONNX Runtime session, besides the execution provider.
+    struct SessionConfig {
+        ModelLoadMode loadMode = ModelLoadMode::MemoryMap;
+        // Threads of the session's intra-op pool; 0 lets ONNX Runtime use one per core.
+        int intraOpThreads = 0;
+        // Logical CPUs of the intra-op threads, in thread order. The first one belongs to the thread
+        // that calls Run(), which pins itself; ONNX Runtime pins the others. Empty: not pinned.
+        std::vector<int> intraOpCpus;
+        // Run on the process-wide pools from Inference::initGlobalThreadPools() instead of a pool
+        // of the session's own. intraOpThreads and intraOpCpus are ignored then.
+        bool globalThreadPools = false;
+        // Turns on ONNX Runtime's profiler, which writes every kernel of every run to
+        // `<profilePrefix>_<date>_<time>.json` when Inference::endProfiling() is called. Empty: off.
+        std::string profilePrefix;
+    };
+
+}  // namespace some
+
+#endif //SOME_GUI_SESSIONCONFIG_H
@@ -0,0 +1,9 @@
+#include "JobResult.h"
+
+namespace some {
+
+    double JobResult::durationSeconds() const {
+        return stats.audioSeconds;
+    }
+
+}  // namespace some
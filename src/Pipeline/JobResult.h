@@ -0,0 +1,42 @@
+#ifndef SOME_GUI_JOBRESULT_H
+#define SOME_GUI_JOBRESULT_H
+
+#include <memory>
+#include <vector>
+
+#include <QMetaType>
+#include <QString>
+
+#include "Slicer/Slicer.h"
+#include "Inference/NotesStruct.h"
+#include "PipelineStats.h"
+
+namespace some {
+
+    using MarkerListPtr = std::shared_ptr<const MarkerList>;
+
+    // What a job produced: the chunks and their notes. The job moves its buffers in and publishes
+    // the result once; after that it is never modified, so it can be shared by pointer from any
+    // thread.
+    //
+    // The waveform is not kept: after resampleChunks() only the samples inside the markers are
+    // valid and the gaps are zeros, so it is freed with the rest of the job's buffers.
+    struct JobResult {
+        QString audioPath;
+        // Rate of the marker positions.
+        int sampleRate = 0;
+        MarkerListPtr markers;
+        // One entry per marker.
+        std::vector<NotesPtr> chunkNotes;
+        PipelineStats stats;
+
+        double durationSeconds() const;
+    };
+
+    using JobResultPtr = std::shared_ptr<const JobResult>;
+
+}  // namespace some
+
+Q_DECLARE_METATYPE(some::MarkerListPtr)
+
+#endif //SOME_GUI_JOBRESULT_H
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+#include "MemoryBudget.h"
+
+namespace some {
+
+    const char *memoryCategoryName(MemoryCategory category) {
+        switch (category) {
+            case MemoryCategory::Waveform:
+                return "waveform";
+            case MemoryCategory::Chunk:
+                return "chunk";
+            case MemoryCategory::Result:
+                return "result";
+            default:
+                return "unknown";
+        }
+    }
+
+    // Account
+
+    MemoryBudget::Account::Account(MemoryBudget &budget) : m_data(std::make_shared<Data>()) {
+        m_data->budget = &budget;
+    }
+
+    MemoryBudget &MemoryBudget::Account::budget() const {
+        return *m_data->budget;
+    }
+
+    std::size_t MemoryBudget::Account::held() const {
+        std::lock_guard<std::mutex> lock(m_data->budget->m_mutex);
+        return m_data->held;
+    }
+
+    // Reservation
+
+    MemoryBudget::Reservation::Reservation(std::shared_ptr<Account::Data> account, MemoryCategory category,
+                                           std::size_t bytes)
+            : m_account(std::move(account)), m_category(category), m_bytes(bytes) {}
+
+    MemoryBudget::Reservation::~Reservation() {
+        release();
+    }
+
+    MemoryBudget::Reservation::Reservation(Reservation &&other) noexcept
+            : m_account(std::move(other.m_account)), m_category(other.m_category), m_bytes(other.m_bytes) {
+        other.m_bytes = 0;
+    }
+
+    MemoryBudget::Reservation &MemoryBudget::Reservation::operator=(Reservation &&other) noexcept {
+        if (this != &other) {
+            release();
+            m_account = std::move(other.m_account);
+            m_category = other.m_category;
+            m_bytes = other.m_bytes;
+            other.m_bytes = 0;
+        }
+        return *this;
+    }
+
+    void MemoryBudget::Reservation::resize(std::size_t bytes) {
+        if (!m_account || bytes == m_bytes) {
+            return;
+        }
+        auto &budget = *m_account->budget;
+        if (bytes < m_bytes) {
+            budget.giveBack(*m_account, m_category, m_bytes - bytes);
+        }
+        else {
+            budget.waitAndGrant(*m_account, m_category, bytes - m_bytes);
+        }
+        m_bytes = bytes;
+    }
+
+    void MemoryBudget::Reservation::release() {
+        if (m_account && m_bytes > 0) {
+            m_account->budget->giveBack(*m_account, m_category, m_bytes);
+        }
+        m_account.reset();
+        m_bytes = 0;
+    }
+
+    std::size_t MemoryBudget::Reservation::size() const {
+        return m_bytes;
+    }
+
+    bool MemoryBudget::Reservation::isValid() const {
+        return m_account != nullptr;
+    }
+
+    // MemoryBudget
+
+    MemoryBudget::MemoryBudget(std::size_t capacity) {
+        m_stats.capacity = capacity;
+    }
+
+    MemoryBudget &MemoryBudget::global() {
+        static MemoryBudget budget([]() -> std::size_t {
+            const char *env = std::getenv("SOME_MEMORY_BUDGET_MB");
+            if (!env) {
+                return 0;
+            }
+            return static_cast<std::size_t>(std::strtoull(env, nullptr, 10)) * 1024 * 1024;
+        }());
+        return budget;
+    }
+
+    void MemoryBudget::setCapacity(std::size_t capacity) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.capacity = capacity;
+        }
+        m_released.notify_all();
+    }
+
+    std::size_t MemoryBudget::capacity() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats.capacity;
+    }
+
+    MemoryBudget::Reservation MemoryBudget::acquire(Account &account, MemoryCategory category, std::size_t bytes) {
+        waitAndGrant(*account.m_data, category, bytes);
+        return {account.m_data, category, bytes};
+    }
+
+    MemoryBudget::Reservation MemoryBudget::tryAcquire(Account &account, MemoryCategory category, std::size_t bytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!canGrant(*account.m_data, bytes)) {
+            return {};
+        }
+        grant(*account.m_data, category, bytes);
+        return {account.m_data, category, bytes};
+    }
+
+    MemoryBudget::Stats MemoryBudget::stats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void MemoryBudget::resetPeak() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.peak = m_stats.inUse;
+        m_stats.categoryPeak = m_stats.categoryInUse;
+    }
+
+    void MemoryBudget::waitAndGrant(Account::Data &account, MemoryCategory category, std::size_t bytes) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!canGrant(account, bytes)) {
+            ++m_stats.waits;
+            auto waitStart = std::chrono::steady_clock::now();
+            ++account.waiters;
+            // Other waiters may now find that every holder is blocked.
+            m_released.notify_all();
+            m_released.wait(lock, [&]() { return canGrant(account, bytes); });
+            --account.waiters;
+            std::chrono::duration<double> waited = std::chrono::steady_clock::now() - waitStart;
+            m_stats.waitSeconds += waited.count();
+        }
+        grant(account, category, bytes);
+    }
+
+    bool MemoryBudget::canGrant(const Account::Data &account, std::size_t bytes) const {
+        if (m_stats.capacity == 0 || m_stats.inUse + bytes <= m_stats.capacity) {
+            return true;
+        }
+        // Nobody else holds memory, so nothing will be released for us.
+        if (m_stats.inUse == account.held) {
+            return true;
+        }
+        // Every holder is blocked in acquire(), so nothing will be released either.
+        return std::all_of(m_holders.begin(), m_holders.end(), [](const Account::Data *holder) {
+            return holder->waiters > 0;
+        }) && account.held > 0;
+    }
+
+    void MemoryBudget::grant(Account::Data &account, MemoryCategory category, std::size_t bytes) {
+        auto index = static_cast<std::size_t>(category);
+        if (account.held == 0 && bytes > 0) {
+            m_holders.push_back(&account);
+        }
+        account.held += bytes;
+        m_stats.inUse += bytes;
+        m_stats.categoryInUse[index] += bytes;
+        m_stats.peak = std::max(m_stats.peak, m_stats.inUse);
+        m_stats.categoryPeak[index] = std::max(m_stats.categoryPeak[index], m_stats.categoryInUse[index]);
+        ++m_stats.acquisitions;
+    }
+
+    void MemoryBudget::giveBack(Account::Data &account, MemoryCategory category, std::size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto index = static_cast<std::size_t>(category);
+            account.held -= bytes;
+            if (account.held == 0) {
+                m_holders.erase(std::find(m_holders.begin(), m_holders.end(), &account));
+            }
+            m_stats.inUse -= bytes;
+            m_stats.categoryInUse[index] -= bytes;
+        }
+        m_released.notify_all();
+    }
+
+}  // namespace some
@@ -0,0 +1,117 @@
+#ifndef SOME_GUI_MEMORYBUDGET_H
+#define SOME_GUI_MEMORYBUDGET_H
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace some {
+
+    enum class MemoryCategory {
+        Waveform,  // decoded, downmixed and resampled audio
+        Chunk,     // chunk tensors in flight
+        Result,    // notes and MIDI events
+        Count
+    };
+
+    const char *memoryCategoryName(MemoryCategory category);
+
+    // Upper bound on the bytes held by all jobs together.
+    //
+    // Every job opens an Account and reserves memory before allocating it. A reservation blocks
+    // while the budget is exhausted, which is how new files and new chunks wait for admission.
+    // A request is still granted when waiting could never succeed: when everything in use belongs to
+    // the requesting account, or when every account holding memory is itself waiting. So an oversized
+    // job degrades to running alone, and jobs that hold memory while asking for more cannot deadlock.
+    //
+    // Reservations may outlive the Account they were made from; the budget itself must outlive both.
+    class MemoryBudget {
+    public:
+        struct Stats {
+            std::size_t capacity = 0;  // 0 means unlimited
+            std::size_t inUse = 0;
+            std::size_t peak = 0;
+            std::size_t acquisitions = 0;
+            std::size_t waits = 0;
+            double waitSeconds = 0.0;
+            std::array<std::size_t, static_cast<std::size_t>(MemoryCategory::Count)> categoryInUse {};
+            std::array<std::size_t, static_cast<std::size_t>(MemoryCategory::Count)> categoryPeak {};
+        };
+
+        class Account {
+        public:
+            explicit Account(MemoryBudget &budget);
+
+            MemoryBudget &budget() const;
+            std::size_t held() const;
+
+        private:
+            friend class MemoryBudget;
+            struct Data {
+                MemoryBudget *budget;
+                // Guarded by the budget mutex
+                std::size_t held = 0;
+                int waiters = 0;
+            };
+            std::shared_ptr<Data> m_data;
+        };
+
+        class Reservation {
+        public:
+            Reservation() = default;
+            ~Reservation();
+            Reservation(Reservation &&other) noexcept;
+            Reservation &operator=(Reservation &&other) noexcept;
+
+            Reservation(const Reservation &) = delete;
+            Reservation &operator=(const Reservation &) = delete;
+
+            // Shrinking never blocks. Growing blocks like a new reservation.
+            void resize(std::size_t bytes);
+            void release();
+            std::size_t size() const;
+            bool isValid() const;
+
+        private:
+            friend class MemoryBudget;
+            Reservation(std::shared_ptr<Account::Data> account, MemoryCategory category, std::size_t bytes);
+
+            std::shared_ptr<Account::Data> m_account;
+            MemoryCategory m_category = MemoryCategory::Waveform;
+            std::size_t m_bytes = 0;
+        };
+
+        explicit MemoryBudget(std::size_t capacity = 0);
+
+        // Process-wide budget. The initial capacity comes from the SOME_MEMORY_BUDGET_MB
+        // environment variable; unset or 0 means unlimited.
+        static MemoryBudget &global();
+
+        void setCapacity(std::size_t capacity);
+        std::size_t capacity() const;
+
+        Reservation acquire(Account &account, MemoryCategory category, std::size_t bytes);
+        // Returns an invalid reservation instead of waiting.
+        Reservation tryAcquire(Account &account, MemoryCategory category, std::size_t bytes);
+
+        Stats stats() const;
+        void resetPeak();
+
+    private:
+        void waitAndGrant(Account::Data &account, MemoryCategory category, std::size_t bytes);
+        bool canGrant(const Account::Data &account, std::size_t bytes) const;
+        void grant(Account::Data &account, MemoryCategory category, std::size_t bytes);
+        void giveBack(Account::Data &account, MemoryCategory category, std::size_t bytes);
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_released;
+        std::vector<Account::Data *> m_holders;
+        Stats m_stats;
+    };  // class MemoryBudget
+
+}  // namespace some
+
+#endif //SOME_GUI_MEMORYBUDGET_H
@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <QFileInfo>
+#include <QStringList>
+
+#include "Inference/SOMEInference.h"
+#include "Utils/CpuTopology.h"
+#include "MultiModelJob.h"
+
+namespace some {
+
+    namespace {
+        double secondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    MultiModelJob::MultiModelJob(QObject *parent) : QObject(parent) {}
+
+    void MultiModelJob::setExecutionProvider(ExecutionProvider ep, int deviceIndex) {
+        m_ep = ep;
+        m_deviceIndex = deviceIndex;
+    }
+
+    void MultiModelJob::setSessionConfig(const SessionConfig &config) {
+        m_sessionConfig = config;
+    }
+
+    void MultiModelJob::setMaxParallel(int maxParallel) {
+        m_maxParallel = maxParallel;
+    }
+
+    void MultiModelJob::setThreadPlanOptions(const ThreadPlanOptions &options) {
+        m_threadPlanOptions = options;
+    }
+
+    void MultiModelJob::setPreprocessOptions(const PreprocessOptions &options) {
+        m_preprocessOptions = options;
+    }
+
+    void MultiModelJob::setPreprocessCache(PreprocessCache *cache) {
+        m_cache = cache;
+    }
+
+    void MultiModelJob::setProfiling(bool enabled) {
+        m_profiling = enabled;
+    }
+
+    bool MultiModelJob::run(const QString &audioPath, const QStringList &modelPaths, const QStringList &outPaths,
+                            double tempo) {
+        auto wallStart = std::chrono::steady_clock::now();
+        m_results.clear();
+        if (modelPaths.isEmpty() || modelPaths.size() != outPaths.size()) {
+            Q_EMIT logMsgError("Every model needs an output path.");
+            return false;
+        }
+
+        // Preprocess once
+        Pipeline pipeline;
+        pipeline.setPreprocessOptions(m_preprocessOptions);
+        pipeline.setPreprocessCache(m_cache);
+        connect(&pipeline, &Pipeline::logMsgInfo, this, &MultiModelJob::logMsgInfo, Qt::DirectConnection);
+        connect(&pipeline, &Pipeline::logMsgError, this, &MultiModelJob::logMsgError, Qt::DirectConnection);
+        AudioBuffer audio;
+        MarkerList markers;
+        if (!pipeline.preprocess(audioPath, audio, markers)) {
+            return false;
+        }
+        m_preprocessStats = pipeline.stats();
+
+        m_results.resize(static_cast<std::size_t>(modelPaths.size()));
+        for (int i = 0; i < modelPaths.size(); ++i) {
+            m_results[i].modelPath = modelPaths[i];
+            m_results[i].outPath = outPaths[i];
+        }
+
+        // GPU sessions share one device, so they run one after another.
+        ThreadPlanner planner;
+        int cores = planner.topology().physicalCoreCount();
+        int parallel = !isGpuExecutionProvider(m_ep) ? (m_maxParallel > 0 ? m_maxParallel : cores) : 1;
+        m_parallel = std::clamp(parallel, 1, static_cast<int>(modelPaths.size()));
+        auto planOptions = m_threadPlanOptions;
+        planOptions.sessions = m_parallel;
+        if (planOptions.globalThreadPools) {
+            auto globalPlan = planner.plan(planOptions);
+            QString errorMessage;
+            if (!Inference::initGlobalThreadPools(globalPlan.globalIntraOpThreads,
+                                                  planOptions.pinThreads ? globalPlan.globalCpus : std::vector<int>(),
+                                                  &errorMessage)) {
+                Q_EMIT logMsgError(errorMessage + " Using a thread pool per session.");
+                planOptions.globalThreadPools = false;
+            }
+        }
+        m_threadPlan = planner.plan(planOptions);
+        Q_EMIT logMsgInfo(QString("Running %1 models over %2 chunks, %3 at a time.")
+                                  .arg(modelPaths.size()).arg(markers.size()).arg(m_parallel));
+        Q_EMIT logMsgInfo(QString::fromStdString(m_threadPlan.describe()));
+
+        // Fan out: one thread per session slot, each taking the next model until none are left.
+        std::atomic<std::size_t> next {0};
+        std::vector<std::thread> threads;
+        for (const auto &slot : m_threadPlan.sessions) {
+            threads.emplace_back([&, slot]() {
+                if (m_threadPlan.options.pinThreads && !slot.cpus.empty()) {
+                    // ONNX Runtime pins the other threads of a per-session pool; see runModel().
+                    bool ortPins = !m_threadPlan.options.globalThreadPools && m_sessionConfig.intraOpThreads == 0;
+                    setCurrentThreadAffinity(ortPins ? std::vector<int> {slot.cpus.front()} : slot.cpus);
+                }
+                for (auto i = next++; i < m_results.size(); i = next++) {
+                    runModel(i, slot, audio, markers, tempo);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        m_wallSeconds = secondsSince(wallStart);
+        return std::all_of(m_results.begin(), m_results.end(), [](const ModelRunResult &result) {
+            return result.ok;
+        });
+    }
+
+    void MultiModelJob::runModel(std::size_t index, const SessionSlot &slot, const AudioBuffer &audio,
+                                 const MarkerList &markers, double tempo) {
+        auto &result = m_results[index];
+        auto config = m_sessionConfig;
+        config.globalThreadPools = m_threadPlan.options.globalThreadPools;
+        if (config.intraOpThreads == 0) {
+            config.intraOpThreads = slot.intraOpThreads;
+            if (m_threadPlan.options.pinThreads) {
+                config.intraOpCpus = slot.cpus;
+            }
+        }
+        if (m_profiling) {
+            config.profilePrefix = (result.outPath + ".ort-profile").toStdString();
+        }
+        auto prefix = QString("[%1] ").arg(QFileInfo(result.modelPath).fileName());
+        auto forwardInfo = [this, prefix](const QString &msg) {
+            Q_EMIT logMsgInfo(prefix + msg);
+        };
+        auto forwardError = [this, prefix](const QString &msg) {
+            Q_EMIT logMsgError(prefix + msg);
+        };
+
+        auto loadStart = std::chrono::steady_clock::now();
+        SOMEInference inference(result.modelPath);
+        connect(&inference, &Inference::logMsgInfo, forwardInfo);
+        connect(&inference, &Inference::logMsgError, forwardError);
+        inference.setSessionConfig(config);
+        if (!inference.initSession(m_ep, m_deviceIndex)) {
+            forwardError("Session initialization failed.");
+            return;
+        }
+        result.loadSeconds = secondsSince(loadStart);
+
+        // The waveform and markers are shared read-only between the models.
+        Pipeline pipeline;
+        connect(&pipeline, &Pipeline::logMsgInfo, forwardInfo);
+        connect(&pipeline, &Pipeline::logMsgError, forwardError);
+        std::vector<NotesPtr> chunkNotes;
+        if (!pipeline.infer(inference, audio, markers, chunkNotes) ||
+            !pipeline.writeMidi(result.outPath, audio, markers, chunkNotes, tempo)) {
+            return;
+        }
+        result.stats = pipeline.stats();
+        result.stats.audioSeconds = m_preprocessStats.audioSeconds;
+        result.stats.chunkCount = markers.size();
+        result.ok = true;
+        forwardInfo(QString("Wrote %1").arg(result.outPath));
+        if (m_profiling) {
+            inference.writeProfileSummary(result.outPath + ".ort-profile.txt");
+        }
+    }
+
+    const PipelineStats &MultiModelJob::preprocessStats() const {
+        return m_preprocessStats;
+    }
+
+    const std::vector<ModelRunResult> &MultiModelJob::results() const {
+        return m_results;
+    }
+
+    double MultiModelJob::wallSeconds() const {
+        return m_wallSeconds;
+    }
+
+    const ThreadPlan &MultiModelJob::threadPlan() const {
+        return m_threadPlan;
+    }
+
+    QString MultiModelJob::timingTable() const {
+        QStringList lines;
+        QStringList stages;
+        for (const auto &[stage, seconds] : m_preprocessStats.stageSeconds) {
+            stages << QString("%1 %2").arg(QString::fromStdString(stage)).arg(seconds, 0, 'f', 3);
+        }
+        lines << QString("Preprocessing, once: %1 s (%2)%3")
+                .arg(m_preprocessStats.totalSeconds(), 0, 'f', 3)
+                .arg(stages.join(", "))
+                .arg(m_preprocessStats.cacheHit ? ", from cache" : "");
+        lines << QString("%1 %2 %3 %4 %5 %6  %7")
+                .arg("model", -32).arg("load(s)", 9).arg("infer(s)", 9).arg("midi(s)", 9)
+                .arg("RTF", 8).arg("notes", 7).arg("status");
+
+        double serialSeconds = 0.0;
+        for (const auto &result : m_results) {
+            const auto &stats = result.stats;
+            lines << QString("%1 %2 %3 %4 %5 %6  %7")
+                    .arg(QFileInfo(result.modelPath).fileName(), -32)
+                    .arg(result.loadSeconds, 9, 'f', 3)
+                    .arg(stats.stageTime("inference"), 9, 'f', 3)
+                    .arg(stats.stageTime("midi"), 9, 'f', 3)
+                    .arg(stats.audioSeconds > 0 ? stats.stageTime("inference") / stats.audioSeconds : 0.0, 8, 'f', 4)
+                    .arg(stats.noteCount, 7)
+                    .arg(result.ok ? "ok" : "failed");
+            serialSeconds += m_preprocessStats.totalSeconds() + result.loadSeconds + stats.totalSeconds();
+        }
+        lines << QString("Wall time %1 s for %2 models (%3 at a time); one job per model would take about %4 s.")
+                .arg(m_wallSeconds, 0, 'f', 3)
+                .arg(m_results.size())
+                .arg(m_parallel)
+                .arg(serialSeconds, 0, 'f', 3);
+        return lines.join('\n');
+    }
+
+}  // namespace some
@@ -0,0 +1,85 @@
+#ifndef SOME_GUI_MULTIMODELJOB_H
+#define SOME_GUI_MULTIMODELJOB_H
+
+#include <cstddef>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include "Inference/ExecutionProviderOptions.h"
+#include "Inference/SessionConfig.h"
+#include "Pipeline.h"
+#include "PipelineStats.h"
+#include "ThreadPlanner.h"
+
+namespace some {
+
+    struct ModelRunResult {
+        QString modelPath;
+        QString outPath;
+        bool ok = false;
+        double loadSeconds = 0.0;
+        // Inference and midi stages of this model; audioSeconds is the whole input.
+        PipelineStats stats;
+    };
+
+    // Runs several models over one audio file. Decoding, resampling and slicing happen once; the
+    // chunks are then fanned out to one SOMEInference session per model, several at a time when
+    // there are cores for it. Each model writes its own MIDI file.
+    class MultiModelJob : public QObject {
+        Q_OBJECT
+    public:
+        explicit MultiModelJob(QObject *parent = nullptr);
+
+        void setExecutionProvider(ExecutionProvider ep, int deviceIndex = 0);
+        // intraOpThreads == 0 takes the thread count from the thread plan.
+        void setSessionConfig(const SessionConfig &config);
+        // Sessions run at the same time; 0 picks one per model, up to the number of cores.
+        void setMaxParallel(int maxParallel);
+        // How the CPUs are divided between the sessions. `sessions` is set by the job.
+        void setThreadPlanOptions(const ThreadPlanOptions &options);
+        void setPreprocessOptions(const PreprocessOptions &options);
+        void setPreprocessCache(PreprocessCache *cache);
+        // Profiles every session and writes <out>.ort-profile.txt, the time per node, op type and
+        // chunk length, next to each MIDI file. ONNX Runtime's own profile is left beside it.
+        void setProfiling(bool enabled);
+
+        // `outPaths` has one MIDI path per model. Returns true if every model succeeded.
+        bool run(const QString &audioPath, const QStringList &modelPaths, const QStringList &outPaths, double tempo);
+
+        const PipelineStats &preprocessStats() const;
+        const std::vector<ModelRunResult> &results() const;
+        double wallSeconds() const;
+        const ThreadPlan &threadPlan() const;
+        // Per-model timings next to the shared preprocessing, as plain text.
+        QString timingTable() const;
+
+    Q_SIGNALS:
+        void logMsgInfo(const QString &msg);
+        void logMsgError(const QString &msg);
+
+    private:
+        void runModel(std::size_t index, const SessionSlot &slot, const AudioBuffer &audio,
+                      const MarkerList &markers, double tempo);
+
+        ExecutionProvider m_ep = ExecutionProvider::CPU;
+        int m_deviceIndex = 0;
+        SessionConfig m_sessionConfig;
+        int m_maxParallel = 0;
+        ThreadPlanOptions m_threadPlanOptions;
+        PreprocessOptions m_preprocessOptions;
+        PreprocessCache *m_cache = nullptr;
+        bool m_profiling = false;
+
+        PipelineStats m_preprocessStats;
+        std::vector<ModelRunResult> m_results;
+        int m_parallel = 1;
+        ThreadPlan m_threadPlan;
+        double m_wallSeconds = 0.0;
+    };  // class MultiModelJob
+
+}  // namespace some
+
+#endif //SOME_GUI_MULTIMODELJOB_H
@@ -0,0 +1,765 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <thread>
+
+#include <sndfile.hh>
+#include <MidiFile.h>
+
+#include <QFileInfo>
+
+#include "Pipeline.h"
+#include "PreprocessCache.h"
+#include "PreprocessJob.h"
+#include "ProgressTracker.h"
+#include "StreamResampler.h"
+#include "Dsp/Kernels.h"
+#include "Inference/InferenceBackend.h"
+#include "Utils/CancelToken.h"
+
+namespace some {
+
+    namespace {
+        // Input kept on both sides of a chunk when only the chunks are resampled, so the start and
+        // end of the filter response fall outside of the chunk. Longer than the filters of both
+        // resamplers.
+        constexpr double kResampleMarginSeconds = 0.05;
+        // Input fed to the resampler between two cancel checks.
+        constexpr std::size_t kResampleBlockFrames = 65536;
+        // Frames decoded between two cancel checks and overview updates.
+        constexpr sf_count_t kDecodeBlockFrames = 1 << 16;
+        // FLAC and Ogg are split between threads from this much audio per thread.
+        constexpr double kMinParallelDecodeSeconds = 30.0;
+        // Frames before its range a parallel segment decodes again, to compare them with the
+        // segment before it.
+        constexpr sf_count_t kDecodeVerifyFrames = 4096;
+
+        SndfileHandle openSndfile(const QString &path) {
+            return SndfileHandle(path
+#ifdef _WIN32
+                    .toStdWString().c_str()
+#else
+                    .toStdString()
+#endif
+            );
+        }
+
+        // Threads to decode a file with: several for long compressed files, where decoding is bound
+        // by the CPU, and one for PCM, where it is bound by reading the file.
+        int decodeThreads(const SndfileHandle &sf, sf_count_t frames) {
+            auto type = sf.format() & SF_FORMAT_TYPEMASK;
+            if (type != SF_FORMAT_FLAC && type != SF_FORMAT_OGG) {
+                return 1;
+            }
+            auto minFrames = std::max<sf_count_t>(1, static_cast<sf_count_t>(kMinParallelDecodeSeconds * sf.samplerate()));
+            auto cores = static_cast<sf_count_t>(std::max(1u, std::thread::hardware_concurrency()));
+            return static_cast<int>(std::clamp<sf_count_t>(frames / minFrames, 1, cores));
+        }
+
+        // Decodes every segment of a file but the first on a thread of its own, each through its own
+        // handle seeked to the start of the segment; the caller decodes the first one from the start
+        // with its handle, which is the serial decode. Each thread also decodes the frames just before
+        // its segment, so verify() can check that a seek gives the same samples as decoding up to it.
+        class SegmentDecoder {
+        public:
+            ~SegmentDecoder() {
+                join();
+            }
+
+            void start(const QString &path, int channels, sf_count_t frames, int segments, float *out,
+                       const CancelToken *cancel) {
+                m_channels = channels;
+                m_out = out;
+                m_bounds.resize(segments + 1);
+                for (int i = 0; i <= segments; ++i) {
+                    m_bounds[i] = frames * i / segments;
+                }
+                m_segments.resize(segments);
+                for (int i = 1; i < segments; ++i) {
+                    m_threads.emplace_back([this, path, i, cancel]() {
+                        decode(path, i, cancel);
+                    });
+                }
+            }
+
+            sf_count_t firstSegmentEnd() const {
+                return m_bounds[1];
+            }
+
+            void join() {
+                for (auto &thread : m_threads) {
+                    thread.join();
+                }
+                m_threads.clear();
+            }
+
+            // After join(), with the first segment decoded by the caller: true if every segment was
+            // decoded in full and its verification frames match the segment before it bit for bit.
+            bool verify(QString &reason) const {
+                for (std::size_t i = 1; i < m_segments.size(); ++i) {
+                    const auto &segment = m_segments[i];
+                    if (!segment.complete) {
+                        reason = QString("segment at frame %1 could not be read").arg(m_bounds[i]);
+                        return false;
+                    }
+                    auto verifyFrames = static_cast<sf_count_t>(segment.verify.size()) / m_channels;
+                    if (std::memcmp(segment.verify.data(), m_out + (m_bounds[i] - verifyFrames) * m_channels,
+                                    segment.verify.size() * sizeof(float)) != 0) {
+                        reason = QString("seeking to frame %1 gives different samples").arg(m_bounds[i]);
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        private:
+            struct Segment {
+                std::vector<float> verify;
+                bool complete = false;
+            };
+
+            void decode(const QString &path, int index, const CancelToken *cancel) {
+                auto &segment = m_segments[index];
+                auto sf = openSndfile(path);
+                if (sf.error() != SF_ERR_NO_ERROR || sf.channels() != m_channels) {
+                    return;
+                }
+                auto begin = m_bounds[index];
+                auto end = m_bounds[index + 1];
+                auto verifyFrames = std::min(kDecodeVerifyFrames, begin);
+                if (sf.seek(begin - verifyFrames, SEEK_SET) != begin - verifyFrames) {
+                    return;
+                }
+                segment.verify.resize(static_cast<std::size_t>(verifyFrames * m_channels));
+                if (sf.readf(segment.verify.data(), verifyFrames) != verifyFrames) {
+                    return;
+                }
+                auto pos = begin;
+                while (pos < end && !(cancel && cancel->isCancelled())) {
+                    auto read = sf.readf(m_out + pos * m_channels, std::min(kDecodeBlockFrames, end - pos));
+                    if (read <= 0) {
+                        break;
+                    }
+                    pos += read;
+                }
+                segment.complete = pos == end;
+            }
+
+            int m_channels = 1;
+            float *m_out = nullptr;
+            std::vector<sf_count_t> m_bounds;
+            std::vector<Segment> m_segments;
+            std::vector<std::thread> m_threads;
+        };
+    }
+
+    QString PreprocessOptions::cacheKey() const {
+#if defined(SOME_ENABLE_R8BRAIN)
+        const char *resampler = "r8brain";
+#elif defined(SOME_ENABLE_SAMPLERATE)
+        const char *resampler = "libsamplerate-sinc-fastest";
+#else
+        const char *resampler = "none";
+#endif
+        // v2: sliced at the rate of the file, with only the chunks resampled.
+        return QString("v2;sr=%1;resampler=%2;slicer=%3,%4,%5,%6,%7")
+                .arg(targetSampleRate)
+                .arg(resampler)
+                .arg(slicerThreshold)
+                .arg(slicerMinLength)
+                .arg(slicerMinInterval)
+                .arg(slicerHopSize)
+                .arg(slicerMaxSilKept);
+    }
+
+    Pipeline::Pipeline(QObject *parent) : Pipeline(MemoryBudget::global(), parent) {}
+
+    Pipeline::Pipeline(MemoryBudget &budget, QObject *parent)
+            : QObject(parent), m_budget(budget), m_account(budget) {
+        m_stats.memoryBudget = budget.capacity();
+    }
+
+    Pipeline::~Pipeline() = default;
+
+    bool Pipeline::run(InferenceBackend &backend, const QString &audioPath, const QString &outPath, double tempo) {
+        AudioBuffer audio;
+        MarkerList markers;
+        if (!preprocess(audioPath, audio, markers)) {
+            return false;
+        }
+        std::vector<NotesPtr> chunkNotes;
+        if (!infer(backend, audio, markers, chunkNotes) ||
+            !writeMidi(outPath, audio, markers, chunkNotes, tempo)) {
+            return false;
+        }
+        m_result = publish(audioPath, audio, markers, std::move(chunkNotes));
+        if (m_progress) {
+            m_progress->finish();
+        }
+        return true;
+    }
+
+    JobResultPtr Pipeline::publish(const QString &audioPath, AudioBuffer &audio, MarkerList &markers,
+                                   std::vector<NotesPtr> chunkNotes) {
+        auto result = std::make_shared<JobResult>();
+        result->audioPath = audioPath;
+        result->sampleRate = audio.sampleRate;
+        result->markers = std::make_shared<const MarkerList>(std::move(markers));
+        result->chunkNotes = std::move(chunkNotes);
+        result->stats = m_stats;
+        audio = {};
+        markers = {};
+        return result;
+    }
+
+    JobResultPtr Pipeline::result() const {
+        return m_result;
+    }
+
+    bool Pipeline::preprocess(const QString &audioPath, AudioBuffer &audio, MarkerList &markers) {
+        if (usePreprocessed(audioPath, audio, markers)) {
+            return true;
+        }
+        QByteArray cacheKey;
+        m_sourceOverview = nullptr;
+        if (m_cache) {
+            m_stats.cacheEnabled = true;
+            beginStage("cache");
+            StageTimer timer(m_stats, "cache");
+            cacheKey = m_cache->makeKey(audioPath, m_options.cacheKey());
+            if (loadFromCache(cacheKey, audio, markers)) {
+                Q_EMIT markersReady(std::make_shared<const MarkerList>(markers), audio.sampleRate);
+                return true;
+            }
+        }
+
+        if (!loadAudio(audioPath, audio)) {
+            return false;
+        }
+        convertToMono(audio);
+        if (isCancelled() || !slice(audio, markers)) {
+            return false;
+        }
+        if (isCancelled() || !resampleChunks(audio, markers, m_options.targetSampleRate)) {
+            return false;
+        }
+        Q_EMIT markersReady(std::make_shared<const MarkerList>(markers), audio.sampleRate);
+
+        if (m_cache && !cacheKey.isEmpty()) {
+            StageTimer timer(m_stats, "cache");
+            if (!m_cache->store(cacheKey, audio.waveform, audio.sampleRate, markers, m_sourceOverview.get())) {
+                Q_EMIT logMsgInfo("Could not write the preprocess cache entry.");
+            }
+        }
+        return true;
+    }
+
+    bool Pipeline::usePreprocessed(const QString &audioPath, AudioBuffer &audio, MarkerList &markers) {
+        auto input = std::move(m_preprocessed);
+        if (!input || input->audioPath != audioPath || input->optionsKey != m_options.cacheKey()) {
+            return false;
+        }
+        // Overwritten since, e.g. exported again: the result is of the old content.
+        QFileInfo info(audioPath);
+        if (info.size() != input->fileSize || info.lastModified() != input->fileModified) {
+            Q_EMIT logMsgInfo("The input file changed after it was preprocessed in the background. Decoding it again.");
+            return false;
+        }
+        for (const auto &msg : input->log) {
+            Q_EMIT logMsgInfo(msg);
+        }
+        Q_EMIT logMsgInfo(QString("Audio was preprocessed in the background (%1 s).")
+                                  .arg(QString::number(input->seconds, 'f', 3)));
+        audio = std::move(input->audio);
+        markers = std::move(input->markers);
+        m_stats.audioSeconds = input->stats.audioSeconds;
+        m_stats.chunkCount = input->stats.chunkCount;
+        m_stats.cacheEnabled = input->stats.cacheEnabled;
+        m_stats.cacheHit = input->stats.cacheHit;
+        if (m_progress) {
+            m_progress->setAudioSeconds(m_stats.audioSeconds);
+        }
+        if (m_waveformOverview && input->mipmap) {
+            Q_EMIT waveformReady(input->mipmap);
+        }
+        Q_EMIT markersReady(std::make_shared<const MarkerList>(markers), audio.sampleRate);
+        return true;
+    }
+
+    bool Pipeline::loadFromCache(const QByteArray &key, AudioBuffer &audio, MarkerList &markers) {
+        auto entry = m_cache->open(key);
+        if (!entry || entry->sampleRate() != m_options.targetSampleRate || entry->markers().empty()) {
+            return false;
+        }
+        audio.reservation = reserve(MemoryCategory::Waveform, entry->frames() * sizeof(float));
+        audio.waveform.assign(entry->samples(), entry->samples() + entry->frames());
+        recordCopy(entry->frames() * sizeof(float));
+        audio.channels = 1;
+        audio.sampleRate = entry->sampleRate();
+        audio.frames = entry->frames();
+        markers = entry->markers();
+        // The cached waveform is zero between the chunks, so only the stored overview of the source
+        // is shown.
+        if (m_waveformOverview && entry->overview()) {
+            Q_EMIT waveformReady(entry->overview());
+        }
+
+        m_stats.cacheHit = true;
+        m_stats.audioSeconds = static_cast<double>(audio.frames) / audio.sampleRate;
+        if (m_progress) {
+            m_progress->setAudioSeconds(m_stats.audioSeconds);
+        }
+        m_stats.chunkCount = markers.size();
+        Q_EMIT logMsgInfo(QString("Preprocessed audio loaded from cache. Total chunks: %1").arg(markers.size()));
+        return true;
+    }
+
+    bool Pipeline::loadAudio(const QString &audioPath, AudioBuffer &audio) {
+        beginStage("decode");
+        StageTimer timer(m_stats, "decode");
+        Q_EMIT logMsgInfo("Loading audio...");
+
+        auto sf = openSndfile(audioPath);
+        if (sf.error() != SF_ERR_NO_ERROR) {
+            Q_EMIT logMsgError(QString("Sndfile error: %1").arg(sf.strError()));
+            return false;
+        }
+        auto channels = sf.channels();
+        auto sampleRate = sf.samplerate();
+        auto frames = sf.frames();
+        if ((channels <= 0) || (sampleRate <= 0)) {
+            Q_EMIT logMsgError("Audio load failed.");
+            return false;
+        }
+
+        if (frames == 0) {
+            Q_EMIT logMsgError("Audio is empty!");
+            return false;
+        }
+
+        constexpr long long maxAllowedLength = 20 * 60;
+        if (frames >= sampleRate * maxAllowedLength) {
+            Q_EMIT logMsgError("Error: the input audio is too long (>= 20 minutes).");
+            return false;
+        }
+        auto samples = frames * channels;
+        audio.reservation = reserve(MemoryCategory::Waveform, samples * sizeof(float));
+        try {
+            audio.waveform.resize(samples);
+        }
+        catch (const std::bad_alloc &e) {
+            Q_EMIT logMsgError(QString("Failed to allocate memory for audio: ") + e.what());
+            return false;
+        }
+
+        // Decoded in blocks, so the overview is reduced behind the decoder on its own thread.
+        dsp::WaveformMipmapBuilder overview;
+        if (m_waveformOverview) {
+            overview.start(audio.waveform.data(), static_cast<std::size_t>(frames), channels, sampleRate);
+        }
+        sf_count_t framesRead = 0;
+        auto decodeUntil = [&](sf_count_t end) {
+            while (framesRead < end && !isCancelled()) {
+                auto count = std::min(kDecodeBlockFrames, end - framesRead);
+                auto read = sf.readf(audio.waveform.data() + framesRead * channels, count);
+                if (read <= 0) {
+                    break;
+                }
+                framesRead += read;
+                if (m_waveformOverview) {
+                    overview.advance(static_cast<std::size_t>(framesRead));
+                }
+            }
+        };
+        auto threads = decodeThreads(sf, frames);
+        if (threads > 1) {
+            // The overview only gets the other segments once they are verified.
+            SegmentDecoder segments;
+            segments.start(audioPath, channels, frames, threads, audio.waveform.data(), m_cancel);
+            decodeUntil(segments.firstSegmentEnd());
+            segments.join();
+            QString reason;
+            if (framesRead == segments.firstSegmentEnd() && !isCancelled()) {
+                if (segments.verify(reason)) {
+                    framesRead = frames;
+                    if (m_waveformOverview) {
+                        overview.advance(static_cast<std::size_t>(framesRead));
+                    }
+                    Q_EMIT logMsgInfo(QString("Decoded on %1 threads.").arg(threads));
+                }
+                else {
+                    Q_EMIT logMsgInfo(QString("Decoding on one thread: %1.").arg(reason));
+                }
+            }
+        }
+        // The whole file, or what a parallel decode left.
+        decodeUntil(frames);
+        // Joins the overview thread before the waveform is downmixed in place.
+        auto mipmap = overview.finish();
+        if (isCancelled()) {
+            return false;
+        }
+        if (framesRead <= 0) {
+            Q_EMIT logMsgError("Can't read audio file!");
+            return false;
+        }
+        frames = framesRead;
+
+        audio.channels = channels;
+        audio.sampleRate = sampleRate;
+        audio.frames = static_cast<std::size_t>(frames);
+        audio.waveform.resize(audio.frames * channels);
+        audio.reservation.resize(audio.waveform.size() * sizeof(float));
+        m_stats.audioSeconds = static_cast<double>(audio.frames) / sampleRate;
+        if (m_progress) {
+            m_progress->setAudioSeconds(m_stats.audioSeconds);
+        }
+        if (mipmap) {
+            m_sourceOverview = mipmap;
+            Q_EMIT waveformReady(mipmap);
+        }
+        return true;
+    }
+
+    void Pipeline::convertToMono(AudioBuffer &audio) {
+        if (audio.channels <= 1) {
+            return;
+        }
+        beginStage("downmix");
+        StageTimer timer(m_stats, "downmix");
+        // Convert to mono in-place
+        auto &waveform = audio.waveform;
+        dsp::downmix(waveform.data(), waveform.data(), audio.frames, audio.channels);
+        waveform.resize(audio.frames);
+        waveform.shrink_to_fit();
+        audio.reservation.resize(waveform.size() * sizeof(float));
+        audio.channels = 1;
+    }
+
+    bool Pipeline::resampleChunks(AudioBuffer &audio, MarkerList &markers, int targetSampleRate) {
+        auto sampleRate = audio.sampleRate;
+        if (sampleRate == targetSampleRate) {
+            return true;
+        }
+        beginStage("resample");
+        StageTimer timer(m_stats, "resample");
+        StreamResampler probe(sampleRate, targetSampleRate);
+        if (!probe.isValid()) {
+            Q_EMIT logMsgError(probe.errorString());
+            return false;
+        }
+        using Frames = unsigned long long;
+        auto frames = audio.frames;
+        auto targetFrames = static_cast<std::size_t>(static_cast<Frames>(frames) * targetSampleRate / sampleRate);
+        auto toTarget = [&](std::size_t frame) {
+            auto target = (static_cast<Frames>(frame) * targetSampleRate + sampleRate / 2) / sampleRate;
+            return std::min(targetFrames, static_cast<std::size_t>(target));
+        };
+        // A region starts on a multiple of `step`, where an input frame falls exactly on an output
+        // frame, so the output of every region lines up with the others.
+        auto rateGcd = std::gcd(sampleRate, targetSampleRate);
+        auto step = static_cast<std::size_t>(sampleRate / rateGcd);
+        auto margin = static_cast<std::size_t>(std::ceil(kResampleMarginSeconds * sampleRate));
+
+        // Chunks whose margins overlap are resampled as one region.
+        struct Region {
+            std::size_t inBegin, inEnd;  // input frames fed to the resampler
+            std::size_t outBegin, outEnd;  // output frames kept
+        };
+        std::vector<Region> regions;
+        MarkerList targetMarkers;
+        targetMarkers.reserve(markers.size());
+        for (const auto &[beginFrame, endFrame] : markers) {
+            targetMarkers.emplace_back(toTarget(beginFrame), toTarget(endFrame));
+            auto inBegin = beginFrame > margin ? beginFrame - margin : 0;
+            inBegin -= inBegin % step;
+            auto inEnd = std::min(frames, endFrame + margin);
+            if (!regions.empty() && inBegin <= regions.back().inEnd) {
+                regions.back().inEnd = std::max(regions.back().inEnd, inEnd);
+                regions.back().outEnd = std::max(regions.back().outEnd, targetMarkers.back().second);
+            }
+            else {
+                regions.push_back({inBegin, inEnd, targetMarkers.back().first, targetMarkers.back().second});
+            }
+        }
+
+        auto outReservation = reserve(MemoryCategory::Waveform, targetFrames * sizeof(float));
+        std::vector<float> outVec(targetFrames, 0.0f);
+        std::vector<float> block;
+        std::size_t resampledFrames = 0;
+        for (const auto &region : regions) {
+            StreamResampler resampler(sampleRate, targetSampleRate);
+            // Output frame of the resampler's first output.
+            auto outPos = static_cast<std::size_t>(static_cast<Frames>(region.inBegin) / step * (targetSampleRate / rateGcd));
+            auto keep = [&]() {
+                auto begin = std::max(outPos, region.outBegin);
+                auto end = std::min(outPos + block.size(), region.outEnd);
+                if (begin < end) {
+                    std::copy(block.begin() + static_cast<std::ptrdiff_t>(begin - outPos),
+                              block.begin() + static_cast<std::ptrdiff_t>(end - outPos),
+                              outVec.begin() + static_cast<std::ptrdiff_t>(begin));
+                }
+                outPos += block.size();
+                block.clear();
+            };
+            auto pos = region.inBegin;
+            for (; pos < region.inEnd && outPos < region.outEnd; pos += kResampleBlockFrames) {
+                if (isCancelled()) {
+                    return false;
+                }
+                auto count = std::min(kResampleBlockFrames, region.inEnd - pos);
+                if (!resampler.process(audio.waveform.data() + pos, count, block)) {
+                    Q_EMIT logMsgError(resampler.errorString());
+                    return false;
+                }
+                keep();
+            }
+            if (outPos < region.outEnd) {
+                if (!resampler.flush(block)) {
+                    Q_EMIT logMsgError(resampler.errorString());
+                    return false;
+                }
+                keep();
+            }
+            resampledFrames += std::min(pos, region.inEnd) - region.inBegin;
+        }
+        Q_EMIT logMsgInfo(QString("Converted the sample rate of %1 chunks from %2 Hz to %3 Hz: %4 of %5 s (%6%).")
+                                  .arg(markers.size())
+                                  .arg(sampleRate)
+                                  .arg(targetSampleRate)
+                                  .arg(QString::number(static_cast<double>(resampledFrames) / sampleRate, 'f', 1))
+                                  .arg(QString::number(static_cast<double>(frames) / sampleRate, 'f', 1))
+                                  .arg(QString::number(frames ? 100.0 * resampledFrames / frames : 0.0, 'f', 0)));
+
+        std::swap(audio.waveform, outVec);
+        outVec = {};
+        audio.frames = targetFrames;
+        audio.sampleRate = targetSampleRate;
+        audio.reservation = std::move(outReservation);
+        markers = std::move(targetMarkers);
+        return true;
+    }
+
+    bool Pipeline::slice(const AudioBuffer &audio, MarkerList &markers) {
+        beginStage("slice");
+        StageTimer timer(m_stats, "slice");
+        Q_EMIT logMsgInfo("Slicing audio...");
+        // The slicer keeps one RMS value and one block sum (doubles) per hop.
+        auto hopFrames = std::max<std::size_t>(1, m_options.slicerHopSize * audio.sampleRate / 1000);
+        auto rmsReservation = reserve(MemoryCategory::Waveform,
+                                      2 * (audio.frames / hopFrames + 2) * sizeof(double));
+        Slicer slicer(audio.sampleRate, m_options.slicerThreshold, m_options.slicerMinLength,
+                      m_options.slicerMinInterval, m_options.slicerHopSize, m_options.slicerMaxSilKept);
+        slicer.setThreads(static_cast<int>(std::thread::hardware_concurrency()));
+        markers = slicer.slice(audio.waveform, audio.channels);
+
+        if (markers.empty()) {
+            Q_EMIT logMsgError("Run slicer failed.");
+            return false;
+        }
+        m_stats.chunkCount = markers.size();
+        Q_EMIT logMsgInfo(QString("Slicing succeed. Total chunks: %1").arg(markers.size()));
+        return true;
+    }
+
+    bool Pipeline::infer(InferenceBackend &backend, const AudioBuffer &audio, const MarkerList &markers,
+                         std::vector<NotesPtr> &chunkNotes) {
+        beginStage("inference");
+        StageTimer timer(m_stats, "inference");
+        chunkNotes.clear();
+        chunkNotes.reserve(markers.size());
+        if (!m_resultReservation.isValid()) {
+            m_resultReservation = reserve(MemoryCategory::Result, 0);
+        }
+
+        if (m_progress) {
+            std::size_t chunkFrames = 0;
+            for (const auto &[beginFrame, endFrame] : markers) {
+                chunkFrames += endFrame - beginFrame;
+            }
+            m_progress->setAudioSeconds(static_cast<double>(audio.frames) / audio.sampleRate);
+            m_progress->setChunks(static_cast<int>(markers.size()),
+                                  static_cast<double>(chunkFrames) / audio.sampleRate);
+        }
+        Q_EMIT inferenceStarted(static_cast<double>(audio.frames) / audio.sampleRate,
+                                static_cast<int>(markers.size()));
+        int currentMarkerIndex = 0;
+        for (const auto &[beginFrame, endFrame] : markers) {
+            if (isCancelled()) {
+                return false;
+            }
+            auto currentAudioDuration = (endFrame - beginFrame) * 1000 / audio.sampleRate;
+            Q_EMIT logMsgInfo(QString("Inferring audio chunk %1/%2, length: %3 s")
+                                      .arg(currentMarkerIndex + 1)
+                                      .arg(markers.size())
+                                      .arg(QString::number(currentAudioDuration / 1000.0, 'f', 3)));
+            auto chunkReservation = reserve(MemoryCategory::Chunk, (endFrame - beginFrame) * sizeof(float));
+            auto chunkStart = std::chrono::steady_clock::now();
+            auto notes = backend.infer(audio.waveform, beginFrame, endFrame - beginFrame);
+            std::chrono::duration<double> chunkTime = std::chrono::steady_clock::now() - chunkStart;
+            chunkReservation.release();
+            if (isCancelled()) {
+                // The backend may have stopped mid-chunk; its notes are incomplete.
+                return false;
+            }
+            auto notesSize = notes.note_midi.size();
+            if (notesSize != notes.note_dur.size() || notesSize != notes.note_rest.size()) {
+                Q_EMIT logMsgError("The sizes of `note_midi`, `note_dur`, `note_rest` do not match!");
+                return false;
+            }
+            Q_EMIT logMsgInfo(QString("Audio chunk %1/%2 inference complete.")
+                                      .arg(currentMarkerIndex + 1).arg(markers.size()));
+            m_stats.noteCount += notesSize;
+            m_resultReservation.resize(m_resultReservation.size() +
+                                       notesSize * (sizeof(float) + sizeof(char) + sizeof(float)));
+            chunkNotes.push_back(std::make_shared<const Notes>(std::move(notes)));
+            Q_EMIT chunkInferred(currentMarkerIndex, static_cast<double>(beginFrame) / audio.sampleRate,
+                                 chunkNotes.back());
+            if (m_progress) {
+                m_progress->chunkDone(static_cast<double>(endFrame - beginFrame) / audio.sampleRate,
+                                      chunkTime.count());
+            }
+            ++currentMarkerIndex;
+        }
+        return true;
+    }
+
+    bool Pipeline::writeMidi(const QString &outPath, const AudioBuffer &audio, const MarkerList &markers,
+                             const std::vector<NotesPtr> &chunkNotes, double tempo) {
+        if (isCancelled()) {
+            return false;
+        }
+        beginStage("midi");
+        StageTimer timer(m_stats, "midi");
+        std::size_t noteCount = 0;
+        for (const auto &notes : chunkNotes) {
+            noteCount += notes->note_midi.size();
+        }
+        // Note on + note off per note, plus track and tempo events.
+        auto eventReservation = reserve(MemoryCategory::Result, (2 * noteCount + 2) * sizeof(smf::MidiEvent));
+        smf::MidiFile midi;
+        constexpr int NOTE_VELOCITY = 64;
+        auto trackId = midi.addTrack();
+        midi.addTempo(trackId, 0, tempo);
+        auto mul = tempo * midi.getTicksPerQuarterNote() / 60;
+        auto sampleRate = audio.sampleRate;
+
+        for (std::size_t currentMarkerIndex = 0; currentMarkerIndex < chunkNotes.size(); ++currentMarkerIndex) {
+            const auto &notes = *chunkNotes[currentMarkerIndex];
+            auto beginFrame = markers[currentMarkerIndex].first;
+            auto notesSize = notes.note_midi.size();
+
+            float cumSum = 0.0f, cumSumPrev = 0.0f;
+            int offset = std::lround(beginFrame * mul / sampleRate);
+
+            int start = offset;
+            for (std::size_t i = 0; i < notesSize; ++i) {
+                int noteMidi = std::lround(notes.note_midi[i]);
+                cumSumPrev = cumSum;
+                cumSum += notes.note_dur[i];
+                int noteTick = std::lround(cumSum * mul) - std::lround(cumSumPrev * mul);
+                bool noteRest = notes.note_rest[i];
+
+                int end = start + noteTick;
+
+                if (currentMarkerIndex < markers.size() - 1) {
+                    auto nextBeginFrame = markers[currentMarkerIndex + 1].first;
+                    int nextOffset = std::lround(nextBeginFrame * mul / sampleRate);
+                    if (end > nextOffset) {
+                        end = nextOffset;
+                    }
+                }
+                if (start < end && !noteRest) {
+                    midi.addNoteOn(trackId, start, 0, noteMidi, NOTE_VELOCITY);
+                    midi.addNoteOff(trackId, end, 0, noteMidi);
+                }
+                start = end;
+            }
+        }
+
+        std::ofstream outMidiFile(outPath
+#ifdef _WIN32
+                .toStdWString()
+#else
+                .toStdString()
+#endif
+        , std::ios::binary);
+
+        if (!outMidiFile) {
+            Q_EMIT logMsgError(QString("Can't open output MIDI file: %1").arg(outPath));
+            return false;
+        }
+        midi.write(outMidiFile);
+        return true;
+    }
+
+    MemoryBudget::Reservation Pipeline::reserve(MemoryCategory category, std::size_t bytes) {
+        auto reservation = m_budget.tryAcquire(m_account, category, bytes);
+        if (!reservation.isValid()) {
+            Q_EMIT logMsgInfo(QString("Waiting for memory budget (%1 MB %2)...")
+                                      .arg(QString::number(bytes / (1024.0 * 1024.0), 'f', 1))
+                                      .arg(memoryCategoryName(category)));
+            auto waitStart = std::chrono::steady_clock::now();
+            reservation = m_budget.acquire(m_account, category, bytes);
+            std::chrono::duration<double> waited = std::chrono::steady_clock::now() - waitStart;
+            ++m_stats.memoryWaits;
+            m_stats.memoryWaitSeconds += waited.count();
+        }
+        auto budgetStats = m_budget.stats();
+        m_stats.memoryBudget = budgetStats.capacity;
+        m_stats.memoryPeak = std::max(m_stats.memoryPeak, budgetStats.inUse);
+        return reservation;
+    }
+
+    void Pipeline::setPreprocessOptions(const PreprocessOptions &options) {
+        m_options = options;
+    }
+
+    const PreprocessOptions &Pipeline::preprocessOptions() const {
+        return m_options;
+    }
+
+    void Pipeline::setPreprocessCache(PreprocessCache *cache) {
+        m_cache = cache;
+    }
+
+    void Pipeline::setWaveformOverview(bool enabled) {
+        m_waveformOverview = enabled;
+    }
+
+    void Pipeline::setProgressTracker(ProgressTracker *tracker) {
+        m_progress = tracker;
+    }
+
+    void Pipeline::setCancelToken(const CancelToken *token) {
+        m_cancel = token;
+    }
+
+    void Pipeline::setPreprocessed(std::unique_ptr<PreprocessedInput> input) {
+        m_preprocessed = std::move(input);
+    }
+
+    bool Pipeline::isCancelled() const {
+        return m_cancel && m_cancel->isCancelled();
+    }
+
+    void Pipeline::beginStage(const char *stage) {
+        if (m_progress) {
+            m_progress->beginStage(stage);
+        }
+    }
+
+    PipelineStats &Pipeline::stats() {
+        return m_stats;
+    }
+
+    const PipelineStats &Pipeline::stats() const {
+        return m_stats;
+    }
+
+}  // namespace some
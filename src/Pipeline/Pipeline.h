@@ -0,0 +1,150 @@
+#ifndef SOME_GUI_PIPELINE_H
+#define SOME_GUI_PIPELINE_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+
+#include "Dsp/WaveformMipmap.h"
+#include "Slicer/Slicer.h"
+#include "Inference/NotesStruct.h"
+#include "JobResult.h"
+#include "MemoryBudget.h"
+#include "PipelineStats.h"
+
+namespace some {
+
+    class CancelToken;
+    class InferenceBackend;
+    class PreprocessCache;
+    class ProgressTracker;
+    struct PreprocessedInput;
+
+    struct AudioBuffer {
+        std::vector<float> waveform;  // interleaved
+        int channels = 0;
+        int sampleRate = 0;
+        std::size_t frames = 0;
+        // Bytes of `waveform` charged to the memory budget.
+        MemoryBudget::Reservation reservation;
+    };
+
+    // Everything that decides the preprocessed waveform and the markers.
+    struct PreprocessOptions {
+        int targetSampleRate = 44100;
+        double slicerThreshold = -40.0;       // dB
+        std::size_t slicerMinLength = 5000;   // ms
+        std::size_t slicerMinInterval = 300;  // ms
+        std::size_t slicerHopSize = 20;       // ms
+        std::size_t slicerMaxSilKept = 1000;  // ms
+
+        // Identifies these options, and the resampler the build uses, in preprocess cache keys.
+        QString cacheKey() const;
+    };
+
+    // The stages between an audio file and a MIDI file:
+    // decode -> downmix -> slice -> resample -> inference -> midi.
+    // Each stage can be run on its own; run() chains all of them. Slicing runs at the rate of the
+    // file, so only the chunks it keeps are resampled.
+    //
+    // Waveform buffers, chunks in flight and results are charged to a MemoryBudget, and every
+    // stage waits for the budget before allocating. One Pipeline object is one job.
+    class Pipeline : public QObject {
+        Q_OBJECT
+    public:
+        static constexpr int kTargetSampleRate = 44100;
+
+        explicit Pipeline(QObject *parent = nullptr);
+        explicit Pipeline(MemoryBudget &budget, QObject *parent = nullptr);
+        ~Pipeline() override;
+
+        // On success the markers and notes are published as result().
+        bool run(InferenceBackend &backend, const QString &audioPath, const QString &outPath, double tempo);
+
+        // decode -> downmix -> slice -> resampleChunks, or a single read if the preprocess cache has the
+        // file, or nothing if setPreprocessed() was given this file.
+        bool preprocess(const QString &audioPath, AudioBuffer &audio, MarkerList &markers);
+
+        bool loadAudio(const QString &audioPath, AudioBuffer &audio);
+        void convertToMono(AudioBuffer &audio);
+        bool slice(const AudioBuffer &audio, MarkerList &markers);
+        // Resamples only the chunks in `markers`, with a margin for the filter on both sides, and
+        // converts the markers to the new rate. The waveform keeps its length; the silence between
+        // the chunks is left as zeros.
+        bool resampleChunks(AudioBuffer &audio, MarkerList &markers, int targetSampleRate = kTargetSampleRate);
+        bool infer(InferenceBackend &backend, const AudioBuffer &audio, const MarkerList &markers,
+                   std::vector<NotesPtr> &chunkNotes);
+        bool writeMidi(const QString &outPath, const AudioBuffer &audio, const MarkerList &markers,
+                       const std::vector<NotesPtr> &chunkNotes, double tempo);
+
+        // Moves the markers and notes of a finished job into an immutable result. `audio` and `markers`
+        // are left empty and the waveform is freed with its budget reservation.
+        JobResultPtr publish(const QString &audioPath, AudioBuffer &audio, MarkerList &markers,
+                             std::vector<NotesPtr> chunkNotes);
+        // The result of the last successful run(), or nullptr.
+        JobResultPtr result() const;
+
+        PipelineStats &stats();
+        const PipelineStats &stats() const;
+
+        void setPreprocessOptions(const PreprocessOptions &options);
+        const PreprocessOptions &preprocessOptions() const;
+        // nullptr disables caching. The cache must outlive the pipeline.
+        void setPreprocessCache(PreprocessCache *cache);
+        // Build a min/max mipmap of the waveform for waveformReady(), on a background thread while
+        // the file is decoded. Off by default.
+        void setWaveformOverview(bool enabled);
+        // Receives the stages, the audio length and every inferred chunk; run() finishes it.
+        // nullptr (the default) disables progress reports. The tracker must outlive the pipeline.
+        void setProgressTracker(ProgressTracker *tracker);
+        // Checked between stages, between the blocks of decoding and resampling, and between inference
+        // chunks. A cancelled stage returns false without logging an error. The token must outlive the
+        // pipeline. Cancel the backend too to stop a chunk being inferred.
+        void setCancelToken(const CancelToken *token);
+        // Output of an earlier preprocess() (see PreprocessJob). The next preprocess() of the same
+        // file with the same options uses it instead of running the stages.
+        void setPreprocessed(std::unique_ptr<PreprocessedInput> input);
+
+    Q_SIGNALS:
+        void logMsgInfo(const QString &msg);
+        void logMsgError(const QString &msg);
+        // Emitted by infer() on the thread running it: once before the first chunk, then after every
+        // chunk with the notes it produced. The notes are shared, so a queued connection is cheap.
+        void inferenceStarted(double audioSeconds, int chunkCount);
+        // Emitted by preprocess(): the mipmap of the decoded (or cached) mono waveform, if enabled,
+        // and the chunk boundaries, in frames at `sampleRate`.
+        void waveformReady(const some::dsp::WaveformMipmapPtr &mipmap);
+        void markersReady(const some::MarkerListPtr &markers, int sampleRate);
+        void chunkInferred(int index, double onsetSeconds, const some::NotesPtr &notes);
+
+    private:
+        MemoryBudget::Reservation reserve(MemoryCategory category, std::size_t bytes);
+        void beginStage(const char *stage);
+        bool loadFromCache(const QByteArray &key, AudioBuffer &audio, MarkerList &markers);
+        bool usePreprocessed(const QString &audioPath, AudioBuffer &audio, MarkerList &markers);
+        bool isCancelled() const;
+
+        PipelineStats m_stats;
+        PreprocessOptions m_options;
+        PreprocessCache *m_cache = nullptr;
+        bool m_waveformOverview = false;
+        // Overview of the last decoded source, stored with its cache entry.
+        dsp::WaveformMipmapPtr m_sourceOverview;
+        ProgressTracker *m_progress = nullptr;
+        const CancelToken *m_cancel = nullptr;
+        std::unique_ptr<PreprocessedInput> m_preprocessed;
+        MemoryBudget &m_budget;
+        MemoryBudget::Account m_account;
+        // Notes produced by infer(), held until the job ends.
+        MemoryBudget::Reservation m_resultReservation;
+        JobResultPtr m_result;
+    };  // class Pipeline
+
+}  // namespace some
+
+Q_DECLARE_METATYPE(some::dsp::WaveformMipmapPtr)
+
+#endif //SOME_GUI_PIPELINE_H
@@ -0,0 +1,48 @@
+#include "PipelineStats.h"
+
+namespace some {
+
+    void PipelineStats::addStageTime(const std::string &stage, double seconds) {
+        for (auto &[name, value] : stageSeconds) {
+            if (name == stage) {
+                value += seconds;
+                return;
+            }
+        }
+        stageSeconds.emplace_back(stage, seconds);
+    }
+
+    double PipelineStats::stageTime(const std::string &stage) const {
+        for (const auto &[name, value] : stageSeconds) {
+            if (name == stage) {
+                return value;
+            }
+        }
+        return 0.0;
+    }
+
+    double PipelineStats::totalSeconds() const {
+        double total = 0.0;
+        for (const auto &[name, value] : stageSeconds) {
+            total += value;
+        }
+        return total;
+    }
+
+    double PipelineStats::realTimeFactor() const {
+        return (audioSeconds > 0.0) ? totalSeconds() / audioSeconds : 0.0;
+    }
+
+    StageTimer::StageTimer(PipelineStats &stats, std::string stage)
+            : m_stats(stats), m_stage(std::move(stage)), m_start(std::chrono::steady_clock::now()),
+              m_copiesAtStart(threadCopyStats()) {}
+
+    StageTimer::~StageTimer() {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+        m_stats.addStageTime(m_stage, elapsed.count());
+        auto copies = threadCopyStats();
+        m_stats.copies += copies.copies - m_copiesAtStart.copies;
+        m_stats.copiedBytes += copies.bytes - m_copiesAtStart.bytes;
+    }
+
+}  // namespace some
@@ -0,0 +1,62 @@
+#ifndef SOME_GUI_PIPELINESTATS_H
+#define SOME_GUI_PIPELINESTATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Utils/CopyStats.h"
+
+namespace some {
+
+    struct PipelineStats {
+        // Wall time per stage in seconds, in the order the stages ran.
+        std::vector<std::pair<std::string, double>> stageSeconds;
+        double audioSeconds = 0.0;
+        std::size_t chunkCount = 0;
+        std::size_t noteCount = 0;
+
+        // Memory budget: capacity (0 = unlimited), the most budgeted bytes in use at any
+        // reservation made by this job, and how often and how long the job waited for it.
+        std::size_t memoryBudget = 0;
+        std::size_t memoryPeak = 0;
+        std::size_t memoryWaits = 0;
+        double memoryWaitSeconds = 0.0;
+
+        // Whether the preprocess cache was consulted for this job, and whether it had the file.
+        bool cacheEnabled = false;
+        bool cacheHit = false;
+
+        // Sample and note buffers deep-copied by the stages of this job, and their size.
+        std::size_t copies = 0;
+        std::size_t copiedBytes = 0;
+
+        void addStageTime(const std::string &stage, double seconds);
+        double stageTime(const std::string &stage) const;
+        double totalSeconds() const;
+        // Processing time divided by audio duration. Below 1.0 means faster than real time.
+        double realTimeFactor() const;
+    };
+
+    // Adds the lifetime of the object to a stage of PipelineStats, and the copies the current
+    // thread made meanwhile to its copy counters. Stages don't nest.
+    class StageTimer {
+    public:
+        StageTimer(PipelineStats &stats, std::string stage);
+        ~StageTimer();
+
+        StageTimer(const StageTimer &) = delete;
+        StageTimer &operator=(const StageTimer &) = delete;
+
+    private:
+        PipelineStats &m_stats;
+        std::string m_stage;
+        std::chrono::steady_clock::time_point m_start;
+        CopyStats m_copiesAtStart;
+    };
+
+}  // namespace some
+
+#endif //SOME_GUI_PIPELINESTATS_H
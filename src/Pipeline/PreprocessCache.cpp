@@ -0,0 +1,294 @@
+#include <cstdlib>
+#include <cstring>
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "PreprocessCache.h"
+
+namespace some {
+
+    namespace {
+        constexpr char kMagic[8] = { 'S', 'O', 'M', 'E', 'P', 'R', 'E', '\0' };
+        constexpr std::uint32_t kVersion = 2;
+        constexpr std::uint32_t kByteOrderMark = 0x01020304;
+        constexpr std::uint64_t kDataAlignment = 4096;  // page size, so the samples can be mapped
+        const char *const kSuffix = ".somecache";
+
+        struct CacheHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrder;
+            std::uint32_t sampleRate;
+            std::uint32_t overviewSampleRate;
+            std::uint64_t frames;
+            std::uint64_t markerCount;
+            std::uint64_t dataOffset;
+            // Level 0 of the overview follows the markers; 0 entries if there is none.
+            std::uint64_t overviewFrames;
+            std::uint64_t overviewEntries;
+        };
+        static_assert(sizeof(CacheHeader) == 64, "CacheHeader must be 64 bytes");
+
+        std::uint64_t alignUp(std::uint64_t value, std::uint64_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    int PreprocessCache::Entry::sampleRate() const {
+        return m_sampleRate;
+    }
+
+    std::size_t PreprocessCache::Entry::frames() const {
+        return m_frames;
+    }
+
+    const float *PreprocessCache::Entry::samples() const {
+        return reinterpret_cast<const float *>(m_map);
+    }
+
+    const MarkerList &PreprocessCache::Entry::markers() const {
+        return m_markers;
+    }
+
+    dsp::WaveformMipmapPtr PreprocessCache::Entry::overview() const {
+        return m_overview;
+    }
+
+    PreprocessCache::PreprocessCache(const QString &directory, std::uint64_t maxBytes)
+            : m_directory(directory), m_maxBytes(maxBytes) {
+        QDir().mkpath(m_directory);
+    }
+
+    PreprocessCache *PreprocessCache::global() {
+        static std::unique_ptr<PreprocessCache> cache = []() -> std::unique_ptr<PreprocessCache> {
+            std::uint64_t maxMegabytes = 2048;
+            if (const char *env = std::getenv("SOME_CACHE_MAX_MB")) {
+                maxMegabytes = std::strtoull(env, nullptr, 10);
+            }
+            auto location = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+            if (maxMegabytes == 0 || location.isEmpty()) {
+                return nullptr;
+            }
+            return std::make_unique<PreprocessCache>(location + "/preprocess", maxMegabytes * 1024 * 1024);
+        }();
+        return cache.get();
+    }
+
+    QString PreprocessCache::directory() const {
+        return m_directory;
+    }
+
+    std::uint64_t PreprocessCache::maxBytes() const {
+        return m_maxBytes;
+    }
+
+    QByteArray PreprocessCache::makeKey(const QString &audioPath, const QString &params) {
+        auto hash = contentHash(audioPath);
+        if (hash.isEmpty()) {
+            return {};
+        }
+        QCryptographicHash keyHash(QCryptographicHash::Sha1);
+        keyHash.addData(hash);
+        keyHash.addData(params.toUtf8());
+        return keyHash.result().toHex();
+    }
+
+    QByteArray PreprocessCache::contentHash(const QString &audioPath) {
+        QFileInfo info(audioPath);
+        auto canonicalPath = info.canonicalFilePath();
+        if (canonicalPath.isEmpty()) {
+            return {};
+        }
+        auto size = info.size();
+        auto modified = info.lastModified();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_hashMemo.constFind(canonicalPath);
+            if (it != m_hashMemo.constEnd() && it->size == size && it->modified == modified) {
+                return it->hash;
+            }
+        }
+
+        QFile file(canonicalPath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return {};
+        }
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        if (!hash.addData(&file)) {
+            return {};
+        }
+        auto result = hash.result();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_hashMemo.insert(canonicalPath, {size, modified, result});
+        }
+        return result;
+    }
+
+    QString PreprocessCache::entryPath(const QByteArray &key) const {
+        return m_directory + '/' + QString::fromLatin1(key) + kSuffix;
+    }
+
+    std::unique_ptr<PreprocessCache::Entry> PreprocessCache::open(const QByteArray &key) {
+        auto miss = [this]() -> std::unique_ptr<Entry> {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.misses;
+            return nullptr;
+        };
+        if (key.isEmpty()) {
+            return miss();
+        }
+
+        auto entry = std::make_unique<Entry>();
+        entry->m_file.setFileName(entryPath(key));
+        if (!entry->m_file.open(QIODevice::ReadOnly)) {
+            return miss();
+        }
+
+        // The header is checked with divisions, so a corrupt count can't wrap around into a size that
+        // passes and then fails to allocate.
+        CacheHeader header {};
+        auto fileSize = static_cast<std::uint64_t>(entry->m_file.size());
+        bool valid = entry->m_file.read(reinterpret_cast<char *>(&header), sizeof(header)) == sizeof(header) &&
+                     std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+                     header.version == kVersion &&
+                     header.byteOrder == kByteOrderMark &&
+                     header.dataOffset >= sizeof(header) && header.dataOffset <= fileSize &&
+                     header.markerCount <= (header.dataOffset - sizeof(header)) / (2 * sizeof(std::uint64_t)) &&
+                     header.overviewEntries <= (header.dataOffset - sizeof(header) -
+                                                header.markerCount * 2 * sizeof(std::uint64_t)) / sizeof(dsp::MinMax) &&
+                     (fileSize - header.dataOffset) % sizeof(float) == 0 &&
+                     header.frames == (fileSize - header.dataOffset) / sizeof(float);
+        if (valid) {
+            std::vector<std::uint64_t> markerData(header.markerCount * 2);
+            auto markerBytes = static_cast<qint64>(markerData.size() * sizeof(std::uint64_t));
+            valid = entry->m_file.read(reinterpret_cast<char *>(markerData.data()), markerBytes) == markerBytes;
+            entry->m_markers.reserve(header.markerCount);
+            for (std::size_t i = 0; valid && i < header.markerCount; ++i) {
+                auto begin = markerData[2 * i];
+                auto end = markerData[2 * i + 1];
+                // Markers index the waveform, so one past it would be read out of bounds.
+                valid = begin <= end && end <= header.frames;
+                entry->m_markers.emplace_back(begin, end);
+            }
+        }
+        if (valid && header.overviewEntries > 0) {
+            std::vector<dsp::MinMax> base(header.overviewEntries);
+            auto baseBytes = static_cast<qint64>(base.size() * sizeof(dsp::MinMax));
+            valid = entry->m_file.read(reinterpret_cast<char *>(base.data()), baseBytes) == baseBytes;
+            if (valid) {
+                // Rejects an entry count that doesn't match the frames.
+                entry->m_overview = dsp::WaveformMipmapBuilder::fromBaseLevel(
+                        std::move(base), header.overviewFrames, static_cast<int>(header.overviewSampleRate));
+                valid = (entry->m_overview != nullptr);
+            }
+        }
+        if (valid && header.frames > 0) {
+            entry->m_map = entry->m_file.map(static_cast<qint64>(header.dataOffset),
+                                             static_cast<qint64>(header.frames * sizeof(float)));
+            valid = (entry->m_map != nullptr);
+        }
+        if (!valid) {
+            // Truncated, corrupt or written by another version: drop it.
+            entry->m_file.close();
+            entry->m_file.remove();
+            return miss();
+        }
+        entry->m_sampleRate = static_cast<int>(header.sampleRate);
+        entry->m_frames = header.frames;
+
+        // Most recently used
+        entry->m_file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.hits;
+        m_stats.bytesRead += static_cast<std::uint64_t>(entry->m_file.size());
+        return entry;
+    }
+
+    bool PreprocessCache::store(const QByteArray &key, const std::vector<float> &waveform, int sampleRate,
+                                const MarkerList &markers, const dsp::WaveformMipmap *overview) {
+        if (key.isEmpty()) {
+            return false;
+        }
+        CacheHeader header {};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.byteOrder = kByteOrderMark;
+        header.sampleRate = static_cast<std::uint32_t>(sampleRate);
+        header.frames = waveform.size();
+        header.markerCount = markers.size();
+        static const std::vector<dsp::MinMax> kNoOverview;
+        const auto &overviewBase = (overview && overview->levelCount() > 0) ? overview->level(0) : kNoOverview;
+        if (!overviewBase.empty()) {
+            header.overviewSampleRate = static_cast<std::uint32_t>(overview->sampleRate());
+            header.overviewFrames = overview->frames();
+            header.overviewEntries = overviewBase.size();
+        }
+        header.dataOffset = alignUp(sizeof(header) + markers.size() * 2 * sizeof(std::uint64_t) +
+                                    overviewBase.size() * sizeof(dsp::MinMax), kDataAlignment);
+
+        std::vector<std::uint64_t> markerData;
+        markerData.reserve(markers.size() * 2);
+        for (const auto &[begin, end] : markers) {
+            markerData.push_back(begin);
+            markerData.push_back(end);
+        }
+        auto markerBytes = static_cast<qint64>(markerData.size() * sizeof(std::uint64_t));
+        auto overviewBytes = static_cast<qint64>(overviewBase.size() * sizeof(dsp::MinMax));
+        QByteArray padding(static_cast<int>(header.dataOffset - sizeof(header) - markerBytes - overviewBytes), '\0');
+        auto sampleBytes = static_cast<qint64>(waveform.size() * sizeof(float));
+
+        // QSaveFile writes to a temporary file and renames it, so readers never see a partial entry.
+        QSaveFile file(entryPath(key));
+        if (!file.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+        bool ok = file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == sizeof(header) &&
+                  file.write(reinterpret_cast<const char *>(markerData.data()), markerBytes) == markerBytes &&
+                  file.write(reinterpret_cast<const char *>(overviewBase.data()), overviewBytes) == overviewBytes &&
+                  file.write(padding) == padding.size() &&
+                  file.write(reinterpret_cast<const char *>(waveform.data()), sampleBytes) == sampleBytes;
+        if (!ok || !file.commit()) {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.stores;
+            m_stats.bytesWritten += header.dataOffset + static_cast<std::uint64_t>(sampleBytes);
+        }
+        evict();
+        return true;
+    }
+
+    void PreprocessCache::evict() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Oldest first
+        auto entries = QDir(m_directory).entryInfoList({QString("*") + kSuffix}, QDir::Files,
+                                                       QDir::Time | QDir::Reversed);
+        std::uint64_t totalBytes = 0;
+        for (const auto &entry : entries) {
+            totalBytes += static_cast<std::uint64_t>(entry.size());
+        }
+        for (const auto &entry : entries) {
+            if (totalBytes <= m_maxBytes) {
+                break;
+            }
+            if (QFile::remove(entry.absoluteFilePath())) {
+                totalBytes -= static_cast<std::uint64_t>(entry.size());
+                ++m_stats.evictions;
+            }
+        }
+    }
+
+    PreprocessCache::Stats PreprocessCache::stats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+}  // namespace some
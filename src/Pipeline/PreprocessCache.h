@@ -0,0 +1,101 @@
+#ifndef SOME_GUI_PREPROCESSCACHE_H
+#define SOME_GUI_PREPROCESSCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QString>
+
+#include "Dsp/WaveformMipmap.h"
+#include "Slicer/Slicer.h"
+
+namespace some {
+
+    // On-disk cache of preprocessed audio: the mono float waveform at the model sample rate plus the
+    // slicer markers, keyed by a hash of the input file content and the preprocessing parameters.
+    // The waveform only holds the chunks, so the overview of the decoded source is stored with it.
+    //
+    // One file per entry. The samples are stored raw and page aligned after a small header, so an
+    // entry is read by mapping it instead of parsing it. A hit touches the file's modification time;
+    // when the directory grows past the size cap, the least recently used entries are removed.
+    //
+    // Thread-safe.
+    class PreprocessCache {
+    public:
+        struct Stats {
+            std::size_t hits = 0;
+            std::size_t misses = 0;
+            std::size_t stores = 0;
+            std::size_t evictions = 0;
+            std::uint64_t bytesRead = 0;
+            std::uint64_t bytesWritten = 0;
+        };
+
+        // A mapped cache entry. The sample pointer is valid while the entry lives.
+        class Entry {
+        public:
+            int sampleRate() const;
+            std::size_t frames() const;
+            const float *samples() const;
+            const MarkerList &markers() const;
+            // Of the source before resampling; nullptr if the entry was stored without one.
+            dsp::WaveformMipmapPtr overview() const;
+
+        private:
+            friend class PreprocessCache;
+            QFile m_file;
+            const uchar *m_map = nullptr;
+            int m_sampleRate = 0;
+            std::size_t m_frames = 0;
+            MarkerList m_markers;
+            dsp::WaveformMipmapPtr m_overview;
+        };
+
+        PreprocessCache(const QString &directory, std::uint64_t maxBytes);
+
+        // Cache in the user cache directory, sized by the SOME_CACHE_MAX_MB environment variable
+        // (default 2048). Returns nullptr if the cache is disabled with SOME_CACHE_MAX_MB=0.
+        static PreprocessCache *global();
+
+        QString directory() const;
+        std::uint64_t maxBytes() const;
+
+        // Hash of the file content combined with `params`. Returns an empty key if the file can't be read.
+        // The content hash is remembered per path, size and modification time for the process lifetime.
+        QByteArray makeKey(const QString &audioPath, const QString &params);
+
+        // Returns nullptr on a miss.
+        std::unique_ptr<Entry> open(const QByteArray &key);
+        bool store(const QByteArray &key, const std::vector<float> &waveform, int sampleRate,
+                   const MarkerList &markers, const dsp::WaveformMipmap *overview = nullptr);
+
+        Stats stats() const;
+
+    private:
+        QString entryPath(const QByteArray &key) const;
+        QByteArray contentHash(const QString &audioPath);
+        void evict();
+
+        QString m_directory;
+        std::uint64_t m_maxBytes;
+
+        mutable std::mutex m_mutex;
+        Stats m_stats;
+        struct HashMemo {
+            qint64 size;
+            QDateTime modified;
+            QByteArray hash;
+        };
+        QHash<QString, HashMemo> m_hashMemo;
+    };  // class PreprocessCache
+
+}  // namespace some
+
+#endif //SOME_GUI_PREPROCESSCACHE_H
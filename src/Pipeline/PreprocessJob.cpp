@@ -0,0 +1,63 @@
+#include <chrono>
+
+#include <QFileInfo>
+
+#include "PreprocessJob.h"
+
+namespace some {
+
+    PreprocessJob::PreprocessJob(const QString &audioPath, const PreprocessOptions &options,
+                                 PreprocessCache *cache, QObject *parent)
+            : QThread(parent), m_audioPath(audioPath), m_options(options), m_cache(cache) {}
+
+    QString PreprocessJob::audioPath() const {
+        return m_audioPath;
+    }
+
+    void PreprocessJob::cancel() {
+        m_cancel.cancel();
+    }
+
+    bool PreprocessJob::isCancelled() const {
+        return m_cancel.isCancelled();
+    }
+
+    PreprocessedInputPtr PreprocessJob::take(const PreprocessOptions &options) {
+        if (!m_result || m_cancel.isCancelled() || m_result->optionsKey != options.cacheKey()) {
+            return nullptr;
+        }
+        return std::move(m_result);
+    }
+
+    void PreprocessJob::run() {
+        auto start = std::chrono::steady_clock::now();
+        auto result = std::make_unique<PreprocessedInput>();
+        result->audioPath = m_audioPath;
+        QFileInfo info(m_audioPath);
+        result->fileSize = info.size();
+        result->fileModified = info.lastModified();
+        result->optionsKey = m_options.cacheKey();
+
+        Pipeline pipeline;
+        pipeline.setPreprocessOptions(m_options);
+        pipeline.setPreprocessCache(m_cache);
+        pipeline.setWaveformOverview(true);
+        pipeline.setCancelToken(&m_cancel);
+        auto *log = &result->log;
+        connect(&pipeline, &Pipeline::logMsgInfo, [log](const QString &msg) {
+            log->append(msg);
+        });
+        // Errors are not kept: the job that would have used the result runs the stages itself and
+        // reports them then.
+        connect(&pipeline, &Pipeline::waveformReady, [&result](const dsp::WaveformMipmapPtr &mipmap) {
+            result->mipmap = mipmap;
+        });
+        if (!pipeline.preprocess(m_audioPath, result->audio, result->markers) || m_cancel.isCancelled()) {
+            return;
+        }
+        result->stats = pipeline.stats();
+        result->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        m_result = std::move(result);
+    }
+
+}  // namespace some
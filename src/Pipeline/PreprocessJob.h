@@ -0,0 +1,67 @@
+#ifndef SOME_GUI_PREPROCESSJOB_H
+#define SOME_GUI_PREPROCESSJOB_H
+
+#include <memory>
+
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+
+#include "Utils/CancelToken.h"
+#include "Pipeline.h"
+
+namespace some {
+
+    class PreprocessCache;
+
+    // The output of Pipeline::preprocess() for one file, made by one pipeline and handed to another.
+    struct PreprocessedInput {
+        QString audioPath;
+        // Of the file when decoding started; a job finding the file changed since decodes it again.
+        qint64 fileSize = -1;
+        QDateTime fileModified;
+        // PreprocessOptions::cacheKey() of the options it was made with.
+        QString optionsKey;
+        AudioBuffer audio;
+        MarkerList markers;
+        dsp::WaveformMipmapPtr mipmap;
+        PipelineStats stats;
+        // What the pipeline logged, so the job that uses the result can show it.
+        QStringList log;
+        double seconds = 0.0;
+    };
+
+    using PreprocessedInputPtr = std::unique_ptr<PreprocessedInput>;
+
+    // Decodes, resamples and slices a file on a background thread before anyone asked for it, e.g.
+    // as soon as the user picks the input, so a job started later finds the work done. Cancelling
+    // stops the pipeline at its next block; the thread then ends on its own.
+    class PreprocessJob : public QThread {
+        Q_OBJECT
+    public:
+        PreprocessJob(const QString &audioPath, const PreprocessOptions &options, PreprocessCache *cache,
+                      QObject *parent = nullptr);
+
+        QString audioPath() const;
+        void cancel();
+        bool isCancelled() const;
+
+        // The result if the run succeeded with the same options and was not cancelled, otherwise
+        // nullptr. The result is handed over once. Only call it after the thread has finished.
+        PreprocessedInputPtr take(const PreprocessOptions &options);
+
+    protected:
+        void run() override;
+
+    private:
+        QString m_audioPath;
+        PreprocessOptions m_options;
+        PreprocessCache *m_cache;
+        CancelToken m_cancel;
+        PreprocessedInputPtr m_result;
+    };  // class PreprocessJob
+
+}  // namespace some
+
+#endif //SOME_GUI_PREPROCESSJOB_H
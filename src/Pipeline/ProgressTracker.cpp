@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cmath>
+
+#include <QSettings>
+
+#include "ProgressTracker.h"
+
+namespace some {
+
+    namespace {
+        // Share of the progress bar before inference (decoding, resampling, slicing) and after it.
+        constexpr double kPreprocessShare = 0.05;
+        constexpr double kMidiShare = 0.02;
+
+        int preprocessStep(const QString &stage) {
+            if (stage == "cache" || stage == "decode") {
+                return 0;
+            }
+            if (stage == "downmix") {
+                return 1;
+            }
+            if (stage == "slice") {
+                return 2;
+            }
+            return 3;  // resample
+        }
+
+        QSettings historySettings() {
+            return QSettings("SOME", "SOME-gui");
+        }
+
+        QString historyPath(const QString &key) {
+            return "rtf/" + key;
+        }
+
+        QString formatDuration(double seconds) {
+            auto total = static_cast<long long>(std::ceil(seconds));
+            return QString("%1:%2").arg(total / 60).arg(total % 60, 2, 10, QChar('0'));
+        }
+    }
+
+    QString ProgressReport::describe() const {
+        QString text;
+        if (stage == "inference") {
+            text = QString("Inference %1/%2 chunks, %3 of %4 s")
+                    .arg(chunksDone).arg(chunkCount)
+                    .arg(processedSeconds, 0, 'f', 1).arg(inferenceSeconds, 0, 'f', 1);
+        }
+        else if (stage == "done") {
+            text = "Done";
+        }
+        else {
+            text = stage.isEmpty() ? QString("Starting") : stage.at(0).toUpper() + stage.mid(1);
+        }
+        if (realTimeFactor > 0.0 && stage != "done") {
+            text += QString(", RTF %1").arg(realTimeFactor, 0, 'f', 3);
+        }
+        if (etaSeconds >= 0.0 && stage != "done") {
+            text += ", ETA " + formatDuration(etaSeconds);
+        }
+        return text;
+    }
+
+    ProgressTracker::ProgressTracker(QObject *parent) : QObject(parent) {}
+
+    void ProgressTracker::setHistoryKey(const QString &key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_historyKey = key;
+        m_historyRtf = key.isEmpty() ? 0.0 : historicalRealTimeFactor(key);
+    }
+
+    void ProgressTracker::setMinimumInterval(int msecs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_minimumIntervalMs = msecs;
+    }
+
+    void ProgressTracker::beginStage(const QString &stage) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stage = stage;
+        }
+        emitReport(true);
+    }
+
+    void ProgressTracker::setAudioSeconds(double seconds) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_audioSeconds = seconds;
+    }
+
+    void ProgressTracker::setChunks(int count, double seconds) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_chunkCount = count;
+        m_inferenceSeconds = seconds;
+    }
+
+    void ProgressTracker::chunkDone(double audioSeconds, double computeSeconds) {
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_chunksDone;
+            m_processedSeconds += audioSeconds;
+            m_computeSeconds += computeSeconds;
+            last = m_chunksDone >= m_chunkCount;
+        }
+        emitReport(last);
+    }
+
+    void ProgressTracker::finish() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stage = "done";
+            if (!m_historyKey.isEmpty() && m_processedSeconds > 0.0) {
+                auto measured = m_computeSeconds / m_processedSeconds;
+                auto stored = m_historyRtf > 0.0 ? kHistoryDecay * m_historyRtf + (1.0 - kHistoryDecay) * measured
+                                                 : measured;
+                auto settings = historySettings();
+                settings.setValue(historyPath(m_historyKey), stored);
+            }
+        }
+        emitReport(true);
+    }
+
+    ProgressReport ProgressTracker::report() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return makeReport();
+    }
+
+    double ProgressTracker::historicalRealTimeFactor(const QString &key) {
+        return historySettings().value(historyPath(key), 0.0).toDouble();
+    }
+
+    ProgressReport ProgressTracker::makeReport() const {
+        ProgressReport report;
+        report.stage = m_stage;
+        report.audioSeconds = m_audioSeconds;
+        report.inferenceSeconds = std::max(0.0, m_inferenceSeconds);
+        report.processedSeconds = m_processedSeconds;
+        report.chunksDone = m_chunksDone;
+        report.chunkCount = m_chunkCount;
+
+        // The measured RTF, pulled towards the historical one while little audio has been measured.
+        if (m_historyRtf > 0.0) {
+            report.realTimeFactor = (m_historyRtf * kHistoryWeightSeconds + m_computeSeconds) /
+                                    (kHistoryWeightSeconds + m_processedSeconds);
+        }
+        else if (m_processedSeconds > 0.0) {
+            report.realTimeFactor = m_computeSeconds / m_processedSeconds;
+        }
+
+        // Until the slicer has run, the whole file is the best guess of what will be inferred.
+        double totalSeconds = m_inferenceSeconds >= 0.0 ? m_inferenceSeconds : m_audioSeconds;
+        double audioFraction = totalSeconds > 0.0 ? std::min(1.0, m_processedSeconds / totalSeconds) : 0.0;
+        if (m_chunkCount > 0 && m_chunksDone >= m_chunkCount) {
+            audioFraction = 1.0;
+        }
+        if (m_stage == "done") {
+            report.fraction = 1.0;
+            report.etaSeconds = 0.0;
+        }
+        else if (m_stage == "midi") {
+            report.fraction = 1.0 - kMidiShare;
+            report.etaSeconds = 0.0;
+        }
+        else if (m_stage == "inference") {
+            report.fraction = kPreprocessShare + (1.0 - kPreprocessShare - kMidiShare) * audioFraction;
+        }
+        else if (!m_stage.isEmpty()) {
+            report.fraction = kPreprocessShare * preprocessStep(m_stage) / 4.0;
+        }
+        if (report.etaSeconds < 0.0 && report.realTimeFactor > 0.0 && totalSeconds > 0.0) {
+            report.etaSeconds = std::max(0.0, totalSeconds - m_processedSeconds) * report.realTimeFactor;
+        }
+        return report;
+    }
+
+    void ProgressTracker::emitReport(bool force) {
+        ProgressReport report;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto now = std::chrono::steady_clock::now();
+            if (!force && m_emitted && now - m_lastEmit < std::chrono::milliseconds(m_minimumIntervalMs)) {
+                return;
+            }
+            m_emitted = true;
+            m_lastEmit = now;
+            report = makeReport();
+        }
+        Q_EMIT progressChanged(report);
+    }
+
+}  // namespace some
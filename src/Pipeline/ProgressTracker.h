@@ -0,0 +1,92 @@
+#ifndef SOME_GUI_PROGRESSTRACKER_H
+#define SOME_GUI_PROGRESSTRACKER_H
+
+#include <chrono>
+#include <mutex>
+
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+
+namespace some {
+
+    struct ProgressReport {
+        QString stage;                  // decode, downmix, resample, slice, inference, midi or done
+        double audioSeconds = 0.0;      // length of the input, 0 until decoded
+        double inferenceSeconds = 0.0;  // audio of all chunks, without the gaps the slicer dropped
+        double processedSeconds = 0.0;  // audio of the chunks inferred so far
+        int chunksDone = 0;
+        int chunkCount = 0;
+        double fraction = 0.0;          // of the whole job, 0..1
+        double realTimeFactor = 0.0;    // inference seconds per audio second; 0 if unknown
+        double etaSeconds = -1.0;       // -1 if unknown
+
+        QString describe() const;
+    };
+
+    // Turns the progress of a Pipeline into throttled ProgressReports with an ETA.
+    //
+    // The ETA comes from the real-time factor of the chunks inferred so far. Before enough audio has
+    // been inferred, it leans on the RTF measured in earlier runs of the same model, kept in the
+    // user settings under the history key, so the first estimate is already sensible. Reports are
+    // emitted on stage changes and at most once per minimum interval otherwise, so a job with many
+    // short chunks doesn't flood a queued connection.
+    //
+    // The pipeline calls the tracker from its own thread; report() may be called from any thread.
+    class ProgressTracker : public QObject {
+        Q_OBJECT
+    public:
+        explicit ProgressTracker(QObject *parent = nullptr);
+
+        // Usually the model file name and the execution provider. Empty: no history.
+        void setHistoryKey(const QString &key);
+        void setMinimumInterval(int msecs);
+
+        // Called by Pipeline.
+        void beginStage(const QString &stage);
+        void setAudioSeconds(double seconds);
+        // The chunks to infer and their total length; the inference progress and the ETA are
+        // measured against that length, not the whole file.
+        void setChunks(int count, double seconds);
+        void chunkDone(double audioSeconds, double computeSeconds);
+        // Emits the final report and stores the measured RTF in the history.
+        void finish();
+
+        ProgressReport report() const;
+
+        // RTF of earlier runs under `key`, or 0 if there are none.
+        static double historicalRealTimeFactor(const QString &key);
+
+    Q_SIGNALS:
+        void progressChanged(const some::ProgressReport &report);
+
+    private:
+        // Audio seconds of the measured RTF that the historical one counts as.
+        static constexpr double kHistoryWeightSeconds = 20.0;
+        // Share of the historical RTF kept when a new run is stored.
+        static constexpr double kHistoryDecay = 0.7;
+
+        ProgressReport makeReport() const;
+        void emitReport(bool force);
+
+        mutable std::mutex m_mutex;
+        QString m_historyKey;
+        double m_historyRtf = 0.0;
+        int m_minimumIntervalMs = 100;
+        std::chrono::steady_clock::time_point m_lastEmit;
+        bool m_emitted = false;
+
+        QString m_stage;
+        double m_audioSeconds = 0.0;
+        double m_inferenceSeconds = -1.0;  // -1 until the chunks are known
+        double m_processedSeconds = 0.0;
+        double m_computeSeconds = 0.0;
+        int m_chunksDone = 0;
+        int m_chunkCount = 0;
+    };  // class ProgressTracker
+
+}  // namespace some
+
+Q_DECLARE_METATYPE(some::ProgressReport)
+
+#endif //SOME_GUI_PROGRESSTRACKER_H
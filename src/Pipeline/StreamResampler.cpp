@@ -0,0 +1,194 @@
+#include <algorithm>
+
+#if defined(SOME_ENABLE_R8BRAIN)
+# include <r8bbase.h>
+# include <CDSPResampler.h>
+#elif defined(SOME_ENABLE_SAMPLERATE)
+# include <samplerate.h>
+#endif
+
+#include "StreamResampler.h"
+
+namespace some {
+
+    namespace {
+        constexpr int kMaxBlock = 4096;
+    }
+
+    struct StreamResampler::Impl {
+#if defined(SOME_ENABLE_R8BRAIN)
+        Impl(int inRate, int outRate) : resampler(inRate, outRate, kMaxBlock), buffer(kMaxBlock) {}
+
+        bool run(const float *in, int count, std::vector<float> &out) {
+            for (int i = 0; i < count; ++i) {
+                buffer[i] = in ? in[i] : 0.0;
+            }
+            double *outBuffer;
+            int writeCount = resampler.process(buffer.data(), count, outBuffer);
+            for (int i = 0; i < writeCount; ++i) {
+                out.push_back(static_cast<float>(outBuffer[i]));
+            }
+            return true;
+        }
+
+        r8b::CDSPResampler resampler;
+        std::vector<double> buffer;
+        QString error;
+#elif defined(SOME_ENABLE_SAMPLERATE)
+        Impl(int inRate, int outRate) : ratio(1.0 * outRate / inRate), zeros(kMaxBlock, 0.0f) {
+            int code = 0;
+            state = src_new(SRC_SINC_FASTEST, 1, &code);
+            if (!state) {
+                error = QString("Could not create the resampler: %1").arg(src_strerror(code));
+            }
+        }
+
+        ~Impl() {
+            if (state) {
+                src_delete(state);
+            }
+        }
+
+        bool run(const float *in, int count, std::vector<float> &out) {
+            std::vector<float> outBuffer(static_cast<std::size_t>(count * ratio) + 64);
+            SRC_DATA data {};
+            data.data_in = in ? in : zeros.data();
+            data.input_frames = count;
+            data.src_ratio = ratio;
+            while (data.input_frames > 0) {
+                data.data_out = outBuffer.data();
+                data.output_frames = static_cast<long>(outBuffer.size());
+                if (int code = src_process(state, &data)) {
+                    error = QString("Resampling failed: %1").arg(src_strerror(code));
+                    return false;
+                }
+                out.insert(out.end(), outBuffer.begin(), outBuffer.begin() + data.output_frames_gen);
+                data.data_in += data.input_frames_used * 1;
+                data.input_frames -= data.input_frames_used;
+                if (data.input_frames_used == 0 && data.output_frames_gen == 0) {
+                    break;
+                }
+            }
+            return true;
+        }
+
+        SRC_STATE *state = nullptr;
+        double ratio;
+        std::vector<float> zeros;
+        QString error;
+#else
+        Impl(int, int) {}
+
+        bool run(const float *, int, std::vector<float> &) {
+            return false;
+        }
+
+        QString error;
+#endif
+    };
+
+    StreamResampler::StreamResampler(int inRate, int outRate) : m_inRate(inRate), m_outRate(outRate) {
+        if (m_inRate <= 0 || m_outRate <= 0) {
+            m_error = QString("Invalid sample rate: %1 Hz to %2 Hz").arg(inRate).arg(outRate);
+            return;
+        }
+        if (m_inRate == m_outRate) {
+            return;
+        }
+#if defined(SOME_ENABLE_R8BRAIN) || defined(SOME_ENABLE_SAMPLERATE)
+        m_impl = std::make_unique<Impl>(inRate, outRate);
+        if (!m_impl->error.isEmpty()) {
+            m_error = m_impl->error;
+            m_impl.reset();
+        }
+#else
+        m_error = QString("Please convert the sample rate to %1 Hz first! Actual sample rate: %2 Hz")
+                .arg(outRate).arg(inRate);
+#endif
+    }
+
+    StreamResampler::~StreamResampler() = default;
+
+    bool StreamResampler::isValid() const {
+        return m_error.isEmpty();
+    }
+
+    QString StreamResampler::errorString() const {
+        return m_error;
+    }
+
+    bool StreamResampler::process(const float *in, std::size_t count, std::vector<float> &out) {
+        if (!m_error.isEmpty()) {
+            return false;
+        }
+        m_inFrames += count;
+        if (!m_impl) {
+            out.insert(out.end(), in, in + count);
+            m_outFrames += count;
+            return true;
+        }
+        auto before = out.size();
+        out.insert(out.end(), m_carry.begin(), m_carry.end());
+        m_carry.clear();
+        while (count > 0) {
+            auto block = static_cast<int>(std::min<std::size_t>(count, kMaxBlock));
+            if (!m_impl->run(in, block, out)) {
+                m_error = m_impl->error;
+                out.resize(before);
+                return false;
+            }
+            in += block;
+            count -= block;
+        }
+        // Never run ahead of the input; the excess is appended once the input catches up.
+        auto limit = expectedOutputFrames();
+        if (m_outFrames + (out.size() - before) > limit) {
+            auto end = before + static_cast<std::size_t>(limit - m_outFrames);
+            m_carry.assign(out.begin() + static_cast<std::ptrdiff_t>(end), out.end());
+            out.resize(end);
+        }
+        m_outFrames += out.size() - before;
+        return true;
+    }
+
+    bool StreamResampler::flush(std::vector<float> &out) {
+        if (!m_error.isEmpty()) {
+            return false;
+        }
+        if (!m_impl) {
+            return true;
+        }
+        auto limit = expectedOutputFrames();
+        auto before = out.size();
+        out.insert(out.end(), m_carry.begin(), m_carry.end());
+        m_carry.clear();
+        // Push zeros through until the converter's latency has been drained.
+        int rounds = 0;
+        while (m_outFrames + (out.size() - before) < limit && rounds++ < 64) {
+            if (!m_impl->run(nullptr, kMaxBlock, out)) {
+                m_error = m_impl->error;
+                out.resize(before);
+                return false;
+            }
+        }
+        // What is left lies past the end of the input.
+        if (m_outFrames + (out.size() - before) > limit) {
+            out.resize(before + static_cast<std::size_t>(limit - m_outFrames));
+        }
+        m_outFrames += out.size() - before;
+        return true;
+    }
+
+    std::uint64_t StreamResampler::inputFrames() const {
+        return m_inFrames;
+    }
+
+    std::uint64_t StreamResampler::outputFrames() const {
+        return m_outFrames;
+    }
+
+    std::uint64_t StreamResampler::expectedOutputFrames() const {
+        return m_inFrames * static_cast<std::uint64_t>(m_outRate) / static_cast<std::uint64_t>(m_inRate);
+    }
+
+}  // namespace some
@@ -0,0 +1,56 @@
+#ifndef SOME_GUI_STREAMRESAMPLER_H
+#define SOME_GUI_STREAMRESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QString>
+
+namespace some {
+
+    // Sample rate converter for mono audio that arrives in blocks.
+    // Uses r8brain or libsamplerate, whichever the build enables. Output position n corresponds to
+    // input time n / outRate; the converter's latency is absorbed, and flush() produces the remaining
+    // tail.
+    class StreamResampler {
+    public:
+        StreamResampler(int inRate, int outRate);
+        ~StreamResampler();
+
+        StreamResampler(const StreamResampler &) = delete;
+        StreamResampler &operator=(const StreamResampler &) = delete;
+
+        // False if the rates differ and the build has no resampler, if the converter could not be
+        // created, or after a conversion error. errorString() says which.
+        bool isValid() const;
+        QString errorString() const;
+
+        // Appends the converted samples to `out`. Output that would run ahead of the input is held
+        // back and appended by the next call. Returns false on a conversion error.
+        bool process(const float *in, std::size_t count, std::vector<float> &out);
+        // Appends the remaining output for the input seen so far. Returns false on a conversion error.
+        bool flush(std::vector<float> &out);
+
+        std::uint64_t inputFrames() const;
+        std::uint64_t outputFrames() const;
+
+    private:
+        std::uint64_t expectedOutputFrames() const;
+
+        int m_inRate;
+        int m_outRate;
+        std::uint64_t m_inFrames = 0;
+        std::uint64_t m_outFrames = 0;
+        // Output beyond expectedOutputFrames(), held back until more input arrives.
+        std::vector<float> m_carry;
+        QString m_error;
+
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };  // class StreamResampler
+
+}  // namespace some
+
+#endif //SOME_GUI_STREAMRESAMPLER_H
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Dsp/Kernels.h"
+#include "StreamingSlicer.h"
+
+namespace some {
+
+    StreamingSlicer::StreamingSlicer(int sampleRate, const PreprocessOptions &options, double maxChunkSeconds)
+            : m_sampleRate(sampleRate), m_options(options) {
+        m_hopFrames = std::max<std::size_t>(1, options.slicerHopSize * sampleRate / 1000);
+        m_maxSilKeptFrames = options.slicerMaxSilKept * sampleRate / 1000;
+        m_maxChunkFrames = std::max(static_cast<std::size_t>(std::max(0.0, maxChunkSeconds) * sampleRate),
+                                    options.slicerMinLength * sampleRate / 1000);
+        // Re-slicing every ~100 ms of new audio keeps the cost negligible without adding latency.
+        m_resliceFrames = std::max<std::size_t>(m_hopFrames, sampleRate / 10);
+        m_thresholdAmplitude = static_cast<float>(std::pow(10, options.slicerThreshold / 20.0));
+
+        Slicer slicer(sampleRate, options.slicerThreshold, options.slicerMinLength, options.slicerMinInterval,
+                      options.slicerHopSize, options.slicerMaxSilKept);
+        if (slicer.getErrorCode() != SlicerErrorCode::SLICER_OK) {
+            m_error = QString::fromStdString(slicer.getErrorMsg());
+        }
+        else if (!(maxChunkSeconds > 0.0)) {
+            m_error = QString("The maximum chunk length must be positive: %1 s").arg(maxChunkSeconds);
+        }
+    }
+
+    bool StreamingSlicer::isValid() const {
+        return m_error.isEmpty();
+    }
+
+    QString StreamingSlicer::errorString() const {
+        return m_error;
+    }
+
+    std::vector<StreamChunk> StreamingSlicer::push(const float *samples, std::size_t count) {
+        if (!m_error.isEmpty()) {
+            return {};
+        }
+        m_pending.insert(m_pending.end(), samples, samples + count);
+        m_sinceSlice += count;
+        if (m_sinceSlice < m_resliceFrames) {
+            return {};
+        }
+        m_sinceSlice = 0;
+        return settle(false);
+    }
+
+    std::vector<StreamChunk> StreamingSlicer::finish() {
+        if (!m_error.isEmpty()) {
+            return {};
+        }
+        m_sinceSlice = 0;
+        return settle(true);
+    }
+
+    std::uint64_t StreamingSlicer::pendingBegin() const {
+        return m_pendingBegin;
+    }
+
+    std::size_t StreamingSlicer::pendingFrames() const {
+        return m_pending.size();
+    }
+
+    std::vector<StreamChunk> StreamingSlicer::settle(bool final) {
+        std::vector<StreamChunk> chunks;
+        auto consume = [this](std::size_t frames) {
+            m_pending.erase(m_pending.begin(), m_pending.begin() + static_cast<std::ptrdiff_t>(frames));
+            m_pendingBegin += frames;
+        };
+        auto emit = [this, &chunks](std::size_t begin, std::size_t end, bool forced) {
+            // The slicer returns a short chunk for a window that is all silence; don't infer those.
+            if (end <= begin || isSilent(begin, end)) {
+                return;
+            }
+            StreamChunk chunk;
+            chunk.begin = m_pendingBegin + begin;
+            chunk.end = m_pendingBegin + end;
+            chunk.samples.assign(m_pending.begin() + static_cast<std::ptrdiff_t>(begin),
+                                 m_pending.begin() + static_cast<std::ptrdiff_t>(end));
+            chunk.forced = forced;
+            chunks.push_back(std::move(chunk));
+        };
+
+        if (m_pending.empty()) {
+            return chunks;
+        }
+        if (isSilent(0, m_pending.size())) {
+            // Keep the tail of a long silence so the next chunk is sliced with its lead-in.
+            auto keep = final ? 0 : std::min(m_pending.size(), m_maxSilKeptFrames);
+            consume(m_pending.size() - keep);
+            return chunks;
+        }
+
+        Slicer slicer(m_sampleRate, m_options.slicerThreshold, m_options.slicerMinLength,
+                      m_options.slicerMinInterval, m_options.slicerHopSize, m_options.slicerMaxSilKept);
+        auto markers = slicer.slice(m_pending, 1);
+        if (markers.empty()) {
+            if (final) {
+                emit(0, m_pending.size(), false);
+                consume(m_pending.size());
+            }
+            return chunks;
+        }
+
+        auto settled = final ? markers.size() : markers.size() - 1;
+        if (!final && m_pending.size() - markers.back().second > m_maxSilKeptFrames + m_hopFrames) {
+            settled = markers.size();
+        }
+        for (std::size_t i = 0; i < settled; ++i) {
+            emit(markers[i].first, markers[i].second, false);
+        }
+
+        std::size_t consumed;
+        if (settled < markers.size()) {
+            consumed = markers[settled].first;
+        }
+        else {
+            consumed = final ? m_pending.size() : markers.back().second;
+        }
+        if (!final && settled < markers.size() && m_pending.size() - consumed > m_maxChunkFrames) {
+            auto cut = quietestHop(consumed + m_maxChunkFrames / 2, m_pending.size());
+            emit(consumed, cut, true);
+            consumed = cut;
+        }
+        consume(consumed);
+        return chunks;
+    }
+
+    bool StreamingSlicer::isSilent(std::size_t begin, std::size_t end) const {
+        for (auto i = begin; i < end; ++i) {
+            if (std::abs(m_pending[i]) >= m_thresholdAmplitude) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t StreamingSlicer::quietestHop(std::size_t begin, std::size_t end) const {
+        auto best = end;
+        auto bestEnergy = std::numeric_limits<double>::max();
+        for (auto pos = begin; pos + m_hopFrames <= end; pos += m_hopFrames) {
+            double energy = dsp::sumOfSquares(m_pending.data() + pos, m_hopFrames);
+            if (energy < bestEnergy) {
+                bestEnergy = energy;
+                best = pos + m_hopFrames / 2;
+            }
+        }
+        return best;
+    }
+
+}  // namespace some
@@ -0,0 +1,74 @@
+#ifndef SOME_GUI_STREAMINGSLICER_H
+#define SOME_GUI_STREAMINGSLICER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <QString>
+
+#include "Pipeline.h"
+
+namespace some {
+
+    // A chunk whose boundaries will not move any more. Positions are absolute frames since the
+    // start of the stream.
+    struct StreamChunk {
+        std::uint64_t begin = 0;
+        std::uint64_t end = 0;
+        std::vector<float> samples;
+        bool forced = false;  // cut at maxChunkSeconds, not at a silence
+    };
+
+    // Incremental front end of the slicer for audio that arrives in blocks.
+    //
+    // The mono waveform after the last settled chunk is kept as a pending window, and the regular
+    // Slicer is run on it again as more audio arrives. Every chunk except the last one is closed by
+    // a silence that has already ended, so it is settled. The last chunk is settled once its
+    // trailing silence is longer than maxSilKept, because the cut position can't change after that.
+    // A window that grows past maxChunkSeconds without a silence is cut at its quietest hop near the
+    // end, which bounds the latency on continuous input.
+    //
+    // Chunk boundaries can differ slightly from slicing the whole recording at once: the slicer
+    // only looks at the pending window, not at audio before it.
+    class StreamingSlicer {
+    public:
+        StreamingSlicer(int sampleRate, const PreprocessOptions &options, double maxChunkSeconds = 15.0);
+
+        // False if the Slicer rejects the options or maxChunkSeconds isn't positive. An invalid
+        // slicer never settles a chunk, so its pending window would grow without bound; push()
+        // and finish() return nothing.
+        bool isValid() const;
+        QString errorString() const;
+
+        // Appends mono samples and returns the chunks settled by them.
+        std::vector<StreamChunk> push(const float *samples, std::size_t count);
+        // End of stream: returns whatever is left as chunks.
+        std::vector<StreamChunk> finish();
+
+        // Absolute frame position of the first pending sample.
+        std::uint64_t pendingBegin() const;
+        std::size_t pendingFrames() const;
+
+    private:
+        std::vector<StreamChunk> settle(bool final);
+        bool isSilent(std::size_t begin, std::size_t end) const;
+        std::size_t quietestHop(std::size_t begin, std::size_t end) const;
+
+        int m_sampleRate;
+        PreprocessOptions m_options;
+        std::size_t m_hopFrames;
+        std::size_t m_maxSilKeptFrames;
+        std::size_t m_maxChunkFrames;
+        std::size_t m_resliceFrames;
+        float m_thresholdAmplitude;
+        QString m_error;
+
+        std::vector<float> m_pending;
+        std::uint64_t m_pendingBegin = 0;
+        std::size_t m_sinceSlice = 0;
+    };  // class StreamingSlicer
+
+}  // namespace some
+
+#endif //SOME_GUI_STREAMINGSLICER_H
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "ThreadPlanner.h"
+
+namespace some {
+
+    namespace {
+        struct Core {
+            std::vector<int> cpus;  // SMT siblings, lowest id first
+            int node = 0;
+        };
+
+        // Contiguous blocks of cores, sizes differing by at most one. With more slots than
+        // cores, the slots take one core each in turn and share them.
+        std::vector<std::pair<std::vector<Core>, bool>> splitCores(const std::vector<Core> &cores, int slots) {
+            std::vector<std::pair<std::vector<Core>, bool>> result(static_cast<std::size_t>(slots));
+            auto count = static_cast<int>(cores.size());
+            if (count == 0) {
+                return result;
+            }
+            if (slots > count) {
+                for (int i = 0; i < slots; ++i) {
+                    result[i] = {{cores[i % count]}, true};
+                }
+                return result;
+            }
+            int begin = 0;
+            for (int i = 0; i < slots; ++i) {
+                int size = count / slots + (i < count % slots ? 1 : 0);
+                result[i].first.assign(cores.begin() + begin, cores.begin() + begin + size);
+                begin += size;
+            }
+            return result;
+        }
+    }
+
+    ThreadPlanner::ThreadPlanner() : m_topology(readCpuTopology()) {}
+
+    ThreadPlanner::ThreadPlanner(CpuTopology topology) : m_topology(std::move(topology)) {}
+
+    const CpuTopology &ThreadPlanner::topology() const {
+        return m_topology;
+    }
+
+    ThreadPlan ThreadPlanner::plan(const ThreadPlanOptions &options) const {
+        ThreadPlan plan;
+        plan.options = options;
+        plan.options.sessions = std::max(1, options.sessions);
+        plan.options.pipelineThreads = std::max(0, options.pipelineThreads);
+        plan.topology = m_topology;
+        const int sessions = plan.options.sessions;
+        const int pipelineThreads = plan.options.pipelineThreads;
+
+        std::vector<std::vector<Core>> nodeCores;
+        int totalCores = 0;
+        for (int node : m_topology.nodes()) {
+            nodeCores.emplace_back();
+            for (auto &siblings : m_topology.coresOfNode(node)) {
+                nodeCores.back().push_back({std::move(siblings), node});
+            }
+            totalCores += static_cast<int>(nodeCores.back().size());
+        }
+
+        // Pipeline stages mostly wait on I/O and memory, so the spare hyper-threads of the
+        // inference cores suit them. Take them from the last node, away from session 0.
+        if (!options.useSmt) {
+            for (auto node = nodeCores.rbegin(); node != nodeCores.rend(); ++node) {
+                for (auto core = node->rbegin(); core != node->rend(); ++core) {
+                    for (std::size_t i = 1; i < core->cpus.size(); ++i) {
+                        if (static_cast<int>(plan.pipelineCpus.size()) < pipelineThreads) {
+                            plan.pipelineCpus.push_back(core->cpus[i]);
+                        }
+                    }
+                }
+            }
+        }
+        // Without SMT, whole cores are set aside only if every session keeps two or more.
+        int missing = pipelineThreads - static_cast<int>(plan.pipelineCpus.size());
+        if (missing > 0 && totalCores - missing >= sessions * 2) {
+            for (auto node = nodeCores.rbegin(); node != nodeCores.rend() && missing > 0; ++node) {
+                while (!node->empty() && missing > 0) {
+                    plan.pipelineCpus.push_back(node->back().cpus.front());
+                    node->pop_back();
+                    --totalCores;
+                    --missing;
+                }
+            }
+        }
+        nodeCores.erase(std::remove_if(nodeCores.begin(), nodeCores.end(), [](const std::vector<Core> &cores) {
+            return cores.empty();
+        }), nodeCores.end());
+        plan.pipelineDedicated = pipelineThreads > 0 && missing <= 0;
+        if (!plan.pipelineDedicated) {
+            plan.pipelineCpus.clear();
+            for (const auto &cpu : m_topology.cpus) {
+                plan.pipelineCpus.push_back(cpu.id);
+            }
+        }
+        std::sort(plan.pipelineCpus.begin(), plan.pipelineCpus.end());
+
+        // Sessions per node: one for every node first, then each next session goes to the
+        // node with the most cores per session. Fewer sessions than nodes span the nodes.
+        std::vector<std::pair<std::vector<Core>, bool>> slotCores;
+        auto nodes = static_cast<int>(nodeCores.size());
+        if (nodes > 1 && sessions >= nodes) {
+            std::vector<int> sessionsOfNode(nodes, 1);
+            for (int i = nodes; i < sessions; ++i) {
+                int best = 0;
+                for (int n = 1; n < nodes; ++n) {
+                    if (nodeCores[n].size() * sessionsOfNode[best] > nodeCores[best].size() * sessionsOfNode[n]) {
+                        best = n;
+                    }
+                }
+                ++sessionsOfNode[best];
+            }
+            for (int n = 0; n < nodes; ++n) {
+                for (auto &slot : splitCores(nodeCores[n], sessionsOfNode[n])) {
+                    slotCores.push_back(std::move(slot));
+                }
+            }
+        }
+        else {
+            std::vector<Core> allCores;
+            for (const auto &cores : nodeCores) {
+                allCores.insert(allCores.end(), cores.begin(), cores.end());
+            }
+            slotCores = splitCores(allCores, sessions);
+        }
+
+        for (const auto &[cores, shared] : slotCores) {
+            SessionSlot slot;
+            slot.shared = shared;
+            for (const auto &core : cores) {
+                if (options.useSmt) {
+                    slot.cpus.insert(slot.cpus.end(), core.cpus.begin(), core.cpus.end());
+                }
+                else {
+                    slot.cpus.push_back(core.cpus.front());
+                }
+            }
+            slot.node = cores.empty() ? 0 : cores.front().node;
+            slot.intraOpThreads = std::max(1, static_cast<int>(slot.cpus.size()));
+            plan.sessions.push_back(std::move(slot));
+        }
+
+        if (options.globalThreadPools) {
+            for (const auto &slot : plan.sessions) {
+                plan.globalCpus.insert(plan.globalCpus.end(), slot.cpus.begin(), slot.cpus.end());
+            }
+            std::sort(plan.globalCpus.begin(), plan.globalCpus.end());
+            plan.globalCpus.erase(std::unique(plan.globalCpus.begin(), plan.globalCpus.end()), plan.globalCpus.end());
+            plan.globalIntraOpThreads = std::max(1, static_cast<int>(plan.globalCpus.size()));
+        }
+        return plan;
+    }
+
+    std::string ThreadPlan::describe() const {
+        std::ostringstream text;
+        text << "CPU topology (" << (topology.detected ? "sysfs" : "guessed") << "): "
+             << topology.nodeCount() << " NUMA node(s), " << topology.physicalCoreCount() << " cores, "
+             << topology.logicalCpuCount() << " logical CPUs\n";
+        for (int node : topology.nodes()) {
+            std::vector<int> cpus;
+            auto cores = topology.coresOfNode(node);
+            for (const auto &siblings : cores) {
+                cpus.insert(cpus.end(), siblings.begin(), siblings.end());
+            }
+            text << "  node " << node << ": " << cores.size() << " cores, CPUs " << formatCpuList(cpus) << '\n';
+        }
+        text << "Plan: " << options.sessions << " session(s), " << options.pipelineThreads << " pipeline thread(s)"
+             << ", SMT " << (options.useSmt ? "on" : "off")
+             << ", " << (options.globalThreadPools ? "global" : "per-session") << " thread pools"
+             << ", " << (options.pinThreads ? "pinned" : "not pinned") << '\n';
+        for (std::size_t i = 0; i < sessions.size(); ++i) {
+            const auto &slot = sessions[i];
+            text << "  session " << i << ": node " << slot.node << ", " << slot.intraOpThreads
+                 << " intra-op thread(s), CPUs " << formatCpuList(slot.cpus)
+                 << (slot.shared ? " (shared with other sessions)" : "") << '\n';
+        }
+        text << "  pipeline: CPUs " << formatCpuList(pipelineCpus)
+             << (pipelineDedicated ? "" : " (shared with the sessions)") << '\n';
+        if (options.globalThreadPools) {
+            text << "  global intra-op pool: " << globalIntraOpThreads << " thread(s), CPUs "
+                 << formatCpuList(globalCpus) << '\n';
+        }
+        auto result = text.str();
+        result.pop_back();
+        return result;
+    }
+
+}  // namespace some
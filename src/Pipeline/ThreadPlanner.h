@@ -0,0 +1,70 @@
+#ifndef SOME_GUI_THREADPLANNER_H
+#define SOME_GUI_THREADPLANNER_H
+
+#include <string>
+#include <vector>
+
+#include "Utils/CpuTopology.h"
+
+namespace some {
+
+    struct ThreadPlanOptions {
+        // ONNX Runtime sessions running at the same time.
+        int sessions = 1;
+        // Threads of the non-inference stages (decode, resample, slice, midi) that run next to
+        // the sessions, e.g. the stdin reader of a stream or the preprocessing of the next file.
+        int pipelineThreads = 1;
+        // Give sessions both hyper-threads of a core. Inference kernels saturate a core's vector
+        // units, so by default a session gets one thread per physical core.
+        bool useSmt = false;
+        // One process-wide intra-op pool shared by all sessions instead of a pool per session.
+        bool globalThreadPools = false;
+        // Pin session threads to their CPUs. Without it, the CPU lists are only the plan.
+        bool pinThreads = false;
+    };
+
+    // The CPUs of one session slot. The thread that calls Run() is the first intra-op thread.
+    struct SessionSlot {
+        int intraOpThreads = 1;
+        std::vector<int> cpus;  // one per intra-op thread, in thread order
+        int node = 0;
+        // Other slots use the same cores, because there are more sessions than cores.
+        bool shared = false;
+    };
+
+    struct ThreadPlan {
+        ThreadPlanOptions options;
+        CpuTopology topology;
+        std::vector<SessionSlot> sessions;
+        std::vector<int> pipelineCpus;
+        // The pipeline threads have CPUs of their own: SMT siblings or spare cores.
+        bool pipelineDedicated = false;
+        // With global pools: size of the shared pool and its CPUs.
+        int globalIntraOpThreads = 0;
+        std::vector<int> globalCpus;
+
+        // Topology and assignment as a text table, for logs and `some-cli plan`.
+        std::string describe() const;
+    };
+
+    // Divides the CPUs of a machine between ONNX Runtime session pools and the pipeline stages
+    // next to them, so that concurrent sessions don't each start a pool sized to every core.
+    //
+    // Cores are handed out per NUMA node, so a session's threads and the memory they touch stay
+    // on one node whenever there are at least as many sessions as nodes.
+    class ThreadPlanner {
+    public:
+        ThreadPlanner();
+        explicit ThreadPlanner(CpuTopology topology);
+
+        ThreadPlan plan(const ThreadPlanOptions &options) const;
+
+        const CpuTopology &topology() const;
+
+    private:
+        CpuTopology m_topology;
+    };  // class ThreadPlanner
+
+}  // namespace some
+
+#endif //SOME_GUI_THREADPLANNER_H
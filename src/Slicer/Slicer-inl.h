@@ -1,18 +1,34 @@
 #ifndef SOME_GUI_SLICER_INL_H
 #define SOME_GUI_SLICER_INL_H
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <cstddef>
+#include <thread>
 #include <type_traits>
 
+#include "Dsp/Kernels.h"
+#include "Slicer.h"
+
 
 // DECLARATION //
 
 template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
 T divIntRound(T n, T d);
 
+// Calls fn(part, begin, end) for up to `threads` contiguous parts of [0, count) at the same time,
+// the first one on the calling thread. Returns the number of parts.
+template<typename F>
+std::size_t for_each_segment(std::size_t count, int threads, F fn);
+
 template<typename T, typename = std::enable_if_t<std::is_convertible_v<T, double>>>
-std::vector<double> get_rms(const std::vector<T> &arr, std::size_t frame_length, std::size_t hop_length);
+std::vector<double> get_rms(const std::vector<T> &arr, std::size_t frame_length, std::size_t hop_length,
+                            int threads = 1);
+
+// Maximal runs [begin, end) of elements below `threshold`, in order.
+template<typename T>
+MarkerList silent_runs(const std::vector<T> &v, T threshold, int threads = 1);
 
 template<typename T>
 std::size_t argmin_range_view(const std::vector<T>& v, std::size_t begin, std::size_t end);
@@ -34,80 +50,138 @@ T divIntRound(T n, T d) {
                                ((n + (d / 2)) / d);
 }
 
+template<typename F>
+std::size_t for_each_segment(std::size_t count, int threads, F fn) {
+    auto parts = std::min<std::size_t>(count, static_cast<std::size_t>(std::max(threads, 1)));
+    if (parts <= 1) {
+        fn(std::size_t(0), std::size_t(0), count);
+        return 1;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(parts - 1);
+    for (std::size_t part = 1; part < parts; ++part) {
+        workers.emplace_back(fn, part, count * part / parts, count * (part + 1) / parts);
+    }
+    fn(std::size_t(0), std::size_t(0), count / parts);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    return parts;
+}
+
+template<typename T>
+double sum_of_squares(const T *arr, std::size_t count) {
+    if constexpr (std::is_same_v<T, float>) {
+        return some::dsp::sumOfSquares(arr, count);
+    }
+    double val = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        val += static_cast<double>(arr[i]) * arr[i];
+    }
+    return val;
+}
+
 template<typename T, typename>
-std::vector<double> get_rms(const std::vector<T> &arr, std::size_t frame_length, std::size_t hop_length) {
+std::vector<double> get_rms(const std::vector<T> &arr, std::size_t frame_length, std::size_t hop_length,
+                            int threads) {
+    /*
+     * Frame k covers [k * hop_length + padding - frame_length, k * hop_length + padding) of the signal,
+     * zero-padded on both sides. Its sum of squares only depends on the samples in the frame: when
+     * frame_length is a multiple of hop_length, it is added up from the sums of the hop-sized blocks
+     * the frame is made of, from left to right; otherwise it is summed directly. No frame depends on
+     * the one before it (unlike a running sum, which also drifts over long files), so splitting the
+     * frames between threads gives the same bits as computing them on one.
+     */
     std::size_t arr_length = arr.size();
-
     std::size_t padding = frame_length / 2;
-
     std::size_t rms_size = arr_length / hop_length + 1;
-
-    std::vector<double> rms = std::vector<double>(rms_size);
-
-    std::size_t left = 0;
-    std::size_t right = 0;
-    std::size_t hop_count = 0;
-
-    std::size_t rms_index = 0;
-    double val = 0;
-
-    // Initial condition: the frame is at the beginning of padded array
-    while ((right < padding) && (right < arr_length)) {
-        val += static_cast<double>(arr[right]) * arr[right];
-        right++;
-    }
-    rms[rms_index++] = std::sqrt(
-            std::max(0.0, static_cast<double>(val) / static_cast<double>(frame_length)));
-
-    // Left side or right side of the frame has not touched the sides of original array
-    while ((right < frame_length) && (right < arr_length) && (rms_index < rms_size)) {
-        val += static_cast<double>(arr[right]) * arr[right];
-        hop_count++;
-        if (hop_count == hop_length) {
-            rms[rms_index++] = std::sqrt(
-                    std::max(0.0, static_cast<double>(val) / static_cast<double>(frame_length)));
-            hop_count = 0;
-        }
-        right++;  // Move right 1 step at a time.
+    std::vector<double> rms(rms_size);
+
+    // Clipped bounds of frame k.
+    auto frame_begin = [&](std::size_t k) {
+        auto right = k * hop_length + padding;
+        return std::min(arr_length, right > frame_length ? right - frame_length : 0);
+    };
+    auto frame_end = [&](std::size_t k) {
+        return std::min(arr_length, k * hop_length + padding);
+    };
+    auto to_rms = [&](double val) {
+        return std::sqrt(std::max(0.0, val / static_cast<double>(frame_length)));
+    };
+
+    if (frame_length % hop_length != 0) {
+        for_each_segment(rms_size, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto k = begin; k < end; k++) {
+                auto first = frame_begin(k);
+                rms[k] = to_rms(sum_of_squares(arr.data() + first, frame_end(k) - first));
+            }
+        });
+        return rms;
     }
 
-    if (frame_length < arr_length) {
-        while ((right < arr_length) && (rms_index < rms_size)) {
-            val += static_cast<double>(arr[right]) * arr[right] - static_cast<double>(arr[left]) * arr[left];
-            hop_count++;
-            if (hop_count == hop_length) {
-                rms[rms_index++] = std::sqrt(
-                        std::max(0.0, static_cast<double>(val) / static_cast<double>(frame_length)));
-                hop_count = 0;
-            }
-            left++;
-            right++;
+    // Frame edges inside the signal all fall on `offset` modulo hop_length. Block 0 is
+    // [0, offset), block j > 0 is [offset + (j - 1) * hop_length, offset + j * hop_length).
+    std::size_t offset = padding % hop_length;
+    auto block_start = [&](std::size_t j) {
+        return j == 0 ? std::size_t(0) : std::min(arr_length, offset + (j - 1) * hop_length);
+    };
+    auto block_of = [&](std::size_t pos) {
+        return pos < offset ? std::size_t(0) : (pos - offset) / hop_length + 1;
+    };
+    std::size_t block_count = arr_length > 0 ? block_of(arr_length - 1) + 1 : 0;
+    std::vector<double> blocks(block_count);
+    for_each_segment(block_count, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto j = begin; j < end; j++) {
+            auto first = block_start(j);
+            blocks[j] = sum_of_squares(arr.data() + first, block_start(j + 1) - first);
         }
-    } else {
-        while ((right < frame_length) && (rms_index < rms_size)) {
-            hop_count++;
-            if (hop_count == hop_length) {
-                rms[rms_index++] = std::sqrt(
-                        std::max(0.0, static_cast<double>(val) / static_cast<double>(frame_length)));
-                hop_count = 0;
+    });
+    for_each_segment(rms_size, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto k = begin; k < end; k++) {
+            auto first = frame_begin(k);
+            auto last = frame_end(k);
+            double val = 0;
+            if (first < last) {
+                for (auto j = block_of(first), j_end = block_of(last - 1); j <= j_end; j++) {
+                    val += blocks[j];
+                }
             }
-            right++;
+            rms[k] = to_rms(val);
         }
-    }
+    });
+    return rms;
+}
 
-    while ((left < arr_length) && (rms_index < rms_size)/* && (right < arr_length + padding)*/) {
-        val -= static_cast<double>(arr[left]) * arr[left];
-        hop_count++;
-        if (hop_count == hop_length) {
-            rms[rms_index++] = std::sqrt(
-                    std::max(0.0, static_cast<double>(val) / static_cast<double>(frame_length)));
-            hop_count = 0;
+template<typename T>
+MarkerList silent_runs(const std::vector<T> &v, T threshold, int threads) {
+    // Each segment lists its own runs; a run crossing into the next segment is joined afterwards.
+    std::vector<MarkerList> segment_runs(static_cast<std::size_t>(std::max(threads, 1)));
+    for_each_segment(v.size(), threads, [&](std::size_t part, std::size_t begin, std::size_t end) {
+        auto &runs = segment_runs[part];
+        for (auto i = begin; i < end; i++) {
+            if (!(v[i] < threshold)) {
+                continue;
+            }
+            if (!runs.empty() && runs.back().second == i) {
+                runs.back().second = i + 1;
+            }
+            else {
+                runs.emplace_back(i, i + 1);
+            }
+        }
+    });
+    MarkerList runs;
+    for (const auto &part : segment_runs) {
+        for (const auto &run : part) {
+            if (!runs.empty() && runs.back().second == run.first) {
+                runs.back().second = run.second;
+            }
+            else {
+                runs.push_back(run);
+            }
         }
-        left++;
-        right++;
     }
-
-    return rms;
+    return runs;
 }
 
 template<typename T>
@@ -138,6 +212,11 @@ std::vector<T> multichannel_to_mono(const std::vector<T> &v, int channels) {
     auto frames = v.size() / channels;
     std::vector<T> out(frames);
 
+    if constexpr (std::is_same_v<T, float>) {
+        some::dsp::downmix(v.data(), out.data(), frames, channels);
+        return out;
+    }
+
     for (std::size_t i = 0; i < frames; i++) {
         T s = 0;
         for (int j = 0; j < channels; j++) {
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 
 #include "Slicer.h"
@@ -59,10 +60,16 @@ MarkerList Slicer::slice(const std::vector<float> &waveform, int channels)
         return {{ 0, frames }};
     }
 
+    // Long files are split between threads. The RMS of a frame and the silent runs don't depend on
+    // how the file is split, so the markers are the same for any thread count.
+    constexpr std::size_t kMinFramesPerThread = 1 << 22;
+    auto threads = static_cast<int>(std::clamp<std::size_t>(frames / kMinFramesPerThread, 1,
+                                                            static_cast<std::size_t>(std::max(m_threads, 1))));
     auto rms_list = get_rms(
             (channels > 1) ? multichannel_to_mono(waveform, channels) : waveform,
             m_winSize,
-            m_hopSize
+            m_hopSize,
+            threads
     );
 
     MarkerList sil_tags;
@@ -72,20 +79,14 @@ MarkerList Slicer::slice(const std::vector<float> &waveform, int channels)
 
     std::size_t pos = 0, pos_l = 0, pos_r = 0;
 
-    for (std::size_t i = 0; i < rms_list.size(); i++) {
-        double rms = rms_list[i];
-        // Keep looping while frame is silent.
-        if (rms < m_threshold) {
-            // Record start of silent frames.
-            if (!has_silence_start) {
-                silence_start = i;
-                has_silence_start = true;
-            }
-            continue;
-        }
-        // Keep looping while frame is not silent and silence start has not been recorded.
-        if (!has_silence_start) {
-            continue;
+    // Each run of silent frames [silence_start, i) that ends before the last frame is decided at
+    // its first non-silent frame i.
+    for (const auto &run : silent_runs(rms_list, m_threshold, threads)) {
+        silence_start = run.first;
+        std::size_t i = run.second;
+        if (i == rms_list.size()) {
+            has_silence_start = true;
+            break;
         }
         // Clear recorded silence start if interval is not enough or clip is too short
         bool is_leading_silence = ((silence_start == 0) && (i > m_maxSilKept));
@@ -93,7 +94,6 @@ MarkerList Slicer::slice(const std::vector<float> &waveform, int channels)
                 ( (i - silence_start) >= m_minInterval) &&
                 ( (i - clip_start) >= m_minLength) );
         if ((!is_leading_silence) && (!need_slice_middle)) {
-            has_silence_start = false;
             continue;
         }
 
@@ -133,7 +133,6 @@ MarkerList Slicer::slice(const std::vector<float> &waveform, int channels)
             }
             clip_start = pos_r;
         }
-        has_silence_start = false;
     }
     // Deal with trailing silence.
     auto total_frames = rms_list.size();
@@ -169,6 +168,10 @@ MarkerList Slicer::slice(const std::vector<float> &waveform, int channels)
     }
 }
 
+void Slicer::setThreads(int threads) {
+    m_threads = threads;
+}
+
 SlicerErrorCode Slicer::getErrorCode() const {
     return m_errCode;
 }
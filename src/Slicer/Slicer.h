@@ -21,12 +21,15 @@ private:
     std::size_t m_minLength;
     std::size_t m_minInterval;
     std::size_t m_maxSilKept;
+    int m_threads = 1;
     SlicerErrorCode m_errCode;
     std::string m_errMsg;
 
 public:
     explicit Slicer(int sr, double threshold = -40.0, std::size_t minLength = 5000, std::size_t minInterval = 300, std::size_t hopSize = 20, std::size_t maxSilKept = 5000);
     MarkerList slice(const std::vector<float> &waveform, int channels);
+    // Threads slice() may use for long inputs. The markers don't depend on it.
+    void setThreads(int threads);
     SlicerErrorCode getErrorCode() const;
     std::string getErrorMsg() const;
 };
@@ -0,0 +1,26 @@
+#ifndef SOME_GUI_CANCELTOKEN_H
+#define SOME_GUI_CANCELTOKEN_H
+
+#include <atomic>
+
+namespace some {
+
+    // Set by one thread to ask work running on another to stop at its next check. Work that sees it
+    // set returns early without reporting an error; the requester knows why.
+    class CancelToken {
+    public:
+        void cancel() {
+            m_cancelled.store(true, std::memory_order_relaxed);
+        }
+
+        bool isCancelled() const {
+            return m_cancelled.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<bool> m_cancelled {false};
+    };  // class CancelToken
+
+}  // namespace some
+
+#endif //SOME_GUI_CANCELTOKEN_H
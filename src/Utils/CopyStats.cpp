@@ -0,0 +1,18 @@
+#include "CopyStats.h"
+
+namespace some {
+
+    namespace {
+        thread_local CopyStats t_copyStats;
+    }
+
+    void recordCopy(std::size_t bytes) {
+        ++t_copyStats.copies;
+        t_copyStats.bytes += bytes;
+    }
+
+    CopyStats threadCopyStats() {
+        return t_copyStats;
+    }
+
+}  // namespace some
@@ -0,0 +1,21 @@
+#ifndef SOME_GUI_COPYSTATS_H
+#define SOME_GUI_COPYSTATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace some {
+
+    // Deep copies of sample and note buffers made by the current thread. Places that copy such a
+    // buffer call recordCopy(); a job reads the counters before and after a stage to see what it copied.
+    struct CopyStats {
+        std::uint64_t copies = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    void recordCopy(std::size_t bytes);
+    CopyStats threadCopyStats();
+
+}  // namespace some
+
+#endif //SOME_GUI_COPYSTATS_H
@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#if defined(_WIN32)
+# include <windows.h>
+#elif defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+#include "CpuTopology.h"
+
+namespace some {
+
+    namespace {
+        bool readFirstLine(const std::string &path, std::string &line) {
+            std::ifstream file(path);
+            return file && std::getline(file, line);
+        }
+
+        bool readInt(const std::string &path, int &value) {
+            std::string line;
+            if (!readFirstLine(path, line)) {
+                return false;
+            }
+            try {
+                value = std::stoi(line);
+            }
+            catch (...) {
+                return false;
+            }
+            return true;
+        }
+
+        CpuTopology guessTopology() {
+            CpuTopology topology;
+            int count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+            for (int i = 0; i < count; ++i) {
+                topology.cpus.push_back({i, i, 0, 0});
+            }
+            return topology;
+        }
+
+        std::set<int> allowedCpus() {
+            std::set<int> cpus;
+#if defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+                for (int i = 0; i < CPU_SETSIZE; ++i) {
+                    if (CPU_ISSET(i, &set)) {
+                        cpus.insert(i);
+                    }
+                }
+            }
+#endif
+            return cpus;
+        }
+    }
+
+    int CpuTopology::logicalCpuCount() const {
+        return static_cast<int>(cpus.size());
+    }
+
+    int CpuTopology::physicalCoreCount() const {
+        std::set<int> cores;
+        for (const auto &cpu : cpus) {
+            cores.insert(cpu.core);
+        }
+        return static_cast<int>(cores.size());
+    }
+
+    int CpuTopology::nodeCount() const {
+        return static_cast<int>(nodes().size());
+    }
+
+    std::vector<std::vector<int>> CpuTopology::coresOfNode(int node) const {
+        std::map<int, std::vector<int>> cores;
+        for (const auto &cpu : cpus) {
+            if (cpu.node == node) {
+                cores[cpu.core].push_back(cpu.id);
+            }
+        }
+        std::vector<std::vector<int>> result;
+        for (auto &[core, siblings] : cores) {
+            result.push_back(std::move(siblings));
+        }
+        return result;
+    }
+
+    std::vector<int> CpuTopology::nodes() const {
+        std::set<int> nodes;
+        for (const auto &cpu : cpus) {
+            nodes.insert(cpu.node);
+        }
+        return {nodes.begin(), nodes.end()};
+    }
+
+    CpuTopology readCpuTopology() {
+#if defined(__linux__)
+        auto topology = readCpuTopology("/sys/devices/system");
+        if (topology.detected) {
+            auto allowed = allowedCpus();
+            if (!allowed.empty()) {
+                topology.cpus.erase(std::remove_if(topology.cpus.begin(), topology.cpus.end(),
+                                                   [&](const LogicalCpu &cpu) {
+                                                       return allowed.count(cpu.id) == 0;
+                                                   }), topology.cpus.end());
+            }
+            if (!topology.cpus.empty()) {
+                return topology;
+            }
+        }
+#endif
+        return guessTopology();
+    }
+
+    CpuTopology readCpuTopology(const std::string &sysfsRoot) {
+        std::string line;
+        if (!readFirstLine(sysfsRoot + "/cpu/online", line)) {
+            return guessTopology();
+        }
+        CpuTopology topology;
+        std::map<std::pair<int, int>, int> coreIndex;  // (package, core_id) -> core
+        for (int id : parseCpuList(line)) {
+            auto dir = sysfsRoot + "/cpu/cpu" + std::to_string(id) + "/topology/";
+            LogicalCpu cpu;
+            cpu.id = id;
+            int coreId = id;
+            readInt(dir + "physical_package_id", cpu.package);
+            readInt(dir + "core_id", coreId);
+            cpu.package = std::max(cpu.package, 0);
+            auto key = std::make_pair(cpu.package, coreId);
+            auto it = coreIndex.find(key);
+            if (it == coreIndex.end()) {
+                it = coreIndex.emplace(key, static_cast<int>(coreIndex.size())).first;
+            }
+            cpu.core = it->second;
+            topology.cpus.push_back(cpu);
+        }
+
+        // Kernels without NUMA support have no node directory; everything is node 0 then.
+        for (int node = 0; readFirstLine(sysfsRoot + "/node/node" + std::to_string(node) + "/cpulist", line);
+             ++node) {
+            for (int id : parseCpuList(line)) {
+                for (auto &cpu : topology.cpus) {
+                    if (cpu.id == id) {
+                        cpu.node = node;
+                    }
+                }
+            }
+        }
+        topology.detected = !topology.cpus.empty();
+        return topology.detected ? topology : guessTopology();
+    }
+
+    std::vector<int> parseCpuList(const std::string &list) {
+        std::vector<int> cpus;
+        std::stringstream stream(list);
+        std::string range;
+        while (std::getline(stream, range, ',')) {
+            int first, last;
+            char dash;
+            std::stringstream rangeStream(range);
+            if (!(rangeStream >> first)) {
+                continue;
+            }
+            last = first;
+            if (rangeStream >> dash && dash == '-') {
+                rangeStream >> last;
+            }
+            for (int id = first; id <= last; ++id) {
+                cpus.push_back(id);
+            }
+        }
+        std::sort(cpus.begin(), cpus.end());
+        cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+        return cpus;
+    }
+
+    std::string formatCpuList(std::vector<int> cpus) {
+        std::sort(cpus.begin(), cpus.end());
+        cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+        std::string text;
+        for (std::size_t i = 0; i < cpus.size();) {
+            auto j = i;
+            while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+                ++j;
+            }
+            if (!text.empty()) {
+                text += ',';
+            }
+            text += std::to_string(cpus[i]);
+            if (j > i) {
+                text += '-' + std::to_string(cpus[j]);
+            }
+            i = j + 1;
+        }
+        return text;
+    }
+
+    bool setCurrentThreadAffinity(const std::vector<int> &cpus) {
+        if (cpus.empty()) {
+            return false;
+        }
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int id : cpus) {
+            if (id >= 0 && id < CPU_SETSIZE) {
+                CPU_SET(id, &set);
+            }
+        }
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+        // Only the first 64 processors, in the thread's current processor group.
+        DWORD_PTR mask = 0;
+        for (int id : cpus) {
+            if (id >= 0 && id < 64) {
+                mask |= DWORD_PTR(1) << id;
+            }
+        }
+        return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+        return false;
+#endif
+    }
+
+}  // namespace some
@@ -0,0 +1,47 @@
+#ifndef SOME_GUI_CPUTOPOLOGY_H
+#define SOME_GUI_CPUTOPOLOGY_H
+
+#include <string>
+#include <vector>
+
+namespace some {
+
+    struct LogicalCpu {
+        int id = 0;       // as the OS numbers it, the number used for affinity
+        int core = 0;     // index of the physical core, unique across packages
+        int package = 0;
+        int node = 0;     // NUMA node
+    };
+
+    // The CPUs this process may run on and how they share cores and memory.
+    struct CpuTopology {
+        // Sorted by id.
+        std::vector<LogicalCpu> cpus;
+        // False if the layout was guessed: one core and one node per logical CPU.
+        bool detected = false;
+
+        int logicalCpuCount() const;
+        int physicalCoreCount() const;
+        int nodeCount() const;
+        // Logical CPUs per core, grouped by node: cores[i] lists the SMT siblings of one core.
+        std::vector<std::vector<int>> coresOfNode(int node) const;
+        std::vector<int> nodes() const;
+    };
+
+    // Reads the topology from sysfs on Linux, limited to the CPUs that are online and in the
+    // affinity mask of the process. Elsewhere, or if sysfs is not readable, every logical CPU
+    // counts as a core of its own.
+    CpuTopology readCpuTopology();
+    // Same, with `sysfsRoot` standing in for /sys/devices/system.
+    CpuTopology readCpuTopology(const std::string &sysfsRoot);
+
+    // "0-3,8,10-11" <-> {0, 1, 2, 3, 8, 10, 11}, the format of sysfs and taskset.
+    std::vector<int> parseCpuList(const std::string &list);
+    std::string formatCpuList(std::vector<int> cpus);
+
+    // Restricts the calling thread to `cpus`. Returns false where affinity is not supported.
+    bool setCurrentThreadAffinity(const std::vector<int> &cpus);
+
+}  // namespace some
+
+#endif //SOME_GUI_CPUTOPOLOGY_H
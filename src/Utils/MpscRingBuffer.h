@@ -0,0 +1,108 @@
+#ifndef SOME_GUI_MPSCRINGBUFFER_H
+#define SOME_GUI_MPSCRINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace some {
+
+    // Bounded lock-free queue for many producers and a single consumer.
+    //
+    // Each cell carries a sequence number telling whose turn it is: producers claim a cell with one
+    // CAS on the enqueue position and publish it by bumping the sequence; the consumer reads cells in
+    // order. tryPush() fails instead of blocking when the queue is full. (D. Vyukov's bounded queue.)
+    template<typename T>
+    class MpscRingBuffer {
+    public:
+        // The capacity is rounded up to a power of two.
+        explicit MpscRingBuffer(std::size_t capacity);
+
+        MpscRingBuffer(const MpscRingBuffer &) = delete;
+        MpscRingBuffer &operator=(const MpscRingBuffer &) = delete;
+
+        // Safe to call from any thread.
+        bool tryPush(T value);
+
+        // Must only be called from the consumer thread.
+        bool tryPop(T &value);
+
+        std::size_t capacity() const;
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        static constexpr std::size_t kCacheLine = 64;
+
+        std::unique_ptr<Cell[]> m_cells;
+        std::size_t m_mask;
+        alignas(kCacheLine) std::atomic<std::size_t> m_enqueuePos;
+        alignas(kCacheLine) std::size_t m_dequeuePos;
+    };
+
+
+    /* IMPLEMENTATION BELOW */
+
+    template<typename T>
+    MpscRingBuffer<T>::MpscRingBuffer(std::size_t capacity) : m_enqueuePos(0), m_dequeuePos(0) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_cells = std::make_unique<Cell[]>(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_mask = size - 1;
+    }
+
+    template<typename T>
+    bool MpscRingBuffer<T>::tryPush(T value) {
+        auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            auto &cell = m_cells[pos & m_mask];
+            auto sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // pos was reloaded by the failed CAS
+            }
+            else if (diff < 0) {
+                return false;  // full
+            }
+            else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<typename T>
+    bool MpscRingBuffer<T>::tryPop(T &value) {
+        auto &cell = m_cells[m_dequeuePos & m_mask];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(m_dequeuePos + 1) < 0) {
+            return false;  // empty, or the producer has not finished writing this cell
+        }
+        value = std::move(cell.value);
+        cell.value = T();
+        cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+        ++m_dequeuePos;
+        return true;
+    }
+
+    template<typename T>
+    std::size_t MpscRingBuffer<T>::capacity() const {
+        return m_mask + 1;
+    }
+
+}  // namespace some
+
+#endif //SOME_GUI_MPSCRINGBUFFER_H
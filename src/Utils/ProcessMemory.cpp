@@ -0,0 +1,76 @@
+#include "ProcessMemory.h"
+
+#if defined(_WIN32)
+# include <windows.h>
+# include <psapi.h>
+#else
+# include <sys/resource.h>
+# if defined(__APPLE__)
+#  include <mach/mach.h>
+# elif defined(__linux__)
+#  include <cstdio>
+#  include <cstring>
+# endif
+#endif
+
+namespace some {
+
+    ProcessMemory getProcessMemory() {
+        ProcessMemory memory;
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS_EX counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS *>(&counters),
+                                 sizeof(counters))) {
+            memory.resident = counters.WorkingSetSize;
+            memory.privateResident = counters.PrivateUsage;
+        }
+#elif defined(__APPLE__)
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) ==
+            KERN_SUCCESS) {
+            memory.resident = info.resident_size;
+            memory.privateResident = info.resident_size;
+        }
+#elif defined(__linux__)
+        if (auto file = std::fopen("/proc/self/status", "r")) {
+            char line[256];
+            unsigned long long kilobytes;
+            while (std::fgets(line, sizeof(line), file)) {
+                if (std::sscanf(line, "VmRSS: %llu kB", &kilobytes) == 1) {
+                    memory.resident = static_cast<std::size_t>(kilobytes) * 1024;
+                }
+                else if (std::sscanf(line, "RssAnon: %llu kB", &kilobytes) == 1) {
+                    memory.privateResident = static_cast<std::size_t>(kilobytes) * 1024;
+                }
+            }
+            std::fclose(file);
+            if (memory.privateResident == 0) {
+                memory.privateResident = memory.resident;
+            }
+        }
+#endif
+        return memory;
+    }
+
+    std::size_t getPeakRss() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return counters.PeakWorkingSetSize;
+        }
+        return 0;
+#else
+        struct rusage usage {};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+# if defined(__APPLE__)
+        return static_cast<std::size_t>(usage.ru_maxrss);  // bytes
+# else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;  // kilobytes
+# endif
+#endif
+    }
+
+}  // namespace some
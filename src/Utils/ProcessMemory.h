@@ -0,0 +1,24 @@
+#ifndef SOME_GUI_PROCESSMEMORY_H
+#define SOME_GUI_PROCESSMEMORY_H
+
+#include <cstddef>
+
+namespace some {
+
+    struct ProcessMemory {
+        // Resident set size in bytes.
+        std::size_t resident = 0;
+        // Resident pages private to this process (anonymous memory). Memory-mapped files that other
+        // processes can share are the difference. Equals `resident` where the split is unknown.
+        std::size_t privateResident = 0;
+    };
+
+    // Current memory of this process; zeros if unknown.
+    ProcessMemory getProcessMemory();
+
+    // Peak resident set size of the current process in bytes, or 0 if unknown.
+    std::size_t getPeakRss();
+
+}  // namespace some
+
+#endif //SOME_GUI_PROCESSMEMORY_H
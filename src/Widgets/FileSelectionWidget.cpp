@@ -24,9 +24,10 @@ FileSelectionWidget::FileSelectionWidget(bool isSaveDialog, const QString &filte
                 QFileDialog::getSaveFileName(this, QString(), QString(), m_filter):
                 QFileDialog::getOpenFileName(this, QString(), QString(), m_filter);
         if (!filePath.isEmpty()) {
-            m_lineEdit->setText(filePath);
+            setFilePath(filePath);
         }
     });
+    connect(m_lineEdit, &QLineEdit::editingFinished, this, &FileSelectionWidget::reportFilePath);
 
     setAcceptDrops(true);
 
@@ -51,12 +52,26 @@ void FileSelectionWidget::dropEvent(QDropEvent *event) {
         if (!urls.isEmpty()) {
             const auto filePath = urls.first().toLocalFile();
             if (!filePath.isEmpty()) {
-                m_lineEdit->setText(filePath);
+                setFilePath(filePath);
             }
         }
     }
 }
 
+void FileSelectionWidget::setFilePath(const QString &filePath) {
+    m_lineEdit->setText(filePath);
+    reportFilePath();
+}
+
+void FileSelectionWidget::reportFilePath() {
+    // editingFinished also fires when the line edit merely loses focus.
+    auto filePath = m_lineEdit->text();
+    if (filePath != m_reportedPath) {
+        m_reportedPath = filePath;
+        Q_EMIT filePathChanged(filePath);
+    }
+}
+
 bool FileSelectionWidget::isSaveDialog() const {
     return m_isSaveDialog;
 }
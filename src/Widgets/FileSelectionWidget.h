@@ -26,16 +26,23 @@ public:
     QString filter() const;
     QLineEdit *getLineEdit() const;
     QPushButton *getButton() const;
+Q_SIGNALS:
+    // A new path was browsed, dropped, or typed and confirmed. Not emitted for every keystroke.
+    void filePathChanged(const QString &filePath);
 protected:
     void dragEnterEvent(QDragEnterEvent* event) override;
     void dropEvent(QDropEvent* event) override;
 private:
+    void setFilePath(const QString &filePath);
+    void reportFilePath();
+
     QHBoxLayout *m_layout;
     QLineEdit* m_lineEdit;
     QPushButton* m_browseButton;
 
     QString m_filter;
     bool m_isSaveDialog;
+    QString m_reportedPath;
 };
 
 
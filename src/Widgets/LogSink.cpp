@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <iterator>
+
+#include <QDateTime>
+#include <QScrollBar>
+#include <QTextCharFormat>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QTextEdit>
+#include <QTimer>
+
+#include "LogSink.h"
+
+LogSink::LogSink(QTextEdit *textEdit, QObject *parent)
+        : QObject(parent), m_textEdit(textEdit), m_timer(new QTimer(this)),
+          m_defaultColor(textEdit->textColor()), m_ring(kRingCapacity), m_sequence(0),
+          m_dropped(0) {
+    m_textEdit->document()->setMaximumBlockCount(kDefaultMaximumLines);
+
+    m_timer->setInterval(kDrainIntervalMs);
+    connect(m_timer, &QTimer::timeout, this, &LogSink::drain);
+    m_timer->start();
+}
+
+void LogSink::setMaximumLines(int lines) {
+    m_textEdit->document()->setMaximumBlockCount(lines);
+}
+
+int LogSink::maximumLines() const {
+    return m_textEdit->document()->maximumBlockCount();
+}
+
+void LogSink::post(const QString &msg, const QColor &color) {
+    push({0, 0, msg, color, Severity::Info});
+}
+
+void LogSink::postInfo(const QString &msg) {
+    push({0, 0, msg, m_defaultColor, Severity::Info});
+}
+
+void LogSink::postError(const QString &msg) {
+    push({0, 0, msg, Qt::red, Severity::Error});
+}
+
+void LogSink::push(Entry entry) {
+    if (entry.msg.isEmpty()) {
+        return;
+    }
+    entry.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+    entry.timestamp = QDateTime::currentMSecsSinceEpoch();
+    if (m_ring.tryPush(entry)) {
+        return;
+    }
+    if (entry.severity == Severity::Error) {
+        std::lock_guard<std::mutex> lock(m_overflowMutex);
+        m_overflow.push_back(std::move(entry));
+        return;
+    }
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LogSink::drain() {
+    Entry entry;
+    while (m_ring.tryPop(entry)) {
+        m_batch.push_back(std::move(entry));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_overflowMutex);
+        std::move(m_overflow.begin(), m_overflow.end(), std::back_inserter(m_batch));
+        m_overflow.clear();
+    }
+    auto dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (m_batch.empty() && dropped == 0) {
+        return;
+    }
+    // An overflowed error was posted before the ring entries that took its place.
+    std::sort(m_batch.begin(), m_batch.end(), [](const Entry &a, const Entry &b) {
+        return a.sequence < b.sequence;
+    });
+
+    auto scrollBar = m_textEdit->verticalScrollBar();
+    bool followTail = !scrollBar || scrollBar->value() == scrollBar->maximum();
+
+    QTextCharFormat timestampFormat;
+    timestampFormat.setForeground(Qt::gray);
+    QTextCharFormat defaultFormat;
+    defaultFormat.setForeground(m_defaultColor);
+    QTextCharFormat messageFormat;
+
+    QTextCursor cursor(m_textEdit->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    auto append = [&](const Entry &e) {
+        auto timestamp = QDateTime::fromMSecsSinceEpoch(e.timestamp).toString("yyyy-MM-dd hh:mm:ss.zzz");
+        cursor.insertText(QString('[') + timestamp + QString(']'), timestampFormat);
+        cursor.insertText(" ", defaultFormat);
+        messageFormat.setForeground(e.color);
+        cursor.insertText(e.msg, messageFormat);
+        cursor.insertText("\n", defaultFormat);
+    };
+    for (const auto &e : m_batch) {
+        append(e);
+    }
+    m_batch.clear();
+    if (dropped > 0) {
+        append({0, QDateTime::currentMSecsSinceEpoch(),
+                QString("(%1 log messages dropped)").arg(dropped), Qt::darkYellow});
+    }
+    cursor.endEditBlock();
+
+    if (followTail) {
+        m_textEdit->moveCursor(QTextCursor::End);
+        m_textEdit->ensureCursorVisible();
+    }
+}
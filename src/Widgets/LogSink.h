@@ -0,0 +1,75 @@
+#ifndef SOME_GUI_LOGSINK_H
+#define SOME_GUI_LOGSINK_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <QObject>
+#include <QString>
+#include <QColor>
+
+#include "Utils/MpscRingBuffer.h"
+
+class QTextEdit;
+class QTimer;
+
+// Collects log messages from any thread and appends them to a QTextEdit in batches.
+//
+// post() only pushes into a lock-free ring buffer, so worker threads never wait for the UI.
+// A timer on the UI thread drains the ring and applies everything in one edit block,
+// then scrolls once. Messages that arrive while the ring is full are counted and reported, except
+// errors: those go to a mutex-protected overflow list instead, so an error is never lost. Every
+// message is numbered when it is posted, so overflowed errors are shown in order.
+class LogSink : public QObject {
+    Q_OBJECT
+public:
+    explicit LogSink(QTextEdit *textEdit, QObject *parent = nullptr);
+
+    void setMaximumLines(int lines);
+    int maximumLines() const;
+
+public Q_SLOTS:
+    // Thread-safe. Connect with Qt::DirectConnection so the call runs on the sending thread.
+    void post(const QString &msg, const QColor &color);
+    void postInfo(const QString &msg);
+    void postError(const QString &msg);
+
+    // Applies all pending messages. Runs on the UI thread.
+    void drain();
+
+private:
+    enum class Severity {
+        Info,
+        Error,
+    };
+
+    struct Entry {
+        std::uint64_t sequence = 0;
+        qint64 timestamp = 0;  // msecs since epoch
+        QString msg;
+        QColor color;
+        Severity severity = Severity::Info;
+    };
+
+    void push(Entry entry);
+
+    static constexpr int kDrainIntervalMs = 50;
+    static constexpr std::size_t kRingCapacity = 4096;
+    static constexpr int kDefaultMaximumLines = 5000;
+
+    QTextEdit *m_textEdit;
+    QTimer *m_timer;
+    QColor m_defaultColor;
+    some::MpscRingBuffer<Entry> m_ring;
+    std::atomic<std::uint64_t> m_sequence;
+    std::atomic<qint64> m_dropped;
+    // Errors that did not fit into the ring, in arrival order.
+    std::mutex m_overflowMutex;
+    std::vector<Entry> m_overflow;
+    // Entries of one drain(); kept to reuse its capacity.
+    std::vector<Entry> m_batch;
+};
+
+#endif //SOME_GUI_LOGSINK_H
@@ -18,14 +18,38 @@
 #include <QComboBox>
 #include <QDir>
 #include <QAbstractItemView>
-
+#include <QFileInfo>
+#include <QPointer>
+#include <QTimer>
+
+#include "Inference/ModelScanner.h"
+#include "Inference/OrtRuntimeLoader.h"
+#include "Pipeline/PreprocessCache.h"
+#include "Pipeline/PreprocessJob.h"
+#include "Pipeline/ProgressTracker.h"
 #include "FileSelectionWidget.h"
+#include "LogSink.h"
 #include "MainWindow.h"
+#include "PianoRollWidget.h"
+#include "WaveformOverviewWidget.h"
 #include "Worker.h"
 
 
 inline void addSpacerToAlignWithRadioButton(QHBoxLayout *layout, QRadioButton *radioButton);
 
+// Paths of models chosen by path are compared as the model scanner reports them.
+static QString cleanModelPath(const QString &path);
+
+// Why a model in cmbModel can't be used; empty for usable models.
+constexpr int ModelErrorRole = Qt::UserRole + 1;
+
+// Resolution of the progress bar.
+constexpr int kProgressSteps = 1000;
+
+// A cancelled task should stop within a block of decoding or a few kernels of inference. One still
+// running after this long is reported.
+constexpr int kCancelWarningMs = 5000;
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
       centralWidget(new QWidget(this)),
@@ -51,31 +75,68 @@ MainWindow::MainWindow(QWidget *parent)
       cmbEP(new QComboBox(centralWidget)),
       txtDeviceIndex(new QLineEdit(centralWidget)),
       hBoxModelAndEngine(new QHBoxLayout(centralWidget)),
+      hBoxStart(new QHBoxLayout(centralWidget)),
       btnStart(new QPushButton("Start", centralWidget)),
+      btnCancel(new QPushButton("Cancel", centralWidget)),
       progressBar(new QProgressBar(centralWidget)),
+      waveformOverview(new WaveformOverviewWidget(centralWidget)),
+      pianoRoll(new PianoRollWidget(centralWidget)),
       loggingArea(new QTextEdit(centralWidget)),
-      isModelFromPath(false)
+      logSink(nullptr),
+      modelScanner(nullptr),
+      ortLoader(nullptr),
+      preprocessJob(nullptr),
+      currentWorker(nullptr),
+      isModelFromPath(false),
+      ortReady(false),
+      startPending(false)
 {
     initUI();
+    logSink = new LogSink(loggingArea, this);
 
     connect(btnStart, &QPushButton::clicked, this, &MainWindow::onStartButtonClicked);
+    connect(btnCancel, &QPushButton::clicked, this, &MainWindow::onCancelButtonClicked);
+    connect(fswAudio, &FileSelectionWidget::filePathChanged, this, &MainWindow::onAudioPathChanged);
+    connect(fswModel, &FileSelectionWidget::filePathChanged, this, &MainWindow::onModelPathChanged);
     connect(radioSelectFromList, &QAbstractButton::clicked, [this](bool checked) {
         setModelSelectMode(!checked);
     });
     connect(radioSelectFromPath, &QAbstractButton::clicked, [this](bool checked) {
         setModelSelectMode(checked);
     });
+    // The waveform and the piano roll zoom and pan together.
+    connect(waveformOverview, &WaveformOverviewWidget::viewChanged, pianoRoll, &PianoRollWidget::setView);
+    connect(pianoRoll, &PianoRollWidget::viewChanged, waveformOverview, &WaveformOverviewWidget::setView);
+    loadOrtRuntime();
     loadModelList();
-
-    connect(loggingArea->document(), &QTextDocument::contentsChanged, [this]() {
-        QTextCursor cursor(loggingArea->document());
-        cursor.movePosition(QTextCursor::End);
-        loggingArea->setTextCursor(cursor);
-        loggingArea->ensureCursorVisible();
-    });
 }
 
-MainWindow::~MainWindow() = default;
+MainWindow::~MainWindow() {
+    if (currentWorker) {
+        currentWorker->cancel();
+        currentWorker->wait();
+    }
+    if (modelScanner) {
+        modelScanner->requestInterruption();
+        modelScanner->wait();
+    }
+    for (auto inspector : modelInspectors) {
+        inspector->requestInterruption();
+        inspector->wait();
+    }
+    if (ortLoader) {
+        ortLoader->wait();
+    }
+    if (preprocessJob) {
+        preprocessJob->cancel();
+        preprocessJob->wait();
+    }
+    // The slicer can't be cancelled, so a retired job may still be running.
+    for (auto job : retiredPreprocessJobs) {
+        job->cancel();
+        job->wait();
+    }
+}
 
 
 void MainWindow::initUI() {
@@ -171,7 +232,12 @@ void MainWindow::initUI() {
     hBoxModelAndEngine->setStretch(1, 0);
     vLayout->addLayout(hBoxModelAndEngine);
 
-    vLayout->addWidget(btnStart);
+    btnCancel->setEnabled(false);
+    hBoxStart->addWidget(btnStart, 1);
+    hBoxStart->addWidget(btnCancel);
+    vLayout->addLayout(hBoxStart);
+    vLayout->addWidget(waveformOverview);
+    vLayout->addWidget(pianoRoll, 1);
     loggingArea->setReadOnly(true);
     loggingArea->ensureCursorVisible();
     vLayout->addWidget(loggingArea);
@@ -228,6 +294,41 @@ void MainWindow::onStartButtonClicked() {
         }
     }
 
+    {
+        QString modelError;
+        if (isModelFromPath) {
+            auto path = cleanModelPath(modelPath);
+            if (inspectedModelPath != path) {
+                // Parsing the model could take a while; starts from onModelInspected().
+                inspectModelPath(path);
+                startPending = true;
+                btnStart->setEnabled(false);
+                btnCancel->setEnabled(true);
+                progressBar->setRange(0, 0);
+                progressBar->setFormat("Checking the model");
+                return;
+            }
+            modelError = inspectedModelError;
+        }
+        else {
+            modelError = cmbModel->currentData(ModelErrorRole).toString();
+        }
+        if (!modelError.isEmpty()) {
+            QMessageBox::critical(this, "Error", QString("Invalid model!\n%1").arg(modelError));
+            return;
+        }
+    }
+
+    if (!ortReady) {
+        // Starts from onOrtLoaded() with the settings of that moment.
+        startPending = true;
+        btnStart->setEnabled(false);
+        btnCancel->setEnabled(true);
+        progressBar->setRange(0, 0);
+        progressBar->setFormat("Loading ONNX Runtime");
+        return;
+    }
+
     auto worker = new Worker(
                    modelPath,
                    fswAudio->filePath(),
@@ -237,16 +338,147 @@ void MainWindow::onStartButtonClicked() {
                    deviceIndex,
                    1,
                    this);
-    connect(worker, &Worker::logMsgInfo, this, &MainWindow::logMsgInfo);
-    connect(worker, &Worker::logMsgError, this, &MainWindow::logMsgError);
-    connect(worker, &Worker::logMsgWithColor, this, &MainWindow::logMsgWithColor);
+    // Log messages go straight into the sink's ring buffer on the worker thread.
+    connect(worker, &Worker::logMsgInfo, logSink, &LogSink::postInfo, Qt::DirectConnection);
+    connect(worker, &Worker::logMsgError, logSink, &LogSink::postError, Qt::DirectConnection);
+    connect(worker, &Worker::logMsgWithColor, logSink, &LogSink::post, Qt::DirectConnection);
+    // Results are emitted on the worker thread and queued to the previews.
+    connect(worker, &Worker::waveformReady, waveformOverview, &WaveformOverviewWidget::setMipmap);
+    connect(worker, &Worker::markersReady, waveformOverview, &WaveformOverviewWidget::setMarkers);
+    connect(worker, &Worker::markersReady, pianoRoll, &PianoRollWidget::setMarkers);
+    connect(worker, &Worker::inferenceStarted, pianoRoll, &PianoRollWidget::setDuration);
+    connect(worker, &Worker::chunkInferred, pianoRoll, &PianoRollWidget::addChunk);
+    connect(worker, &Worker::progressChanged, this, &MainWindow::onProgressChanged);
+    connect(worker, &Worker::cancelled, this, [this](double seconds) {
+        progressBar->setFormat(QString("Cancelled (%1 s)").arg(seconds, 0, 'f', 2));
+    });
     connect(worker, &QThread::finished, this, &MainWindow::onFinished);
     connect(worker, &QThread::finished, worker, &QThread::deleteLater);
+    if (preprocessJob && preprocessJob->audioPath() == fswAudio->filePath()) {
+        // The worker waits for the job and takes its result.
+        auto job = preprocessJob;
+        preprocessJob = nullptr;
+        worker->setPreprocessJob(job);
+        // Listed from now on so the destructor waits for it even if the worker never does.
+        retiredPreprocessJobs.append(job);
+        connect(worker, &QThread::finished, this, [this, job]() {
+            retirePreprocessJob(job);
+        });
+    }
+    waveformOverview->clear();
+    pianoRoll->clear();
     btnStart->setEnabled(false);
-    progressBar->setRange(0, 0);
+    btnCancel->setEnabled(true);
+    progressBar->setRange(0, kProgressSteps);
+    progressBar->setValue(0);
+    progressBar->setFormat("Starting");
+    currentWorker = worker;
     worker->start();
 }
 
+void MainWindow::onCancelButtonClicked() {
+    btnCancel->setEnabled(false);
+    if (startPending) {
+        startPending = false;
+        btnStart->setEnabled(true);
+        progressBar->setRange(0, kProgressSteps);
+        progressBar->setValue(0);
+        progressBar->setFormat("%p%");
+        return;
+    }
+    if (!currentWorker) {
+        return;
+    }
+    currentWorker->cancel();
+    progressBar->setFormat("%p%: Cancelling");
+    QPointer<Worker> worker(currentWorker);
+    QTimer::singleShot(kCancelWarningMs, this, [this, worker]() {
+        if (worker && !worker->isFinished()) {
+            logMsgError(QString("The task is still stopping %1 s after it was cancelled.")
+                                .arg(kCancelWarningMs / 1000));
+        }
+    });
+}
+
+void MainWindow::onAudioPathChanged(const QString &path) {
+    cancelPreprocessJob();
+    if (!QFileInfo(path).isFile()) {
+        return;
+    }
+    // Same options and cache as the Worker's pipeline, so the job can use the result as it is.
+    preprocessJob = new some::PreprocessJob(path, some::PreprocessOptions(), some::PreprocessCache::global(), this);
+    preprocessJob->start(QThread::LowPriority);
+}
+
+void MainWindow::onModelPathChanged(const QString &path) {
+    inspectedModelPath.clear();
+    inspectedModelError.clear();
+    inspectingModelPath.clear();
+    // Inspected ahead of Start, so the model has usually been checked by then.
+    if (QFileInfo(path).isFile()) {
+        inspectModelPath(cleanModelPath(path));
+    }
+}
+
+void MainWindow::inspectModelPath(const QString &path) {
+    if (path == inspectingModelPath) {
+        return;
+    }
+    inspectingModelPath = path;
+    auto inspector = new some::ModelScanner(QStringList {path}, this);
+    modelInspectors.append(inspector);
+    connect(inspector, &some::ModelScanner::modelScanned, this, &MainWindow::onModelInspected);
+    connect(inspector, &QThread::finished, this, [this, inspector]() {
+        modelInspectors.removeOne(inspector);
+        inspector->deleteLater();
+    });
+    inspector->start();
+}
+
+void MainWindow::onModelInspected(const some::ModelScanResult &result) {
+    // A model chosen before the current one.
+    if (result.path != inspectingModelPath) {
+        return;
+    }
+    inspectedModelPath = result.path;
+    inspectedModelError = result.error;
+    if (startPending) {
+        startPending = false;
+        btnStart->setEnabled(true);
+        progressBar->setRange(0, kProgressSteps);
+        progressBar->setValue(0);
+        progressBar->setFormat("%p%");
+        onStartButtonClicked();
+    }
+}
+
+void MainWindow::cancelPreprocessJob() {
+    if (preprocessJob) {
+        retirePreprocessJob(preprocessJob);
+        preprocessJob = nullptr;
+    }
+}
+
+void MainWindow::retirePreprocessJob(some::PreprocessJob *job) {
+    job->cancel();
+    if (!retiredPreprocessJobs.contains(job)) {
+        retiredPreprocessJobs.append(job);
+    }
+    auto release = [this, job]() {
+        retiredPreprocessJobs.removeOne(job);
+        job->deleteLater();
+    };
+    connect(job, &QThread::finished, this, release);
+    // It may have finished before the connection was made; release() may run twice.
+    if (job->isFinished()) {
+        release();
+    }
+}
+
+QString cleanModelPath(const QString &path) {
+    return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+}
+
 void MainWindow::browseOpenFile(QLineEdit *widget, const QString &filter) {
     auto filename = QFileDialog::getOpenFileName(this, QString(), QString(), filter);
     if (!filename.isEmpty()) {
@@ -266,7 +498,7 @@ void MainWindow::browseSaveFile(QLineEdit *widget, const QString &filter) {
 }
 
 void MainWindow::showEvent(QShowEvent *event) {
-    QSize windowSize(640, 480);
+    QSize windowSize(640, 720);
 #ifdef Q_OS_MAC
     auto dpiScale = 1.0;
     // It seems that on macOS, logicalDotsPerInch() always return 72.
@@ -299,33 +531,60 @@ void MainWindow::logMsgError(const QString &msg) {
 }
 
 void MainWindow::logMsgWithColor(const QString &msg, const QColor &color) {
-    if (!msg.isEmpty()) {
-        // Insert timestamp
-        loggingArea->moveCursor(QTextCursor::End);
-        loggingArea->setTextColor(Qt::gray);
-        auto timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-        loggingArea->insertPlainText(QString('[') + timestamp + QString(']'));
-
-        // Insert delimiter between timestamp and message (here it is space)
-        loggingArea->moveCursor(QTextCursor::End);
-        loggingArea->setTextColor(m_originalTextColor);
-        loggingArea->insertPlainText(" ");
-
-        // Insert message
-        loggingArea->moveCursor(QTextCursor::End);
-        loggingArea->setTextColor(color);
-        loggingArea->insertPlainText(msg);
-
-        // Insert newline
-        loggingArea->moveCursor(QTextCursor::End);
-        loggingArea->setTextColor(m_originalTextColor);
-        loggingArea->insertPlainText("\n");
-    }
+    logSink->post(msg, color);
 }
 
 void MainWindow::onFinished() {
+    bool cancelled = currentWorker && currentWorker->isCancelled();
+    currentWorker = nullptr;
     btnStart->setEnabled(true);
-    progressBar->setRange(0, 100);
+    btnCancel->setEnabled(false);
+    // A cancelled task keeps the "Cancelled" message.
+    if (!cancelled && progressBar->value() < kProgressSteps) {
+        progressBar->setFormat("%p%");
+    }
+}
+
+void MainWindow::onProgressChanged(const some::ProgressReport &report) {
+    progressBar->setValue(static_cast<int>(report.fraction * kProgressSteps));
+    progressBar->setFormat(QString("%p%: ") + report.describe());
+}
+
+void MainWindow::onOrtLoaded(bool ok) {
+    auto loader = ortLoader;
+    ortLoader = nullptr;
+    // loaded() is emitted at the very end of run(), so this returns at once.
+    loader->wait();
+    loader->deleteLater();
+    if (!ok) {
+        startPending = false;
+        btnStart->setEnabled(false);
+        progressBar->setRange(0, kProgressSteps);
+        progressBar->setValue(0);
+        progressBar->setFormat("ONNX Runtime not available");
+        QMessageBox::critical(this, "Error", "Could not load ONNX Runtime library:\n" + loader->errorString());
+        qApp->exit(-1);
+        return;
+    }
+    ortReady = true;
+    logMsgInfo(QString("ONNX Runtime loaded in %1 s. Execution providers: %2")
+                       .arg(loader->loadSeconds(), 0, 'f', 3)
+                       .arg(loader->providers().join(", ")));
+    // CPU accelerators are only offered when the loaded library has them.
+    for (auto ep : {some::ExecutionProvider::XNNPACK, some::ExecutionProvider::DNNL,
+                    some::ExecutionProvider::OpenVINO}) {
+        if (loader->providers().contains(some::ortExecutionProviderName(ep))) {
+            cmbEP->addItem(some::executionProviderDisplayName(ep), QVariant::fromValue(ep));
+        }
+    }
+    if (startPending) {
+        startPending = false;
+        btnStart->setEnabled(true);
+        progressBar->setRange(0, kProgressSteps);
+        progressBar->setValue(0);
+        progressBar->setFormat("%p%");
+        onStartButtonClicked();
+    }
 }
 
 void MainWindow::setModelSelectMode(bool modelFromPath) {
@@ -336,14 +595,36 @@ void MainWindow::setModelSelectMode(bool modelFromPath) {
     //fswModel->setVisible(isModelFromPath);
 }
 
+void MainWindow::loadOrtRuntime() {
+    ortLoader = new some::OrtRuntimeLoader(this);
+    connect(ortLoader, &some::OrtRuntimeLoader::loaded, this, &MainWindow::onOrtLoaded, Qt::QueuedConnection);
+    ortLoader->start();
+}
+
 void MainWindow::loadModelList() {
     auto appPath = qApp->applicationDirPath();
     auto modelsPath = appPath + '/' + "models";
-    auto modelsDir = QDir(modelsPath);
-    modelsDir.setNameFilters({"*.onnx"});
-    auto onnxFiles = modelsDir.entryList(QDir::Files);
-    for (const auto &onnxFile : onnxFiles) {
-        auto fullPath = QDir::cleanPath(modelsPath + '/' + onnxFile);
-        cmbModel->addItem(onnxFile, QVariant::fromValue(fullPath));
+    // Models are added to the list as the scanner reports them.
+    modelScanner = new some::ModelScanner(modelsPath, this);
+    connect(modelScanner, &some::ModelScanner::modelScanned, this, &MainWindow::addModelItem);
+    connect(modelScanner, &QThread::finished, this, [this]() {
+        modelScanner->deleteLater();
+        modelScanner = nullptr;
+    });
+    modelScanner->start(QThread::LowPriority);
+}
+
+void MainWindow::addModelItem(const some::ModelScanResult &result) {
+    auto index = cmbModel->count();
+    if (result.isValid()) {
+        cmbModel->addItem(result.fileName, QVariant::fromValue(result.path));
+        cmbModel->setItemData(index, some::onnx::describe(result.info), Qt::ToolTipRole);
+    }
+    else {
+        cmbModel->addItem(result.fileName + " (invalid)", QVariant::fromValue(result.path));
+        cmbModel->setItemData(index, result.error, ModelErrorRole);
+        cmbModel->setItemData(index, result.error, Qt::ToolTipRole);
+        cmbModel->setItemData(index, QColor(Qt::red), Qt::ForegroundRole);
+        logMsgError(QString("Model %1 can't be used: %2").arg(result.fileName, result.error));
     }
 }
@@ -4,6 +4,7 @@
 
 #include <QMainWindow>
 #include <QColor>
+#include <QList>
 
 class QWidget;
 class QLabel;
@@ -21,6 +22,18 @@ class QComboBox;
 
 class FileSelectionWidget;
 class FileDropLineEdit;
+class LogSink;
+class PianoRollWidget;
+class WaveformOverviewWidget;
+class Worker;
+
+namespace some {
+    class ModelScanner;
+    class OrtRuntimeLoader;
+    class PreprocessJob;
+    struct ModelScanResult;
+    struct ProgressReport;
+}
 
 class MainWindow : public QMainWindow
 
@@ -39,6 +52,7 @@ private:
     QFormLayout *formLayoutInput, *formLayoutEngine;
     QHBoxLayout *hBoxModel, *hBoxModelList;
     QHBoxLayout *hBoxModelAndEngine;
+    QHBoxLayout *hBoxStart;
     QLineEdit *txtTempo;
     FileSelectionWidget *fswAudio, *fswModel, *fswMIDI;
     QButtonGroup *radioSelectGroup;
@@ -47,18 +61,46 @@ private:
     QComboBox *cmbEP;
     QLineEdit *txtDeviceIndex;
     QPushButton *btnStart;
+    QPushButton *btnCancel;
     QProgressBar *progressBar;
+    WaveformOverviewWidget *waveformOverview;
+    PianoRollWidget *pianoRoll;
     QTextEdit *loggingArea;
+    LogSink *logSink;
+    some::ModelScanner *modelScanner;
+    // Inspections of models chosen by path, until their threads have finished.
+    QList<some::ModelScanner *> modelInspectors;
+    // The model chosen by path that was inspected last, and the one being inspected.
+    QString inspectedModelPath;
+    QString inspectedModelError;
+    QString inspectingModelPath;
+    some::OrtRuntimeLoader *ortLoader;
+    // Preprocesses the chosen input while the rest of the form is filled in.
+    some::PreprocessJob *preprocessJob;
+    // Jobs cancelled or handed to a worker, until their threads have finished; the destructor
+    // waits for them.
+    QList<some::PreprocessJob *> retiredPreprocessJobs;
+    // The running task, until its thread has finished.
+    Worker *currentWorker;
 
     void initUI();
 
 private:
     bool isModelFromPath;
+    // ONNX Runtime is loaded in the background; a Start before that waits for it.
+    bool ortReady;
+    bool startPending;
     QColor m_originalTextColor;
 
 public Q_SLOTS:
     void onStartButtonClicked();
+    void onCancelButtonClicked();
     void onFinished();
+    void onOrtLoaded(bool ok);
+    void onAudioPathChanged(const QString &path);
+    void onModelPathChanged(const QString &path);
+    void onModelInspected(const some::ModelScanResult &result);
+    void onProgressChanged(const some::ProgressReport &report);
     void logMsgInfo(const QString &msg);
     void logMsgError(const QString &msg);
     void logMsgWithColor(const QString &msg, const QColor &color);
@@ -68,6 +110,12 @@ private:
     void browseSaveFile(QLineEdit *widget, const QString &filter = QString());
     void setModelSelectMode(bool modelFromPath);
     void loadModelList();
+    void loadOrtRuntime();
+    void cancelPreprocessJob();
+    void inspectModelPath(const QString &path);
+    // Cancels a preprocess job nobody will use and deletes it once its thread has stopped.
+    void retirePreprocessJob(some::PreprocessJob *job);
+    void addModelItem(const some::ModelScanResult &result);
 
 protected:
     void showEvent(QShowEvent *event) override;
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cmath>
+
+#include "NoteIndex.h"
+
+namespace some {
+
+    void NoteIndex::clear() {
+        *this = NoteIndex();
+    }
+
+    std::size_t NoteIndex::binOf(double seconds) const {
+        return seconds <= 0.0 ? 0 : static_cast<std::size_t>(seconds / kBinSeconds);
+    }
+
+    void NoteIndex::growTo(std::size_t bins) {
+        if (bins <= m_bins.size()) {
+            return;
+        }
+        m_bins.resize(bins);
+        if (m_levels.empty()) {
+            m_levels.emplace_back();
+        }
+        m_levels[0].resize(bins);
+        for (std::size_t level = 1; level < m_levels.size(); ++level) {
+            m_levels[level].resize((m_levels[level - 1].size() + 1) / 2);
+        }
+        // New top levels until a single bin covers everything.
+        while (m_levels.back().size() > 1) {
+            const auto &below = m_levels.back();
+            std::vector<KeyMask> level((below.size() + 1) / 2);
+            for (std::size_t i = 0; i < below.size(); ++i) {
+                level[i / 2] |= below[i];
+            }
+            m_levels.push_back(std::move(level));
+        }
+    }
+
+    void NoteIndex::add(const RollNote &note) {
+        if (note.offset <= note.onset) {
+            return;
+        }
+        auto key = std::clamp(note.pitch, 0, kKeyCount - 1);
+        auto index = static_cast<std::uint32_t>(m_notes.size());
+        m_notes.push_back(note);
+        m_notes.back().pitch = key;
+        m_endTime = std::max(m_endTime, note.offset);
+        m_lowKey = std::min(m_lowKey, key);
+        m_highKey = std::max(m_highKey, key);
+
+        // The offset is exclusive.
+        auto first = binOf(note.onset);
+        auto last = std::max(first, binOf(std::nextafter(note.offset, note.onset)));
+        growTo(last + 1);
+        for (auto bin = first; bin <= last; ++bin) {
+            m_bins[bin].push_back(index);
+        }
+        for (std::size_t level = 0, lo = first, hi = last; level < m_levels.size(); ++level, lo /= 2, hi /= 2) {
+            for (auto bin = lo; bin <= hi; ++bin) {
+                m_levels[level][bin].set(key);
+            }
+        }
+    }
+
+    std::size_t NoteIndex::size() const {
+        return m_notes.size();
+    }
+
+    const RollNote &NoteIndex::note(std::size_t index) const {
+        return m_notes[index];
+    }
+
+    double NoteIndex::endTime() const {
+        return m_endTime;
+    }
+
+    int NoteIndex::lowKey() const {
+        return m_lowKey;
+    }
+
+    int NoteIndex::highKey() const {
+        return m_highKey;
+    }
+
+    void NoteIndex::query(double begin, double end, std::vector<std::uint32_t> &indexes) const {
+        indexes.clear();
+        if (m_bins.empty() || end <= begin) {
+            return;
+        }
+        auto first = binOf(begin);
+        auto last = std::min(binOf(end), m_bins.size() - 1);
+        for (auto bin = first; bin <= last; ++bin) {
+            for (auto index : m_bins[bin]) {
+                const auto &note = m_notes[index];
+                // A note spanning several bins is reported from the first bin of the range it is in.
+                if (std::max(first, binOf(note.onset)) == bin && note.onset < end && note.offset > begin) {
+                    indexes.push_back(index);
+                }
+            }
+        }
+    }
+
+    int NoteIndex::levelCount() const {
+        return static_cast<int>(m_levels.size());
+    }
+
+    double NoteIndex::binSeconds(int level) const {
+        return std::ldexp(kBinSeconds, level);
+    }
+
+    std::size_t NoteIndex::binCount(int level) const {
+        return m_levels[level].size();
+    }
+
+    const NoteIndex::KeyMask &NoteIndex::keys(int level, std::size_t bin) const {
+        return m_levels[level][bin];
+    }
+
+    int NoteIndex::levelFor(double seconds) const {
+        int level = 0;
+        while (level + 1 < levelCount() && binSeconds(level + 1) <= seconds) {
+            ++level;
+        }
+        return level;
+    }
+
+}  // namespace some
@@ -0,0 +1,66 @@
+#ifndef SOME_GUI_NOTEINDEX_H
+#define SOME_GUI_NOTEINDEX_H
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace some {
+
+    struct RollNote {
+        double onset = 0.0;   // seconds
+        double offset = 0.0;  // seconds
+        int pitch = 0;        // MIDI key
+    };
+
+    // The notes of a piano roll, indexed for drawing any part of hours of output.
+    //
+    // Notes are filed in fixed time bins, so a view finds its notes without looking at the rest.
+    // For zoomed-out views, every bin also has a mask of the keys sounding in it, and coarser levels
+    // OR two bins of the level below, like a mipmap. A view draws from the level whose bins are about
+    // a pixel wide, so its cost depends on its width in pixels, not on the number of notes.
+    // Adding a note only touches the bins it covers and their parents.
+    class NoteIndex {
+    public:
+        static constexpr double kBinSeconds = 0.25;
+        static constexpr int kKeyCount = 128;
+        using KeyMask = std::bitset<kKeyCount>;
+
+        void clear();
+        void add(const RollNote &note);
+
+        std::size_t size() const;
+        const RollNote &note(std::size_t index) const;
+        // Offset of the last note, 0 if empty.
+        double endTime() const;
+        // Lowest and highest key seen; lowKey() > highKey() if empty.
+        int lowKey() const;
+        int highKey() const;
+
+        // Indexes of the notes overlapping [begin, end), each once, in no particular order.
+        void query(double begin, double end, std::vector<std::uint32_t> &indexes) const;
+
+        // Level 0 has bins of kBinSeconds; each level above doubles the bin width.
+        int levelCount() const;
+        double binSeconds(int level) const;
+        std::size_t binCount(int level) const;
+        const KeyMask &keys(int level, std::size_t bin) const;
+        // The coarsest level whose bins are at most `seconds` wide.
+        int levelFor(double seconds) const;
+
+    private:
+        std::size_t binOf(double seconds) const;
+        void growTo(std::size_t bins);
+
+        std::vector<RollNote> m_notes;
+        std::vector<std::vector<std::uint32_t>> m_bins;
+        std::vector<std::vector<KeyMask>> m_levels;
+        double m_endTime = 0.0;
+        int m_lowKey = kKeyCount;
+        int m_highKey = -1;
+    };  // class NoteIndex
+
+}  // namespace some
+
+#endif //SOME_GUI_NOTEINDEX_H
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QWheelEvent>
+
+#include "PianoRollWidget.h"
+
+PianoRollWidget::PianoRollWidget(QWidget *parent) : QWidget(parent) {
+    setMinimumHeight(120);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setToolTip("Wheel: zoom, drag: pan, double-click: show all");
+    m_view.setMinimumSpan(kMinViewSeconds);
+}
+
+QSize PianoRollWidget::sizeHint() const {
+    return {600, 180};
+}
+
+const some::NoteIndex &PianoRollWidget::noteIndex() const {
+    return m_index;
+}
+
+void PianoRollWidget::clear() {
+    m_index.clear();
+    m_visible = {};
+    m_duration = 0.0;
+    m_markers = nullptr;
+    m_markerSampleRate = 0;
+    m_lowKey = 48;
+    m_highKey = 84;
+    m_view.showAll();
+    updateContent();
+    update();
+}
+
+void PianoRollWidget::setDuration(double seconds) {
+    m_duration = seconds;
+    updateContent();
+    update();
+}
+
+void PianoRollWidget::setMarkers(const some::MarkerListPtr &markers, int sampleRate) {
+    m_markers = markers;
+    m_markerSampleRate = sampleRate;
+}
+
+void PianoRollWidget::setView(double begin, double span) {
+    m_view.setRange(begin, span);
+    update();
+}
+
+bool PianoRollWidget::updateContent() {
+    auto begin = m_view.begin();
+    auto span = m_view.span();
+    m_view.setContentSeconds(std::max(m_duration, m_index.endTime()));
+    return begin != m_view.begin() || span != m_view.span();
+}
+
+void PianoRollWidget::emitViewChanged() {
+    update();
+    Q_EMIT viewChanged(m_view.begin(), m_view.span());
+}
+
+void PianoRollWidget::addChunk(int index, double onsetSeconds, const some::NotesPtr &notes) {
+    if (!notes) {
+        return;
+    }
+    // Same timing as the MIDI writer, in seconds instead of ticks: each note starts where the
+    // previous one ended, and nothing reaches past the onset of the next chunk.
+    double clip = std::numeric_limits<double>::infinity();
+    if (m_markers && m_markerSampleRate > 0 && index >= 0 &&
+        static_cast<std::size_t>(index) + 1 < m_markers->size()) {
+        clip = static_cast<double>((*m_markers)[index + 1].first) / m_markerSampleRate;
+    }
+    double onset = onsetSeconds;
+    for (std::size_t i = 0; i < notes->note_dur.size(); ++i) {
+        double offset = std::min(onset + notes->note_dur[i], clip);
+        if (onset < offset && !notes->note_rest[i]) {
+            m_index.add({onset, offset, static_cast<int>(std::lround(notes->note_midi[i]))});
+        }
+        onset = offset;
+    }
+
+    bool rescale = false;
+    if (m_index.size() > 0 && (m_index.lowKey() < m_lowKey || m_index.highKey() > m_highKey)) {
+        m_lowKey = std::max(0, std::min(m_lowKey, m_index.lowKey() - 2));
+        m_highKey = std::min(some::NoteIndex::kKeyCount - 1, std::max(m_highKey, m_index.highKey() + 2));
+        rescale = true;
+    }
+    if (updateContent()) {
+        rescale = true;
+    }
+    if (rescale) {
+        update();
+        return;
+    }
+    auto left = static_cast<int>(std::floor(xAt(onsetSeconds))) - 1;
+    auto right = static_cast<int>(std::ceil(xAt(onset))) + 1;
+    if (right >= 0 && left < width()) {
+        update(QRect(left, 0, right - left + 1, height()));
+    }
+}
+
+double PianoRollWidget::timeAt(double x) const {
+    return m_view.timeAt(x, width());
+}
+
+double PianoRollWidget::xAt(double seconds) const {
+    return m_view.xAt(seconds, width());
+}
+
+double PianoRollWidget::rowHeight() const {
+    return static_cast<double>(height()) / (m_highKey - m_lowKey + 1);
+}
+
+double PianoRollWidget::yAt(int key) const {
+    return (m_highKey - key) * rowHeight();
+}
+
+void PianoRollWidget::paintEvent(QPaintEvent *event) {
+    QPainter painter(this);
+    const auto exposed = event->rect();
+    painter.fillRect(exposed, palette().base());
+
+    // Black key rows and a line at every C.
+    const auto rows = rowHeight();
+    for (int key = m_lowKey; key <= m_highKey; ++key) {
+        auto pitchClass = key % 12;
+        bool black = pitchClass == 1 || pitchClass == 3 || pitchClass == 6 || pitchClass == 8 || pitchClass == 10;
+        QRectF row(exposed.left(), yAt(key), exposed.width(), rows);
+        if (black) {
+            painter.fillRect(row, palette().alternateBase());
+        }
+        if (pitchClass == 0) {
+            painter.setPen(palette().mid().color());
+            painter.drawLine(row.bottomLeft(), row.bottomRight());
+        }
+    }
+
+    double begin = std::max(0.0, timeAt(exposed.left()));
+    double end = timeAt(exposed.right() + 1);
+    double pixelsPerSecond = std::max(1, width()) / m_view.span();
+    if (some::NoteIndex::kBinSeconds * pixelsPerSecond >= kNoteModeBinPixels) {
+        drawNotes(painter, begin, end);
+    }
+    else {
+        drawKeyMasks(painter, begin, end);
+    }
+}
+
+void PianoRollWidget::drawNotes(QPainter &painter, double begin, double end) {
+    m_index.query(begin, end, m_visible);
+    const auto rows = rowHeight();
+    const auto color = palette().highlight().color();
+    for (auto index : m_visible) {
+        const auto &note = m_index.note(index);
+        auto x = xAt(note.onset);
+        auto w = std::max(1.0, xAt(note.offset) - x);
+        painter.fillRect(QRectF(x, yAt(note.pitch), w, std::max(1.0, rows - 1.0)), color);
+    }
+}
+
+void PianoRollWidget::drawKeyMasks(QPainter &painter, double begin, double end) {
+    if (m_index.levelCount() == 0) {
+        return;
+    }
+    // Bins of at most a pixel, so the number of bins drawn follows the width, not the content.
+    int level = m_index.levelFor(m_view.span() / std::max(1, width()));
+    auto binSeconds = m_index.binSeconds(level);
+    auto bins = m_index.binCount(level);
+    auto first = static_cast<std::size_t>(std::max(0.0, begin / binSeconds));
+    auto last = std::min(bins, static_cast<std::size_t>(std::ceil(end / binSeconds)) + 1);
+    if (first >= last) {
+        return;
+    }
+    const auto rows = rowHeight();
+    const auto color = palette().highlight().color();
+    int lowKey = std::max(m_lowKey, m_index.lowKey());
+    int highKey = std::min(m_highKey, m_index.highKey());
+    for (int key = lowKey; key <= highKey; ++key) {
+        // One rectangle per run of consecutive bins in which the key sounds.
+        std::size_t runStart = last;
+        for (auto bin = first; bin <= last; ++bin) {
+            bool sounding = bin < last && m_index.keys(level, bin).test(key);
+            if (sounding && runStart == last) {
+                runStart = bin;
+            }
+            else if (!sounding && runStart != last) {
+                auto x = xAt(runStart * binSeconds);
+                auto w = std::max(1.0, xAt(bin * binSeconds) - x);
+                painter.fillRect(QRectF(x, yAt(key), w, std::max(1.0, rows - 1.0)), color);
+                runStart = last;
+            }
+        }
+    }
+}
+
+void PianoRollWidget::wheelEvent(QWheelEvent *event) {
+    m_view.zoomAt(event->position().x(), width(), std::pow(1.25, -event->angleDelta().y() / 120.0));
+    emitViewChanged();
+    event->accept();
+}
+
+void PianoRollWidget::mousePressEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = true;
+        m_dragStart = event->pos();
+        m_dragViewBegin = m_view.begin();
+        setCursor(Qt::ClosedHandCursor);
+    }
+}
+
+void PianoRollWidget::mouseMoveEvent(QMouseEvent *event) {
+    if (!m_dragging) {
+        return;
+    }
+    auto shift = (event->pos().x() - m_dragStart.x()) * m_view.span() / std::max(1, width());
+    m_view.setRange(m_dragViewBegin - shift, m_view.span());
+    emitViewChanged();
+}
+
+void PianoRollWidget::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = false;
+        unsetCursor();
+    }
+}
+
+void PianoRollWidget::mouseDoubleClickEvent(QMouseEvent *event) {
+    Q_UNUSED(event)
+    m_view.showAll();
+    emitViewChanged();
+}
@@ -0,0 +1,87 @@
+#ifndef SOME_GUI_PIANOROLLWIDGET_H
+#define SOME_GUI_PIANOROLLWIDGET_H
+
+#include <cstdint>
+#include <vector>
+
+#include <QPoint>
+#include <QWidget>
+
+#include "Inference/NotesStruct.h"
+#include "Pipeline/JobResult.h"
+#include "NoteIndex.h"
+#include "TimeView.h"
+
+class QPainter;
+
+// Shows the notes of a running job as their chunks are inferred.
+//
+// Chunks arrive through queued signals carrying shared notes, so the worker never waits for the
+// widget. Once the duration of the job is known the time scale is fixed and a new chunk only
+// repaints its own columns. Zoomed in, notes are drawn one by one from the NoteIndex; zoomed out,
+// the index's key masks are drawn instead, one run of bins per key, so even hour-long results with
+// hundreds of thousands of notes cost about the same to draw.
+//
+// Wheel zooms around the cursor, dragging pans, double-click shows everything again. viewChanged()
+// and setView() keep it in step with other time-based views.
+class PianoRollWidget : public QWidget {
+    Q_OBJECT
+public:
+    explicit PianoRollWidget(QWidget *parent = nullptr);
+
+    QSize sizeHint() const override;
+    const some::NoteIndex &noteIndex() const;
+
+public Q_SLOTS:
+    void clear();
+    void setDuration(double seconds);
+    // The chunks of the job. A chunk's notes are clipped at the onset of the next one, like in the
+    // MIDI file.
+    void setMarkers(const some::MarkerListPtr &markers, int sampleRate);
+    void addChunk(int index, double onsetSeconds, const some::NotesPtr &notes);
+    // Shows [begin, begin + span) seconds, without emitting viewChanged().
+    void setView(double begin, double span);
+
+Q_SIGNALS:
+    // The user zoomed or panned.
+    void viewChanged(double begin, double span);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    // Zoomed-in drawing switches to single notes once a level-0 bin is this many pixels wide.
+    static constexpr double kNoteModeBinPixels = 2.0;
+    static constexpr double kMinViewSeconds = 1.0;
+
+    double timeAt(double x) const;
+    double xAt(double seconds) const;
+    double rowHeight() const;
+    double yAt(int key) const;
+    // Returns true if the time scale changed.
+    bool updateContent();
+    void emitViewChanged();
+    void drawNotes(QPainter &painter, double begin, double end);
+    void drawKeyMasks(QPainter &painter, double begin, double end);
+
+    some::NoteIndex m_index;
+    std::vector<std::uint32_t> m_visible;
+
+    double m_duration = 0.0;
+    some::MarkerListPtr m_markers;
+    int m_markerSampleRate = 0;
+    TimeView m_view;
+    int m_lowKey = 48;
+    int m_highKey = 84;
+
+    bool m_dragging = false;
+    QPoint m_dragStart;
+    double m_dragViewBegin = 0.0;
+};
+
+#endif //SOME_GUI_PIANOROLLWIDGET_H
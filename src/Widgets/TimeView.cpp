@@ -0,0 +1,65 @@
+#include <algorithm>
+
+#include "TimeView.h"
+
+double TimeView::begin() const {
+    return m_begin;
+}
+
+double TimeView::span() const {
+    return m_span;
+}
+
+bool TimeView::showsAll() const {
+    return m_showsAll;
+}
+
+void TimeView::setContentSeconds(double seconds) {
+    m_content = std::max(seconds, m_minimumSpan);
+    if (m_showsAll) {
+        m_begin = 0.0;
+        m_span = m_content;
+    }
+    clamp();
+}
+
+double TimeView::contentSeconds() const {
+    return m_content;
+}
+
+void TimeView::setMinimumSpan(double seconds) {
+    m_minimumSpan = seconds;
+    setContentSeconds(m_content);
+}
+
+void TimeView::showAll() {
+    m_showsAll = true;
+    m_begin = 0.0;
+    m_span = m_content;
+}
+
+void TimeView::setRange(double begin, double span) {
+    m_showsAll = false;
+    m_begin = begin;
+    m_span = span;
+    clamp();
+}
+
+void TimeView::zoomAt(double x, int width, double factor) {
+    auto anchor = timeAt(x, width);
+    auto span = std::clamp(m_span * factor, m_minimumSpan, m_content);
+    setRange(anchor - x * span / std::max(1, width), span);
+}
+
+double TimeView::timeAt(double x, int width) const {
+    return m_begin + x * m_span / std::max(1, width);
+}
+
+double TimeView::xAt(double seconds, int width) const {
+    return (seconds - m_begin) * std::max(1, width) / m_span;
+}
+
+void TimeView::clamp() {
+    m_span = std::clamp(m_span, m_minimumSpan, m_content);
+    m_begin = std::clamp(m_begin, 0.0, m_content - m_span);
+}
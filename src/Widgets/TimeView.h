@@ -0,0 +1,35 @@
+#ifndef SOME_GUI_TIMEVIEW_H
+#define SOME_GUI_TIMEVIEW_H
+
+// The visible time range of a view that zooms and pans horizontally over some content.
+// Until the user zooms or pans, the view follows the content and shows all of it.
+class TimeView {
+public:
+    double begin() const;
+    double span() const;
+    bool showsAll() const;
+
+    // Length of the content in seconds; the view never goes past it.
+    void setContentSeconds(double seconds);
+    double contentSeconds() const;
+    void setMinimumSpan(double seconds);
+
+    void showAll();
+    void setRange(double begin, double span);
+    // Zooms by `factor` (> 1 zooms out), keeping the time at `x` in place.
+    void zoomAt(double x, int width, double factor);
+
+    double timeAt(double x, int width) const;
+    double xAt(double seconds, int width) const;
+
+private:
+    void clamp();
+
+    double m_begin = 0.0;
+    double m_span = 1.0;
+    double m_content = 1.0;
+    double m_minimumSpan = 1.0;
+    bool m_showsAll = true;
+};
+
+#endif //SOME_GUI_TIMEVIEW_H
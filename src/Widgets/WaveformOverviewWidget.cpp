@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cmath>
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QWheelEvent>
+
+#include "WaveformOverviewWidget.h"
+
+WaveformOverviewWidget::WaveformOverviewWidget(QWidget *parent) : QWidget(parent) {
+    setMinimumHeight(80);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setToolTip("Wheel: zoom, drag: pan, double-click: show all");
+    m_view.setMinimumSpan(kMinViewSeconds);
+}
+
+QSize WaveformOverviewWidget::sizeHint() const {
+    return {600, 100};
+}
+
+void WaveformOverviewWidget::clear() {
+    m_mipmap = nullptr;
+    m_markers = nullptr;
+    m_markerSampleRate = 0;
+    m_view.showAll();
+    updateContent();
+    update();
+}
+
+void WaveformOverviewWidget::setMipmap(const some::dsp::WaveformMipmapPtr &mipmap) {
+    m_mipmap = mipmap;
+    updateContent();
+    update();
+}
+
+void WaveformOverviewWidget::setMarkers(const some::MarkerListPtr &markers, int sampleRate) {
+    m_markers = markers;
+    m_markerSampleRate = sampleRate;
+    updateContent();
+    update();
+}
+
+void WaveformOverviewWidget::setView(double begin, double span) {
+    m_view.setRange(begin, span);
+    update();
+}
+
+void WaveformOverviewWidget::updateContent() {
+    double seconds = m_mipmap ? m_mipmap->durationSeconds() : 0.0;
+    if (m_markers && !m_markers->empty() && m_markerSampleRate > 0) {
+        seconds = std::max(seconds, static_cast<double>(m_markers->back().second) / m_markerSampleRate);
+    }
+    m_view.setContentSeconds(seconds);
+}
+
+void WaveformOverviewWidget::emitViewChanged() {
+    update();
+    Q_EMIT viewChanged(m_view.begin(), m_view.span());
+}
+
+void WaveformOverviewWidget::paintEvent(QPaintEvent *event) {
+    QPainter painter(this);
+    const auto exposed = event->rect();
+    const int w = width();
+    const double middle = height() / 2.0;
+    painter.fillRect(exposed, palette().base());
+
+    // Kept chunks, shaded, with a line at each boundary.
+    if (m_markers && m_markerSampleRate > 0) {
+        auto begin = static_cast<std::size_t>(std::max(0.0, m_view.timeAt(exposed.left(), w)) * m_markerSampleRate);
+        auto end = static_cast<std::size_t>(std::ceil(m_view.timeAt(exposed.right() + 1, w) * m_markerSampleRate));
+        // Chunks are sorted and don't overlap, so the first one in view ends after `begin`.
+        auto it = std::lower_bound(m_markers->begin(), m_markers->end(), begin,
+                                   [](const std::pair<std::size_t, std::size_t> &chunk, std::size_t frame) {
+                                       return chunk.second < frame;
+                                   });
+        auto shade = palette().highlight().color();
+        shade.setAlpha(40);
+        painter.setPen(palette().highlight().color());
+        for (; it != m_markers->end() && it->first <= end; ++it) {
+            auto left = m_view.xAt(static_cast<double>(it->first) / m_markerSampleRate, w);
+            auto right = m_view.xAt(static_cast<double>(it->second) / m_markerSampleRate, w);
+            painter.fillRect(QRectF(left, 0, right - left, height()), shade);
+            painter.drawLine(QPointF(left, 0), QPointF(left, height()));
+            painter.drawLine(QPointF(right, 0), QPointF(right, height()));
+        }
+    }
+
+    painter.setPen(palette().mid().color());
+    painter.drawLine(QPointF(exposed.left(), middle), QPointF(exposed.right() + 1, middle));
+
+    if (!m_mipmap || m_mipmap->frames() == 0) {
+        return;
+    }
+    // One line per column, from the min to the max of the frames under it.
+    const double rate = m_mipmap->sampleRate();
+    const double scale = middle * 0.95;
+    painter.setPen(palette().text().color());
+    for (int x = exposed.left(); x <= exposed.right(); ++x) {
+        auto first = m_view.timeAt(x, w) * rate;
+        auto last = m_view.timeAt(x + 1, w) * rate;
+        if (last <= 0.0) {
+            continue;
+        }
+        auto range = m_mipmap->range(static_cast<std::size_t>(std::max(0.0, first)),
+                                     static_cast<std::size_t>(std::ceil(last)));
+        painter.drawLine(QPointF(x + 0.5, middle - range.max * scale), QPointF(x + 0.5, middle - range.min * scale));
+    }
+}
+
+void WaveformOverviewWidget::wheelEvent(QWheelEvent *event) {
+    m_view.zoomAt(event->position().x(), width(), std::pow(1.25, -event->angleDelta().y() / 120.0));
+    emitViewChanged();
+    event->accept();
+}
+
+void WaveformOverviewWidget::mousePressEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = true;
+        m_dragStart = event->pos();
+        m_dragViewBegin = m_view.begin();
+        setCursor(Qt::ClosedHandCursor);
+    }
+}
+
+void WaveformOverviewWidget::mouseMoveEvent(QMouseEvent *event) {
+    if (!m_dragging) {
+        return;
+    }
+    auto shift = (event->pos().x() - m_dragStart.x()) * m_view.span() / std::max(1, width());
+    m_view.setRange(m_dragViewBegin - shift, m_view.span());
+    emitViewChanged();
+}
+
+void WaveformOverviewWidget::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = false;
+        unsetCursor();
+    }
+}
+
+void WaveformOverviewWidget::mouseDoubleClickEvent(QMouseEvent *event) {
+    Q_UNUSED(event)
+    m_view.showAll();
+    emitViewChanged();
+}
@@ -0,0 +1,62 @@
+#ifndef SOME_GUI_WAVEFORMOVERVIEWWIDGET_H
+#define SOME_GUI_WAVEFORMOVERVIEWWIDGET_H
+
+#include <QPoint>
+#include <QWidget>
+
+#include "Dsp/WaveformMipmap.h"
+#include "Pipeline/JobResult.h"
+#include "TimeView.h"
+
+// The waveform of the input with the chunks of the slicer on top, to check the slicing.
+//
+// The waveform is drawn from a min/max mipmap that the pipeline builds while decoding, one
+// vertical line per pixel column. A column reads a few mipmap entries, so drawing costs the same
+// for a minute or for hours of audio at any zoom. Only the chunk boundaries in view are looked up.
+//
+// Wheel zooms around the cursor, dragging pans, double-click shows everything again. viewChanged()
+// and setView() keep it in step with other time-based views.
+class WaveformOverviewWidget : public QWidget {
+    Q_OBJECT
+public:
+    explicit WaveformOverviewWidget(QWidget *parent = nullptr);
+
+    QSize sizeHint() const override;
+
+public Q_SLOTS:
+    void clear();
+    void setMipmap(const some::dsp::WaveformMipmapPtr &mipmap);
+    // Chunk boundaries in frames at `sampleRate`, sorted as the slicer returns them.
+    void setMarkers(const some::MarkerListPtr &markers, int sampleRate);
+    // Shows [begin, begin + span) seconds, without emitting viewChanged().
+    void setView(double begin, double span);
+
+Q_SIGNALS:
+    // The user zoomed or panned.
+    void viewChanged(double begin, double span);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    static constexpr double kMinViewSeconds = 1.0;
+
+    void updateContent();
+    void emitViewChanged();
+
+    some::dsp::WaveformMipmapPtr m_mipmap;
+    some::MarkerListPtr m_markers;
+    int m_markerSampleRate = 0;
+    TimeView m_view;
+
+    bool m_dragging = false;
+    QPoint m_dragStart;
+    double m_dragViewBegin = 0.0;
+};
+
+#endif //SOME_GUI_WAVEFORMOVERVIEWWIDGET_H
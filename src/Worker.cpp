@@ -1,24 +1,14 @@
-#include <fstream>
 #include <chrono>
-#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
 
 #include <QColor>
-
-#include <sndfile.hh>
-#if defined(SOME_ENABLE_R8BRAIN)
-# include <r8bbase.h>
-# include <CDSPResampler.h>
-#elif defined(SOME_ENABLE_SAMPLERATE)
-# include <samplerate.h>
-#endif
-#include <MidiFile.h>
+#include <QFileInfo>
 
 #include "Worker.h"
-#include "Slicer/Slicer.h"
 #include "Inference/SOMEInference.h"
-
-#define DIVIDE_CEIL(x, y)  (((x) % (y)) ? (((x) / (y)) + 1) : ((x) / (y)))
-#define MIN_VALUE(a,b)            (((a) < (b)) ? (a) : (b))
+#include "Pipeline/Pipeline.h"
+#include "Pipeline/PreprocessCache.h"
 
 Worker::Worker(const QString &modelPath,
                const QString &audioPath,
@@ -32,14 +22,70 @@ Worker::Worker(const QString &modelPath,
                m_deviceIndex(deviceIndex), m_ep(ep), m_batchSize(batchSize)
                {}
 
+void Worker::setPreprocessJob(some::PreprocessJob *job) {
+    m_preprocessJob = job;
+}
+
+
+void Worker::cancel() {
+    std::lock_guard<std::mutex> lock(m_cancelMutex);
+    if (m_cancel.isCancelled()) {
+        return;
+    }
+    m_cancelTime = std::chrono::steady_clock::now();
+    m_cancel.cancel();
+    if (m_preprocessJob) {
+        m_preprocessJob->cancel();
+    }
+    if (m_backend) {
+        m_backend->cancel();
+    }
+}
+
+bool Worker::isCancelled() const {
+    return m_cancel.isCancelled();
+}
+
+void Worker::setBackend(some::InferenceBackend *backend) {
+    std::lock_guard<std::mutex> lock(m_cancelMutex);
+    m_backend = backend;
+    if (m_backend && m_cancel.isCancelled()) {
+        m_backend->cancel();
+    }
+}
 
 void Worker::run() {
+    runJob();
+    if (!m_cancel.isCancelled()) {
+        return;
+    }
+    // runJob() has returned, so its session, waveform and chunk buffers are freed by now.
+    std::chrono::steady_clock::time_point cancelTime;
+    {
+        std::lock_guard<std::mutex> lock(m_cancelMutex);
+        cancelTime = m_cancelTime;
+    }
+    std::chrono::duration<double> stopTime = std::chrono::steady_clock::now() - cancelTime;
+    logMsgWithColor(QString("Task cancelled; stopped %1 seconds after the request.")
+                            .arg(QString::number(stopTime.count(), 'f', 3)), Qt::darkYellow);
+    Q_EMIT cancelled(stopTime.count());
+}
+
+void Worker::runJob() {
     using namespace some;
     auto benchmarkStart = std::chrono::steady_clock::now();
 
     // Step: initialize Ort Session
     logMsgInfo("Initializing session...");
     SOMEInference someInference(m_modelPath);
+    // SOME_ORT_PROFILE=1 profiles the session and saves the time per operator next to the MIDI file.
+    auto profileEnv = std::getenv("SOME_ORT_PROFILE");
+    bool profiling = profileEnv && *profileEnv && std::strcmp(profileEnv, "0") != 0;
+    if (profiling) {
+        SessionConfig config;
+        config.profilePrefix = (m_outPath + ".ort-profile").toStdString();
+        someInference.setSessionConfig(config);
+    }
     connect(&someInference, &Inference::logMsgInfo, [this](const QString &msg) {
         Q_EMIT logMsgInfo(msg);
     });
@@ -53,215 +99,80 @@ void Worker::run() {
         return;
     }
     logMsgInfo("Session initialization succeed.");
-
-
-    // Step: load audio
-    logMsgInfo("Loading audio...");
-
-    SndfileHandle sf(m_audioPath
-#ifdef _WIN32
-            .toStdWString().c_str()
-#else
-            .toStdString()
-#endif
-            );
-    if (sf.error() != SF_ERR_NO_ERROR)
-    {
-        Q_EMIT logMsgError(QString("Sndfile error: %1").arg(sf.strError()));
-        return;
-    }
-    auto channels = sf.channels();
-    auto sampleRate = sf.samplerate();
-    constexpr int targetSampleRate = 44100;
-
-    auto frames = sf.frames();
-    if ((channels <= 0) || (sampleRate <= 0)) {
-        Q_EMIT logMsgError("Audio load failed.");
-        return;
-    }
-
-    if (frames == 0) {
-        Q_EMIT logMsgError("Audio is empty!");
+    if (m_cancel.isCancelled()) {
         return;
     }
 
-    constexpr long long maxAllowedLength = 20 * 60;
-    if (frames >= sampleRate * maxAllowedLength) {
-        Q_EMIT logMsgError("Error: the input audio is too long (>= 20 minutes).");
-        return;
-    }
-    auto samples = frames * channels;
-    std::vector<float> waveform;
-    try {
-        waveform.resize(samples);
-    }
-    catch (const std::bad_alloc &e) {
-        Q_EMIT logMsgError(QString("Failed to allocate memory for audio: ") + e.what());
-        return;
-    }
-
-    auto itemsRead = sf.read(waveform.data(), samples);
-    if (itemsRead <= 0) {
-        Q_EMIT logMsgError("Can't read audio file!");
-        return;
-    }
-    samples = MIN_VALUE(samples, itemsRead);
-    frames = MIN_VALUE(frames, samples / channels);
+    // Step: decode, resample, slice, infer and write MIDI
+    // The ETA starts from the RTF of earlier runs of this model on this execution provider.
+    // Keyed by the provider actually in use, so a fallback to CPU doesn't skew the provider's RTF.
+    const char *epName = executionProviderName(someInference.activeProvider());
+    ProgressTracker progress;
+    progress.setHistoryKey(QFileInfo(m_modelPath).fileName() + '/' + epName);
+    connect(&progress, &ProgressTracker::progressChanged, [this](const ProgressReport &report) {
+        Q_EMIT progressChanged(report);
+    });
 
-    // Step: convert audio
-    // Convert to mono in-place
-    if (channels > 1) {
-        for (size_t i = 0; i < frames; i++) {
-            float s = 0;
-            for (int j = 0; j < channels; j++) {
-                s += waveform[i * channels + j] / static_cast<float>(channels);
-            }
-            waveform[i] = s;
+    Pipeline pipeline;
+    pipeline.setCancelToken(&m_cancel);
+    pipeline.setPreprocessCache(PreprocessCache::global());
+    pipeline.setWaveformOverview(true);
+    pipeline.setProgressTracker(&progress);
+    connect(&pipeline, &Pipeline::logMsgInfo, [this](const QString &msg) {
+        Q_EMIT logMsgInfo(msg);
+    });
+    connect(&pipeline, &Pipeline::logMsgError, [this](const QString &msg) {
+        Q_EMIT logMsgError(msg);
+    });
+    connect(&pipeline, &Pipeline::waveformReady, [this](const dsp::WaveformMipmapPtr &mipmap) {
+        Q_EMIT waveformReady(mipmap);
+    });
+    connect(&pipeline, &Pipeline::markersReady, [this](const MarkerListPtr &markers, int sampleRate) {
+        Q_EMIT markersReady(markers, sampleRate);
+    });
+    connect(&pipeline, &Pipeline::inferenceStarted, [this](double audioSeconds, int chunkCount) {
+        Q_EMIT inferenceStarted(audioSeconds, chunkCount);
+    });
+    connect(&pipeline, &Pipeline::chunkInferred, [this](int index, double onsetSeconds, const NotesPtr &notes) {
+        Q_EMIT chunkInferred(index, onsetSeconds, notes);
+    });
+    if (m_preprocessJob) {
+        if (!m_preprocessJob->isFinished()) {
+            logMsgInfo("Waiting for background preprocessing...");
         }
-        waveform.resize(frames);
-        samples = frames;
+        m_preprocessJob->wait();
+        pipeline.setPreprocessed(m_preprocessJob->take(pipeline.preprocessOptions()));
     }
-
-    // Convert sample rate
-    if (sampleRate != targetSampleRate) {
-#if defined(SOME_ENABLE_R8BRAIN)
-        logMsgInfo(QString("Converting sample rate from %2 Hz to %1 Hz")
-                           .arg(targetSampleRate).arg(sampleRate));
-        constexpr int inBufferSize = 1024;
-        std::array<double, inBufferSize> inBuffer {};
-
-        r8b::CDSPResampler resampler(sampleRate, targetSampleRate, inBufferSize);
-
-        auto targetFrames = frames * targetSampleRate / sampleRate;
-        auto numBatches = frames / inBufferSize;
-        auto remain = frames % inBufferSize;  // within int range
-        if (remain > 0) {
-            ++numBatches;
-        }
-        double *outBuffer;
-        std::vector<float> outVec;
-        outVec.reserve(targetFrames);
-        decltype(numBatches) currentBatch = 0;
-
-        while (currentBatch < numBatches) {
-            int ReadCount = ((currentBatch == numBatches) && (remain > 0)) ? static_cast<int>(remain) : inBufferSize;
-            for (int i = 0; i < ReadCount; ++i) {
-                inBuffer[i] = waveform[currentBatch * inBufferSize + i];
-            }
-            int writeCount = resampler.process(
-                    inBuffer.data(),
-                    inBufferSize,
-                    outBuffer
-            );
-            for (int i = 0; i < writeCount; ++i) {
-                outVec.push_back(static_cast<float>(outBuffer[i]));
-            }
-            ++currentBatch;
-        }
-        frames = targetFrames;
-        samples = frames;
-        std::swap(waveform, outVec);
-#elif defined(SOME_ENABLE_SAMPLERATE);
-        logMsgInfo(QString("Converting sample rate from %2 Hz to %1 Hz")
-                            .arg(targetSampleRate).arg(sampleRate));
-        double conversionRatio = 1.0 * targetSampleRate / sampleRate;
-
-        SRC_DATA srcData;
-        srcData.src_ratio = conversionRatio;
-        srcData.data_in = waveform.data();
-        srcData.data_out = nullptr;
-        srcData.input_frames = frames;
-        srcData.output_frames = 0;
-
-        src_simple(&srcData, SRC_SINC_FASTEST, 1);
-        auto targetFrames = frames * targetSampleRate / sampleRate;
-
-        std::vector<float> outBuffer(targetFrames);
-        srcData.data_out = outBuffer.data();
-        srcData.output_frames = targetFrames;
-
-        src_simple(&srcData, SRC_SINC_FASTEST, 1);
-        frames = srcData.output_frames_gen;
-        outBuffer.resize(frames);
-        samples = frames;
-        std::swap(waveform, outBuffer);
-#else
-        logMsgError(QString("Please convert the sample rate to %1 Hz first! Actual sample rate: %2 Hz")
-                .arg(targetSampleRate).arg(sampleRate));
+    setBackend(&someInference);
+    auto ok = pipeline.run(someInference, m_audioPath, m_outPath, m_tempo);
+    setBackend(nullptr);
+    if (!ok) {
         return;
-#endif
     }
-
-    logMsgInfo("Slicing audio...");
-    Slicer slicer(targetSampleRate, -40.0, 5000, 300, 20, 1000);
-    auto markers = slicer.slice(waveform, 1);
-
-    smf::MidiFile midi;
-    constexpr int NOTE_VELOCITY = 64;
-    auto trackId = midi.addTrack();
-    midi.addTempo(trackId, 0, m_tempo);
-    auto mul = m_tempo * midi.getTicksPerQuarterNote() / 60;
-
-    if (markers.empty()) {
-        logMsgError("Run slicer failed.");
-        return;
+    if (profiling) {
+        someInference.writeProfileSummary(m_outPath + ".ort-profile.txt");
     }
-    logMsgInfo(QString("Slicing succeed. Total chunks: %1").arg(markers.size()));
 
-    int currentMarkerIndex = 0;
-
-    for (const auto [beginFrame, endFrame] : markers) {
-        auto currentAudioDuration = (endFrame - beginFrame) * 1000 / targetSampleRate;
-        logMsgInfo(QString("Inferring audio chunk %1/%2, length: %3 s")
-                .arg(currentMarkerIndex + 1)
-                .arg(markers.size())
-                .arg(QString::number(currentAudioDuration / 1000.0, 'f', 3)));
-        auto notes = someInference.infer(waveform, beginFrame, endFrame - beginFrame);
-        auto notesSize = notes.note_midi.size();
-        if (notesSize != notes.note_dur.size() || notesSize != notes.note_rest.size()) {
-            logMsgError("The sizes of `note_midi`, `note_dur`, `note_rest` do not match!");
-            return;
-        }
-        logMsgInfo(QString("Audio chunk %1/%2 inference complete.").arg(currentMarkerIndex + 1).arg(markers.size()));
-        float cumSum = 0.0f, cumSumPrev = 0.0f;
-        int offset = std::lround(beginFrame * mul / sampleRate);
-
-        int start = offset;
-        for (size_t i = 0; i < notesSize; ++i) {
-            int noteMidi = std::lround(notes.note_midi[i]);
-            cumSumPrev = cumSum;
-            cumSum += notes.note_dur[i];
-            int noteTick = std::lround(cumSum * mul) - std::lround(cumSumPrev * mul);
-            bool noteRest = notes.note_rest[i];
-
-            int end = start + noteTick;
-
-            if (currentMarkerIndex < markers.size() - 1) {
-                auto nextBeginFrame = markers[currentMarkerIndex + 1].first;
-                int nextOffset = std::lround(nextBeginFrame * mul / sampleRate);
-                if (end > nextOffset) {
-                    end = nextOffset;
-                }
-            }
-            if (start < end && !noteRest) {
-                midi.addNoteOn(trackId, start, 0, noteMidi, NOTE_VELOCITY);
-                midi.addNoteOff(trackId, end, 0, noteMidi);
-            }
-            start = end;
-        }
-        ++currentMarkerIndex;
+    const auto &stats = pipeline.stats();
+    constexpr double kMiB = 1024.0 * 1024.0;
+    logMsgInfo(QString("Memory: peak %1 MB of %2, waited %3 times (%4 s).")
+                       .arg(QString::number(stats.memoryPeak / kMiB, 'f', 1))
+                       .arg(stats.memoryBudget ? QString::number(stats.memoryBudget / kMiB, 'f', 0) + " MB budget"
+                                               : QString("unlimited budget"))
+                       .arg(stats.memoryWaits)
+                       .arg(QString::number(stats.memoryWaitSeconds, 'f', 3)));
+    logMsgInfo(QString("Buffer copies: %1 (%2 MB).")
+                       .arg(stats.copies)
+                       .arg(QString::number(stats.copiedBytes / kMiB, 'f', 1)));
+    if (auto cache = PreprocessCache::global()) {
+        auto cacheStats = cache->stats();
+        logMsgInfo(QString("Preprocess cache: %1 (%2 hits, %3 misses, %4 evictions this session).")
+                           .arg(stats.cacheHit ? "hit" : "miss")
+                           .arg(cacheStats.hits)
+                           .arg(cacheStats.misses)
+                           .arg(cacheStats.evictions));
     }
 
-    std::ofstream outMidiFile(m_outPath
-#ifdef _WIN32
-            .toStdWString()
-#else
-            .toStdString()
-#endif
-    , std::ios::binary);
-
-    midi.write(outMidiFile);
-
     auto benchmarkTimeEnd = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(benchmarkTimeEnd - benchmarkStart).count();
     logMsgWithColor(QString("Task completed in %1 seconds.").arg(QString::number(duration / 1000.0, 'f', 3)), Qt::darkGreen);
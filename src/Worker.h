@@ -1,9 +1,16 @@
 #ifndef SOME_GUI_WORKER_H
 #define SOME_GUI_WORKER_H
 
+#include <chrono>
+#include <mutex>
+
 #include <QThread>
 
 #include "Inference/ExecutionProviderOptions.h"
+#include "Pipeline/Pipeline.h"
+#include "Pipeline/PreprocessJob.h"
+#include "Pipeline/ProgressTracker.h"
+#include "Utils/CancelToken.h"
 
 class QString;
 class QColor;
@@ -20,15 +27,35 @@ public:
                     int deviceIndex,
                     int batchSize = 1,
                     QObject *parent = nullptr);
+    // A job preprocessing the input ahead of time. run() waits for it after the session is up and
+    // uses its result. The job must outlive the worker thread.
+    void setPreprocessJob(some::PreprocessJob *job);
+    // Stops the task as soon as possible: the preprocessing loops at their next block, and a chunk
+    // being inferred through the run options of the session. Safe to call from any thread.
+    void cancel();
+    bool isCancelled() const;
 Q_SIGNALS:
     void logMsgInfo(const QString &msg);
     void logMsgError(const QString &msg);
     void logMsgWithColor(const QString &msg, const QColor &color);
+    // Forwarded from Pipeline on the worker thread; connect queued.
+    void waveformReady(const some::dsp::WaveformMipmapPtr &mipmap);
+    void markersReady(const some::MarkerListPtr &markers, int sampleRate);
+    void inferenceStarted(double audioSeconds, int chunkCount);
+    void chunkInferred(int index, double onsetSeconds, const some::NotesPtr &notes);
+    // Throttled; see ProgressTracker.
+    void progressChanged(const some::ProgressReport &report);
+    // Emitted when the task was cancelled, once the session and the buffers are freed. `seconds`
+    // is the time from cancel() to that point.
+    void cancelled(double seconds);
 
 protected:
     void run() override;
 
 private:
+    void runJob();
+    void setBackend(some::InferenceBackend *backend);
+
     QString m_modelPath;
     QString m_audioPath;
     double m_tempo;
@@ -36,6 +63,13 @@ private:
     int m_deviceIndex;
     int m_batchSize;
     some::ExecutionProvider m_ep = some::ExecutionProvider::CPU;
+    some::PreprocessJob *m_preprocessJob = nullptr;
+
+    some::CancelToken m_cancel;
+    // Guards the backend, which only lives during runJob(), and the time of the cancel.
+    mutable std::mutex m_cancelMutex;
+    some::InferenceBackend *m_backend = nullptr;
+    std::chrono::steady_clock::time_point m_cancelTime;
 };
 
 
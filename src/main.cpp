@@ -1,10 +1,9 @@
 #include <QApplication>
 #include <QString>
-#ifdef ORT_API_MANUAL_INIT
-#include <QMessageBox>
-#include "OrtLoader.h"
-#endif
 
+#include "Inference/ModelScanner.h"
+#include "Pipeline/Pipeline.h"
+#include "Pipeline/ProgressTracker.h"
 #include "Widgets/MainWindow.h"
 
 
@@ -12,14 +11,12 @@ int main(int argc, char *argv[]) {
     QApplication a(argc, argv);
     a.setFont({"Microsoft YaHei UI", 9});
     a.setStyle("fusion");
-#ifdef ORT_API_MANUAL_INIT
-    QString errorString;
-    bool ok = InitOrtLibrary(&errorString);
-    if (!ok) {
-        QMessageBox::critical(nullptr, "Error", "Could not load ONNX Runtime library:\n" + errorString);
-        return -1;
-    }
-#endif
+    qRegisterMetaType<some::NotesPtr>("some::NotesPtr");
+    qRegisterMetaType<some::MarkerListPtr>("some::MarkerListPtr");
+    qRegisterMetaType<some::dsp::WaveformMipmapPtr>("some::dsp::WaveformMipmapPtr");
+    qRegisterMetaType<some::ProgressReport>("some::ProgressReport");
+    qRegisterMetaType<some::ModelScanResult>("some::ModelScanResult");
+    // ONNX Runtime is loaded in the background by the window; see MainWindow::loadOrtRuntime().
     MainWindow w;
     w.show();
     return a.exec();